@@ -1,10 +1,12 @@
 #include <benchmark/benchmark.h>
 
 #include <RPL/Deserializer.hpp>
+#include <RPL/FrameHandle.hpp>
 #include <RPL/Parser.hpp>
 #include <RPL/Packets/Sample/SampleA.hpp>
 #include <RPL/Packets/Sample/SampleB.hpp>
 #include <RPL/Serializer.hpp>
+#include <RPL/Utils/CrcBatch.hpp>
 
 #include "rpl_benchmark_packets.hpp"
 
@@ -13,9 +15,19 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <span>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
+#ifdef __linux__
+#include <RPL/Linux/Gateway.hpp>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
 using PacketA = SampleA;
 using PacketB = SampleB;
 
@@ -141,6 +153,49 @@ static void BM_Serialization_SinglePacket(benchmark::State &state) {
 }
 BENCHMARK(BM_Serialization_SinglePacket);
 
+static void BM_Serialization_PrebuiltFrame(benchmark::State &state) {
+  static constexpr auto frame =
+      RPL::Serializer<PacketA>::make_frame(PacketA{42, -1234, 3.14f, 2.718});
+  std::vector<uint8_t> buffer(frame.size());
+
+  for (auto _ : state) {
+    std::memcpy(buffer.data(), frame.data(), frame.size());
+    benchmark::DoNotOptimize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_Serialization_PrebuiltFrame);
+
+static void BM_Serialization_MediumFullResend(benchmark::State &state) {
+  RPL::Serializer<MediumPacket> serializer;
+  MediumPacket packet{};
+  std::vector<uint8_t> buffer(
+      RPL::Serializer<MediumPacket>::frame_size<MediumPacket>());
+
+  for (auto _ : state) {
+    packet.payload[10] += 1;
+    auto result = serializer.serialize(buffer.data(), buffer.size(), packet);
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_Serialization_MediumFullResend);
+
+static void BM_FrameHandle_MediumPatchBytes(benchmark::State &state) {
+  RPL::FrameHandle<MediumPacket> handle{MediumPacket{}};
+  uint8_t value = 0;
+
+  for (auto _ : state) {
+    ++value;
+    const std::array<uint8_t, 2> bytes{value, value};
+    handle.update(10, bytes);
+    handle.advance_seq();
+    benchmark::DoNotOptimize(handle.data());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_FrameHandle_MediumPatchBytes);
+
 static void BM_Serialization_Bitfield(benchmark::State &state) {
   RPL::Serializer<RobotStatus, CrossByteTest> serializer;
   RobotStatus status{1, 5, 9, 0x1234};
@@ -426,4 +481,144 @@ BENCHMARK_F(ParserStressFixture, Parser_AdvanceWriteIndex_Path)(benchmark::State
                  static_cast<int64_t>(burst_mixed_frames * 2));
 }
 
+// --- CRC16 Batch Benchmarks ---
+
+// Args: {每批帧数, 帧类型 0 = Small / 1 = Medium}
+static std::vector<std::vector<uint8_t>> make_crc_batch(const auto &state) {
+  StressSerializer serializer;
+  std::vector<std::vector<uint8_t>> frames;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    const auto seed = static_cast<uint8_t>(i * 29);
+    frames.push_back(
+        state.range(1) == 0
+            ? serialize_one(serializer, make_packet_pattern<StressSmall>(seed))
+            : serialize_one(serializer,
+                            make_packet_pattern<StressMedium>(seed)));
+  }
+  return frames;
+}
+
+static int64_t total_bytes(const std::vector<std::vector<uint8_t>> &frames) {
+  size_t bytes = 0;
+  for (const auto &f : frames)
+    bytes += f.size();
+  return static_cast<int64_t>(bytes);
+}
+
+static void BM_Crc16_ScalarVerify(benchmark::State &state) {
+  const auto frames = make_crc_batch(state);
+
+  for (auto _ : state) {
+    uint16_t ok = 0;
+    for (size_t i = 0; i < frames.size(); ++i) {
+      const auto &f = frames[i];
+      const uint16_t crc = RPL::ProtocolCRC16::calc(f.data(), f.size() - 2);
+      if (crc == (f[f.size() - 2] | (f[f.size() - 1] << 8)))
+        ok |= static_cast<uint16_t>(1u << i);
+    }
+    benchmark::DoNotOptimize(ok);
+  }
+  set_throughput(state, total_bytes(frames),
+                 static_cast<int64_t>(frames.size()));
+}
+BENCHMARK(BM_Crc16_ScalarVerify)->ArgsProduct({{4, 8, 16}, {0, 1}});
+
+static void BM_Crc16_BatchVerify(benchmark::State &state) {
+  const auto frames = make_crc_batch(state);
+  std::vector<std::span<const uint8_t>> spans(frames.begin(), frames.end());
+
+  for (auto _ : state) {
+    const uint16_t ok = RPL::CrcBatch<>::verify(spans);
+    benchmark::DoNotOptimize(ok);
+  }
+  set_throughput(state, total_bytes(frames),
+                 static_cast<int64_t>(frames.size()));
+}
+BENCHMARK(BM_Crc16_BatchVerify)->ArgsProduct({{4, 8, 16}, {0, 1}});
+
+#ifdef __linux__
+// --- Gateway Benchmarks ---
+
+// 一条 pty 链路：基准线程写 slave 端，网关读 master 端
+struct PtyLink {
+  int master = -1;
+  int slave = -1;
+  StressDeserializer deserializer;
+  StressParser parser{deserializer};
+
+  bool open() {
+    master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+      return false;
+    slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0)
+      return false;
+    termios tio{};
+    ::tcgetattr(slave, &tio);
+    ::cfmakeraw(&tio);
+    return ::tcsetattr(slave, TCSANOW, &tio) == 0;
+  }
+
+  ~PtyLink() {
+    if (slave >= 0)
+      ::close(slave);
+    if (master >= 0)
+      ::close(master);
+  }
+};
+
+// Args: {链路数, 工作线程数}；每次迭代向每条链路写入一批帧并等待全部解析完成
+static void BM_Gateway_PtyLinks(benchmark::State &state) {
+  const auto links = static_cast<size_t>(state.range(0));
+  const auto workers = static_cast<size_t>(state.range(1));
+  constexpr size_t repeats = 48; // 单批约 14 KB，低于 pty 缓冲区容量
+
+  StressSerializer serializer;
+  const auto burst = build_repeated_stream(
+      serialize_one(serializer, make_packet_pattern<StressSmall>(0x11)),
+      serialize_one(serializer, make_packet_pattern<StressMedium>(0x22)),
+      repeats);
+
+  std::vector<std::unique_ptr<PtyLink>> ptys;
+  RPL::Linux::Gateway<64> gateway;
+  for (size_t i = 0; i < links; ++i) {
+    auto link = std::make_unique<PtyLink>();
+    if (!link->open() || !gateway.add_link(link->master, link->parser)) {
+      state.SkipWithError("pty unavailable");
+      return;
+    }
+    ptys.push_back(std::move(link));
+  }
+  if (!gateway.start(workers)) {
+    state.SkipWithError("gateway start failed");
+    return;
+  }
+
+  uint64_t expected = 0;
+  for (auto _ : state) {
+    for (const auto &link : ptys) {
+      size_t done = 0;
+      while (done < burst.size()) {
+        const ssize_t n =
+            ::write(link->slave, burst.data() + done, burst.size() - done);
+        if (n > 0)
+          done += static_cast<size_t>(n);
+      }
+    }
+    expected += repeats * 2;
+    for (size_t i = 0; i < links; ++i) {
+      while (gateway.link_stats(i).frames < expected)
+        std::this_thread::yield();
+    }
+  }
+  gateway.stop();
+
+  set_throughput(state, static_cast<int64_t>(burst.size() * links),
+                 static_cast<int64_t>(repeats * 2 * links));
+}
+BENCHMARK(BM_Gateway_PtyLinks)
+    ->ArgsProduct({{8, 32}, {1, 2, 4, 8}})
+    ->UseRealTime();
+#endif
+
 BENCHMARK_MAIN();
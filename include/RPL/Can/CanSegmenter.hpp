@@ -0,0 +1,269 @@
+/**
+ * @file CanSegmenter.hpp
+ * @brief RPL 帧的 CAN / CAN FD 分段与重组
+ *
+ * 此文件提供 CanSegmenter 与 CanReassembler，把已序列化的 RPL 帧拆成
+ * 经典 CAN（8 字节）或 CAN FD（64 字节）帧发送，并在接收端按 CAN ID 重组。
+ * 两者不依赖具体的 CAN 驱动，可用于 MCU（bxCAN / FDCAN）与 Linux SocketCAN。
+ *
+ * @par 分段格式
+ * 每个 CAN 帧的第一个字节为分段头：
+ * ```
+ * | bit 7 | bit 6 | bit 5..0 |
+ * | SOF   | EOF   | 序号     |
+ * ```
+ * - SOF 标记一个 RPL 帧的第一段，序号从 0 开始，每段加 1（模 64）
+ * - EOF 标记最后一段；最后一段的第二个字节为本段有效数据长度，
+ *   其后的字节是为凑齐 CAN FD 合法长度而填充的 0
+ * - 中间段携带 MTU - 1 字节数据，最后一段最多携带 MTU - 2 字节
+ *
+ * @par 设计原理
+ * - 同一 CAN ID 的帧在总线上保持顺序，序号不连续即视为丢帧并丢弃该 RPL 帧
+ * - 接收端为每个正在重组的 CAN ID 分配一个上下文（固定数量，内存有界），
+ *   不同发送者的分段可以交错到达
+ * - 单段 RPL 帧不经过重组缓冲区，直接交给输出回调
+ * - RPL 帧本身带 CRC，重组结果仍由 Parser 校验
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_CAN_SEGMENTER_HPP
+#define RPL_CAN_SEGMENTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace RPL::Can {
+
+inline constexpr uint8_t seg_sof = 0x80;      ///< 第一段
+inline constexpr uint8_t seg_eof = 0x40;      ///< 最后一段
+inline constexpr uint8_t seg_seq_mask = 0x3F; ///< 序号
+
+/**
+ * @brief 向上取整到 CAN FD 合法数据长度（0..8, 12, 16, 20, 24, 32, 48, 64）
+ */
+constexpr size_t fd_padded_length(size_t n) noexcept {
+  if (n <= 8)
+    return n;
+  if (n <= 24)
+    return (n + 3) & ~size_t{3};
+  if (n <= 32)
+    return 32;
+  if (n <= 48)
+    return 48;
+  return 64;
+}
+
+/**
+ * @brief RPL 帧分段器
+ *
+ * @tparam Mtu CAN 帧数据长度上限（经典 CAN 为 8，CAN FD 为 64）
+ *
+ * @code
+ * uint8_t frame[64];
+ * auto len = serializer.serialize(frame, sizeof(frame), packet);
+ * RPL::Can::CanSegmenter<64>::segment(frame, *len,
+ *     [](const uint8_t *data, size_t n) { return fdcan_send(0x301, data, n); });
+ * @endcode
+ */
+template <size_t Mtu = 64> class CanSegmenter {
+  static_assert(Mtu >= 3 && Mtu <= 64 && fd_padded_length(Mtu) == Mtu,
+                "Mtu must be a valid CAN (FD) data length of at least 3");
+
+public:
+  static constexpr size_t mtu = Mtu;
+
+  /// @brief 长度为 size 的 RPL 帧需要的 CAN 帧数
+  static constexpr size_t count(size_t size) noexcept {
+    if (size <= Mtu - 2)
+      return 1;
+    return (size - (Mtu - 2) + Mtu - 2) / (Mtu - 1) + 1;
+  }
+
+  /**
+   * @brief 分段并逐个交给发送回调
+   *
+   * @param frame 已序列化的 RPL 帧
+   * @param size 帧长度
+   * @param emit 发送回调 bool(const uint8_t *data, size_t len)，返回是否被接受
+   * @return 已发出的 CAN 帧数；小于 count(size) 表示发送回调中途拒绝
+   */
+  template <typename Emit>
+  static size_t segment(const uint8_t *frame, size_t size, Emit &&emit) {
+    std::array<uint8_t, Mtu> buf{};
+    size_t offset = 0;
+    size_t sent = 0;
+    uint8_t header = seg_sof;
+    while (true) {
+      const size_t rest = size - offset;
+      const bool last = rest <= Mtu - 2;
+      size_t len;
+      if (last) {
+        buf[0] = static_cast<uint8_t>(header | seg_eof);
+        buf[1] = static_cast<uint8_t>(rest);
+        std::memcpy(buf.data() + 2, frame + offset, rest);
+        len = fd_padded_length(rest + 2);
+        std::memset(buf.data() + 2 + rest, 0, len - 2 - rest);
+      } else {
+        buf[0] = header;
+        std::memcpy(buf.data() + 1, frame + offset, Mtu - 1);
+        offset += Mtu - 1;
+        len = Mtu;
+      }
+      if (!emit(buf.data(), len))
+        return sent;
+      ++sent;
+      if (last)
+        return sent;
+      header = static_cast<uint8_t>(((header & seg_seq_mask) + 1) & seg_seq_mask);
+    }
+  }
+};
+
+/**
+ * @brief RPL 帧重组器
+ *
+ * @tparam Contexts 同时重组的 CAN ID 数
+ * @tparam MaxFrameSize 单个 RPL 帧的最大字节数
+ *
+ * @code
+ * RPL::Can::CanReassembler<4, 256> reassembler;
+ * // CAN 接收中断 / 线程中
+ * reassembler.feed(rx.id, rx.data, rx.len,
+ *                  [&](const uint8_t *p, size_t n) { parser.push_data(p, n); });
+ * @endcode
+ */
+template <size_t Contexts = 4, size_t MaxFrameSize = 256>
+class CanReassembler {
+public:
+  /**
+   * @brief 输入一个 CAN 帧
+   *
+   * @param can_id CAN ID（重组上下文的键）
+   * @param data CAN 帧数据
+   * @param len CAN 帧数据长度
+   * @param sink 输出回调 void(const uint8_t *frame, size_t size)，
+   *             在一个 RPL 帧重组完成时调用
+   * @return 本次输入完成了一个 RPL 帧时返回 true
+   */
+  template <typename Sink>
+  bool feed(uint32_t can_id, const uint8_t *data, size_t len, Sink &&sink) {
+    if (len == 0)
+      return drop(nullptr);
+    const uint8_t header = data[0];
+    const uint8_t seq = header & seg_seq_mask;
+    const bool sof = header & seg_sof;
+    const bool eof = header & seg_eof;
+
+    size_t body_offset = 1;
+    size_t body_len = len - 1;
+    if (eof) {
+      if (len < 2 || data[1] > len - 2)
+        return drop(find(can_id));
+      body_offset = 2;
+      body_len = data[1];
+    }
+
+    Context *ctx = find(can_id);
+    if (sof) {
+      if (ctx) {
+        // 上一帧未收完就开始了新帧
+        ++dropped_;
+        ctx->used = false;
+        ctx = nullptr;
+      }
+      if (seq != 0)
+        return drop(nullptr);
+      if (eof) {
+        sink(data + body_offset, body_len);
+        ++frames_;
+        return true;
+      }
+      ctx = allocate(can_id);
+      if (!ctx)
+        return drop(nullptr);
+    } else if (!ctx || seq != ctx->next_seq) {
+      return drop(ctx);
+    }
+
+    if (body_len > MaxFrameSize - ctx->size)
+      return drop(ctx);
+    std::memcpy(ctx->buf.data() + ctx->size, data + body_offset, body_len);
+    ctx->size += body_len;
+    ctx->next_seq = static_cast<uint8_t>((seq + 1) & seg_seq_mask);
+
+    if (!eof)
+      return false;
+    sink(ctx->buf.data(), ctx->size);
+    ctx->used = false;
+    ++frames_;
+    return true;
+  }
+
+  /// @brief 丢弃所有未完成的重组
+  void reset() noexcept {
+    for (auto &ctx : contexts_)
+      ctx.used = false;
+  }
+
+  /// @brief 正在重组的 CAN ID 数
+  [[nodiscard]] size_t in_progress() const noexcept {
+    size_t n = 0;
+    for (const auto &ctx : contexts_)
+      n += ctx.used ? 1 : 0;
+    return n;
+  }
+
+  /// @brief 已完成的 RPL 帧数
+  [[nodiscard]] uint32_t frames() const noexcept { return frames_; }
+
+  /// @brief 因丢段、乱序、超长或上下文耗尽而丢弃的 RPL 帧数
+  [[nodiscard]] uint32_t dropped() const noexcept { return dropped_; }
+
+private:
+  struct Context {
+    std::array<uint8_t, MaxFrameSize> buf{};
+    uint32_t id = 0;
+    size_t size = 0;
+    uint8_t next_seq = 0;
+    bool used = false;
+  };
+
+  Context *find(uint32_t can_id) noexcept {
+    for (auto &ctx : contexts_) {
+      if (ctx.used && ctx.id == can_id)
+        return &ctx;
+    }
+    return nullptr;
+  }
+
+  Context *allocate(uint32_t can_id) noexcept {
+    for (auto &ctx : contexts_) {
+      if (!ctx.used) {
+        ctx.used = true;
+        ctx.id = can_id;
+        ctx.size = 0;
+        ctx.next_seq = 0;
+        return &ctx;
+      }
+    }
+    return nullptr;
+  }
+
+  bool drop(Context *ctx) noexcept {
+    if (ctx)
+      ctx->used = false;
+    ++dropped_;
+    return false;
+  }
+
+  std::array<Context, Contexts> contexts_{};
+  uint32_t frames_ = 0;
+  uint32_t dropped_ = 0;
+};
+
+} // namespace RPL::Can
+
+#endif // RPL_CAN_SEGMENTER_HPP
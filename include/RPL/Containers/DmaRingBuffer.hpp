@@ -0,0 +1,172 @@
+/**
+ * @file DmaRingBuffer.hpp
+ * @brief RPL 外部 DMA 环形缓冲区视图
+ *
+ * 此文件提供 DmaRingBuffer，作为 Parser 的缓冲区策略直接在用户提供的
+ * 循环 DMA 接收缓冲区上解析，不再经 push_data 拷贝到内部 BipBuffer。
+ *
+ * @par 设计原理
+ * - 不持有数据，只记录读指针、硬件写指针与未解析字节数
+ * - 写入由 DMA 完成，调用方只需提交硬件写指针（缓冲区大小减去 NDTR）
+ * - 跨越缓冲区末尾的帧由 get_read_spans() 返回两段视图，
+ *   沿用 Parser 已有的分段 CRC 与分段反序列化路径
+ * - space() 即 DMA 可以安全覆盖的字节数；写指针追上读指针视为溢出，
+ *   此时丢弃全部未解析数据并计数
+ *
+ * @par 使用场景
+ * - STM32 等 MCU 上循环 DMA + 空闲中断的 UART 接收
+ *
+ * @code
+ * alignas(32) uint8_t dma_ring[256];
+ * using Ring = RPL::Containers::DmaRingBuffer<256>;
+ * RPL::Parser<Ring, PacketA, PacketB> parser{deserializer, dma_ring};
+ * HAL_UARTEx_ReceiveToIdle_DMA(&huart1, dma_ring, sizeof(dma_ring));
+ *
+ * void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t pos) {
+ *     parser.update_write_index(pos);
+ * }
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_DMA_RING_BUFFER_HPP
+#define RPL_DMA_RING_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+
+namespace RPL::Containers {
+
+/**
+ * @brief 外部 DMA 环形缓冲区视图
+ *
+ * @tparam SIZE 环形缓冲区大小，必须是 2 的幂
+ */
+template <size_t SIZE> class DmaRingBuffer {
+  static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0,
+                "SIZE must be a power of 2");
+
+  static constexpr size_t mask = SIZE - 1;
+
+  const uint8_t *ring_ = nullptr;
+  size_t read_ = 0;  ///< 读指针
+  size_t write_ = 0; ///< 最近一次提交的硬件写指针
+  size_t count_ = 0; ///< 未解析字节数
+  uint32_t overruns_ = 0;
+
+public:
+  DmaRingBuffer() = default;
+
+  explicit DmaRingBuffer(const uint8_t *ring) noexcept : ring_(ring) {}
+
+  /**
+   * @brief 绑定 DMA 缓冲区（须在启动 DMA 前调用）
+   * @param ring 大小为 SIZE 的 DMA 接收缓冲区
+   */
+  void attach(const uint8_t *ring) noexcept {
+    ring_ = ring;
+    read_ = write_ = count_ = 0;
+  }
+
+  /**
+   * @brief 提交硬件写指针
+   *
+   * 两次提交之间 DMA 写入的字节数必须小于 SIZE；写指针不变视为没有新数据。
+   *
+   * @param index DMA 写指针（SIZE - NDTR，等于 SIZE 时按 0 处理）
+   * @return 新数据覆盖了未解析数据（溢出）时返回 false，此时未解析数据被丢弃
+   */
+  bool update_write_index(size_t index) noexcept {
+    index &= mask;
+    const size_t added = (index - write_) & mask;
+    write_ = index;
+    if (added > SIZE - count_) {
+      read_ = write_;
+      count_ = 0;
+      ++overruns_;
+      return false;
+    }
+    count_ += added;
+    return true;
+  }
+
+  /**
+   * @brief 获取连续数据用于读取（到写指针或缓冲区末尾为止）
+   */
+  [[nodiscard]] std::span<const uint8_t>
+  get_contiguous_read_buffer() const noexcept {
+    return {ring_ + read_, std::min(count_, SIZE - read_)};
+  }
+
+  /**
+   * @brief 丢弃数据（推进读指针）
+   * @return 请求长度超过可用数据量时返回 false
+   */
+  bool discard(size_t length) noexcept {
+    if (length > count_)
+      return false;
+    read_ = (read_ + length) & mask;
+    count_ -= length;
+    return true;
+  }
+
+  /**
+   * @brief 获取两个连续的读视图（跨越缓冲区末尾时第二段从头开始）
+   *
+   * @param offset 相对于可用数据的偏移量
+   * @param length 要读取的长度
+   * @return 请求超出范围时两个 span 都为空
+   */
+  [[nodiscard]] std::pair<std::span<const uint8_t>, std::span<const uint8_t>>
+  get_read_spans(size_t offset, size_t length) const noexcept {
+    if (offset + length > count_)
+      return {{}, {}};
+    const size_t start = (read_ + offset) & mask;
+    const size_t first = std::min(length, SIZE - start);
+    return {{ring_ + start, first}, {ring_, length - first}};
+  }
+
+  /**
+   * @brief 窥视数据（不丢弃）
+   * @return 请求超出范围时返回 false
+   */
+  bool peek(uint8_t *data, size_t offset, size_t length) const noexcept {
+    if (offset + length > count_)
+      return false;
+    auto [s1, s2] = get_read_spans(offset, length);
+    std::memcpy(data, s1.data(), s1.size());
+    if (!s2.empty())
+      std::memcpy(data + s1.size(), s2.data(), s2.size());
+    return true;
+  }
+
+  /// @brief 未解析字节数
+  [[nodiscard]] size_t available() const noexcept { return count_; }
+
+  /// @brief DMA 可以安全覆盖的字节数
+  [[nodiscard]] size_t space() const noexcept { return SIZE - count_; }
+
+  [[nodiscard]] bool full() const noexcept { return count_ == SIZE; }
+
+  [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+
+  /// @brief 丢弃全部未解析数据（读指针追上写指针）
+  void clear() noexcept {
+    read_ = write_;
+    count_ = 0;
+  }
+
+  /// @brief 累计溢出次数
+  [[nodiscard]] uint32_t overruns() const noexcept { return overruns_; }
+
+  static constexpr size_t size() { return SIZE; }
+};
+
+} // namespace RPL::Containers
+
+#endif // RPL_DMA_RING_BUFFER_HPP
@@ -0,0 +1,215 @@
+/**
+ * @file PriorityTxQueue.hpp
+ * @brief RPL 分级优先发送队列
+ *
+ * 此文件提供 PriorityTxQueue，用于在发送通道繁忙时暂存已序列化的帧，
+ * 并总是先发出最紧急的帧。
+ *
+ * @par 设计原理
+ * - 固定 Capacity 个帧槽位（每个最多 MaxFrameSize 字节），内存有界
+ * - 每个优先级一条槽位下标组成的 FIFO 链表，空闲槽位组成空闲链表
+ * - 非空优先级记录在位图中，入队与取最紧急帧均为 O(1)（countr_zero）
+ * - 同一优先级内按入队顺序发送；由于同类包的相对截止时间相同，
+ *   同级 FIFO 即该级的最早截止优先（EDF）顺序
+ * - 出队时统计各优先级的排队时延（最大值与累计值）
+ *
+ * @par 使用场景
+ * - USBTransport 的发送队列选项，避免控制指令排在大块遥测数据之后
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_PRIORITY_TX_QUEUE_HPP
+#define RPL_PRIORITY_TX_QUEUE_HPP
+
+#include "RPL/Utils/ConnectionMonitor.hpp"
+#include "RPL/Utils/Error.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tl/expected.hpp>
+
+namespace RPL::Containers {
+
+/**
+ * @brief 分级优先发送队列
+ *
+ * @tparam TickProvider 时间戳提供器，用于排队时延统计
+ * @tparam Levels 优先级数量（0 最紧急，最多 32 级）
+ * @tparam Capacity 帧槽位数量
+ * @tparam MaxFrameSize 单帧最大字节数
+ *
+ * @code
+ * RPL::Containers::PriorityTxQueue<HALTickProvider, 4, 16, 64> queue;
+ * queue.push(0, frame, len);            // 控制指令
+ * while (!queue.empty()) {
+ *     auto f = queue.front();           // 总是最紧急的帧
+ *     if (!usb_send(f.data(), f.size()))
+ *         break;
+ *     queue.pop();
+ * }
+ * @endcode
+ */
+template <TickProviderConcept TickProvider, size_t Levels = 4,
+          size_t Capacity = 16, size_t MaxFrameSize = 64>
+class PriorityTxQueue {
+  static_assert(Levels > 0 && Levels <= 32, "Levels must be in [1, 32]");
+  static_assert(Capacity > 0 && Capacity < 0xFF,
+                "Capacity must be in [1, 254]");
+
+public:
+  using tick_type = typename TickProvider::tick_type;
+
+  static constexpr size_t levels = Levels;
+  static constexpr size_t capacity = Capacity;
+  static constexpr size_t max_frame_size = MaxFrameSize;
+
+  /// @brief 单个优先级的排队时延统计
+  struct LevelStats {
+    uint32_t frames = 0;    ///< 已发出的帧数
+    tick_type max_wait{};   ///< 最大排队时延
+    uint64_t total_wait = 0; ///< 累计排队时延（除以 frames 得平均值）
+  };
+
+  PriorityTxQueue() noexcept { reset(); }
+
+  /**
+   * @brief 入队一个帧
+   *
+   * @param priority 优先级（0 最紧急；超出 Levels 时按最低级处理）
+   * @param data 帧数据
+   * @param size 帧长度
+   * @return 帧过长或队列已满时返回 BufferOverflow
+   */
+  tl::expected<void, Error> push(uint8_t priority, const uint8_t *data,
+                                 size_t size) noexcept {
+    if (size > MaxFrameSize) {
+      return tl::make_unexpected(
+          Error{ErrorCode::BufferOverflow, "Frame exceeds TX slot size"});
+    }
+    if (free_head_ == npos) {
+      return tl::make_unexpected(
+          Error{ErrorCode::BufferOverflow, "TX queue full"});
+    }
+
+    const uint8_t level =
+        std::min<uint8_t>(priority, static_cast<uint8_t>(Levels - 1));
+    const uint8_t idx = free_head_;
+    Slot &slot = slots_[idx];
+    free_head_ = slot.next;
+
+    std::copy_n(data, size, slot.data.begin());
+    slot.size = static_cast<uint16_t>(size);
+    slot.enqueue_time = static_cast<tick_type>(TickProvider::now());
+    slot.next = npos;
+
+    if (heads_[level] == npos) {
+      heads_[level] = idx;
+      ready_ |= 1U << level;
+    } else {
+      slots_[tails_[level]].next = idx;
+    }
+    tails_[level] = idx;
+    ++count_;
+    return {};
+  }
+
+  /// @brief 队列是否为空
+  [[nodiscard]] bool empty() const noexcept { return ready_ == 0; }
+
+  /// @brief 排队中的帧数
+  [[nodiscard]] size_t size() const noexcept { return count_; }
+
+  /// @brief 指定优先级排队中的帧数
+  [[nodiscard]] size_t size(uint8_t priority) const noexcept {
+    size_t n = 0;
+    if (priority >= Levels)
+      return 0;
+    for (uint8_t i = heads_[priority]; i != npos; i = slots_[i].next)
+      ++n;
+    return n;
+  }
+
+  /**
+   * @brief 最紧急的帧（队列非空时调用）
+   */
+  [[nodiscard]] std::span<const uint8_t> front() const noexcept {
+    const Slot &slot = slots_[heads_[top_level()]];
+    return std::span<const uint8_t>(slot.data.data(), slot.size);
+  }
+
+  /// @brief 最紧急帧的优先级（队列非空时调用）
+  [[nodiscard]] uint8_t front_priority() const noexcept { return top_level(); }
+
+  /**
+   * @brief 移除最紧急的帧并记录其排队时延（队列非空时调用）
+   */
+  void pop() noexcept {
+    const uint8_t level = top_level();
+    const uint8_t idx = heads_[level];
+    Slot &slot = slots_[idx];
+
+    const auto wait = static_cast<tick_type>(
+        static_cast<tick_type>(TickProvider::now()) - slot.enqueue_time);
+    auto &s = stats_[level];
+    ++s.frames;
+    s.max_wait = std::max(s.max_wait, wait);
+    s.total_wait += static_cast<uint64_t>(wait);
+
+    heads_[level] = slot.next;
+    if (heads_[level] == npos)
+      ready_ &= ~(1U << level);
+    slot.next = free_head_;
+    free_head_ = idx;
+    --count_;
+  }
+
+  /// @brief 指定优先级的排队时延统计
+  [[nodiscard]] const LevelStats &stats(uint8_t priority) const noexcept {
+    return stats_[std::min<size_t>(priority, Levels - 1)];
+  }
+
+  /// @brief 清零时延统计
+  void reset_stats() noexcept { stats_ = {}; }
+
+  /// @brief 丢弃所有排队帧并清零统计
+  void reset() noexcept {
+    for (size_t i = 0; i < Capacity; ++i)
+      slots_[i].next = static_cast<uint8_t>(i + 1 < Capacity ? i + 1 : npos);
+    free_head_ = 0;
+    heads_.fill(npos);
+    tails_.fill(npos);
+    ready_ = 0;
+    count_ = 0;
+    stats_ = {};
+  }
+
+private:
+  static constexpr uint8_t npos = 0xFF;
+
+  struct Slot {
+    std::array<uint8_t, MaxFrameSize> data{};
+    uint16_t size = 0;
+    uint8_t next = npos;
+    tick_type enqueue_time{};
+  };
+
+  [[nodiscard]] uint8_t top_level() const noexcept {
+    return static_cast<uint8_t>(std::countr_zero(ready_));
+  }
+
+  std::array<Slot, Capacity> slots_{};
+  std::array<uint8_t, Levels> heads_{};
+  std::array<uint8_t, Levels> tails_{};
+  std::array<LevelStats, Levels> stats_{};
+  uint32_t ready_ = 0; ///< 非空优先级位图
+  uint8_t free_head_ = 0;
+  size_t count_ = 0;
+};
+
+} // namespace RPL::Containers
+
+#endif // RPL_PRIORITY_TX_QUEUE_HPP
@@ -0,0 +1,144 @@
+/**
+ * @file TxCoalescer.hpp
+ * @brief RPL 发送帧合并缓冲区
+ *
+ * 此文件提供 TxCoalescer，把多个已序列化的小帧拼接成一次端点大小的传输
+ * （Nagle 风格），减少全速 USB 上每帧占用一次 64 字节事务 / 1 ms 帧时隙的浪费。
+ *
+ * @par 设计原理
+ * - 帧按原样首尾相接，接收端的 Parser 本就支持一次输入多个帧
+ * - 下一帧放不下时先发出已缓存的数据；恰好填满时立即发出
+ * - 不小于传输大小的帧不经缓存，先发出已缓存数据后直接发送
+ * - 缓存中最早一帧等待超过 flush_deadline 个 tick 时由 expired() 提示发出
+ * - 发送回调拒绝（通道繁忙）时数据保留在缓存中，等待下次 flush
+ *
+ * @par 使用场景
+ * - USBTransport 的发送合并选项
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_TX_COALESCER_HPP
+#define RPL_TX_COALESCER_HPP
+
+#include "RPL/Utils/ConnectionMonitor.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace RPL::Containers {
+
+/**
+ * @brief 发送帧合并缓冲区
+ *
+ * @tparam TickProvider 时间戳提供器（建议微秒精度）
+ * @tparam TransferSize 单次传输大小（全速 USB 批量端点为 64）
+ *
+ * @code
+ * RPL::Containers::TxCoalescer<MicrosTick, 64> coalescer{500}; // 500 us
+ * auto emit = [](const uint8_t *p, size_t n) { return usb_write(p, n); };
+ * coalescer.append(frame, len, emit);
+ * if (coalescer.expired())
+ *     coalescer.flush(emit);
+ * @endcode
+ */
+template <TickProviderConcept TickProvider, size_t TransferSize = 64>
+class TxCoalescer {
+public:
+  using tick_type = typename TickProvider::tick_type;
+
+  static constexpr size_t transfer_size = TransferSize;
+
+  /**
+   * @brief 构造合并缓冲区
+   * @param flush_deadline 缓存数据的最长等待 tick 数
+   */
+  explicit TxCoalescer(tick_type flush_deadline = 1000) noexcept
+      : deadline_(flush_deadline) {}
+
+  /// @brief 设置缓存数据的最长等待 tick 数
+  void set_flush_deadline(tick_type deadline) noexcept { deadline_ = deadline; }
+
+  /**
+   * @brief 追加一帧
+   *
+   * @param frame 帧数据
+   * @param size 帧长度
+   * @param emit 发送回调 bool(const uint8_t*, size_t)，返回是否被接受
+   * @return 通道繁忙导致帧无法被缓存或发送时返回 false
+   */
+  template <typename Emit>
+  bool append(const uint8_t *frame, size_t size, Emit &&emit) {
+    if (size > TransferSize - size_ && !flush(emit))
+      return false;
+
+    if (size >= TransferSize) {
+      if (!emit(frame, size))
+        return false;
+      ++frames_;
+      ++transfers_;
+      return true;
+    }
+
+    if (size_ == 0)
+      first_time_ = static_cast<tick_type>(TickProvider::now());
+    std::copy_n(frame, size, buffer_.begin() + size_);
+    size_ += size;
+    ++buffered_frames_;
+
+    if (size_ == TransferSize)
+      (void)flush(emit);
+    return true;
+  }
+
+  /**
+   * @brief 发出缓存数据
+   *
+   * @param emit 发送回调
+   * @return 缓存为空或发送被接受时返回 true
+   */
+  template <typename Emit> bool flush(Emit &&emit) {
+    if (size_ == 0)
+      return true;
+    if (!emit(buffer_.data(), size_))
+      return false;
+    frames_ += buffered_frames_;
+    ++transfers_;
+    size_ = 0;
+    buffered_frames_ = 0;
+    return true;
+  }
+
+  /// @brief 缓存中最早一帧是否已等待超过期限
+  [[nodiscard]] bool expired() const noexcept {
+    return size_ > 0 &&
+           static_cast<tick_type>(static_cast<tick_type>(TickProvider::now()) -
+                                  first_time_) >= deadline_;
+  }
+
+  /// @brief 缓存中的字节数
+  [[nodiscard]] size_t buffered() const noexcept { return size_; }
+
+  /// @brief 已发出的帧数
+  [[nodiscard]] uint32_t frames() const noexcept { return frames_; }
+
+  /// @brief 实际发生的传输次数
+  [[nodiscard]] uint32_t transfers() const noexcept { return transfers_; }
+
+  /// @brief 相比每帧一次传输所节省的传输次数
+  [[nodiscard]] uint32_t saved() const noexcept { return frames_ - transfers_; }
+
+private:
+  std::array<uint8_t, TransferSize> buffer_{};
+  size_t size_ = 0;
+  uint32_t buffered_frames_ = 0;
+  tick_type first_time_{};
+  tick_type deadline_;
+  uint32_t frames_ = 0;
+  uint32_t transfers_ = 0;
+};
+
+} // namespace RPL::Containers
+
+#endif // RPL_TX_COALESCER_HPP
@@ -12,12 +12,15 @@
 #define RPL_DESERIALIZER_HPP
 
 #include "Containers/MemoryPool.hpp"
+#include "Meta/BitView.hpp"
 #include "Meta/BitstreamParser.hpp"
 #include "Meta/PacketInfoCollector.hpp"
 #include "Utils/CompilerBarrier.hpp"
 #ifdef RPL_USE_STD_ATOMIC
 #include <atomic>
 #endif
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <span>
 
@@ -41,41 +44,85 @@ template <typename T, typename... Ts>
 concept Deserializable = (std::is_same_v<T, Ts> || ...);
 
 /**
- * @brief 反序列化器类
- *
- * 用于从字节数组中反序列化数据包结构，使用内存池来存储反序列化的数据。
- * 支持 SeqLock 机制以实现线程安全的读取。
+ * @brief 默认存储策略：内存池与 SeqLock 版本号是 Deserializer 的成员
  *
- * @tparam Ts 可反序列化的数据包类型列表
+ * 存储策略作为 Deserializer（以及 Parser）数据包列表之前的可选参数，
+ * 决定 Deserializer 状态（内存池、版本号、负载长度）放在哪里，
+ * 例如 Linux::ShmStorage 把它放进跨进程共享内存。
  *
- * @par 设计原理
- * - 使用静态内存池避免动态分配
- * - SeqLock 机制保证读取一致性
- * - 支持分段写入（用于 BipBuffer 边界跨越场景）
- *
- * @par 使用示例
- * @code
- * RPL::Deserializer<PacketA, PacketB> deserializer;
+ * 存储策略须定义 `is_deserializer_storage = true` 与成员模板
+ * `Holder<State, Collector>`，后者提供 `state()` 与 `writable()`。
+ */
+struct InlineStorage {
+  static constexpr bool is_deserializer_storage = true;
+
+  template <typename State, typename Collector> class Holder {
+    State state_{};
+
+  public:
+    State &state() noexcept { return state_; }
+    const State &state() const noexcept { return state_; }
+
+    /// @brief 状态是否可写（只读映射的共享内存为 false）
+    static constexpr bool writable() noexcept { return true; }
+  };
+};
+
+/**
+ * @brief Deserializer 存储策略概念
+ * @tparam S 要检查的类型
+ */
+template <typename S>
+concept DeserializerStorageConcept =
+    requires { requires S::is_deserializer_storage; };
+
+namespace Details {
+
+/**
+ * @brief Deserializer 的全部可变状态
  *
- * // Parser 内部调用 write() 写入数据
- * deserializer.write(PacketA::cmd, data_ptr, sizeof(PacketA));
+ * 由存储策略决定存放位置；跨进程共享时布局由 Linux::ShmStorage 的段头描述。
  *
- * // 用户获取数据包
- * auto packet_a = deserializer.get<PacketA>();
- * @endcode
+ * @tparam Collector 数据包信息收集器
+ * @tparam N 数据包类型数
  */
-template <typename... Ts> class Deserializer {
-  using Collector = Meta::PacketInfoCollector<Ts...>; ///< 用于收集包信息的类型
+template <typename Collector, size_t N> struct DeserializerState {
   Containers::MemoryPool<Collector> pool{}; ///< 存储反序列化数据的内存池
 
 #ifdef RPL_USE_STD_ATOMIC
   /// @brief SeqLock version counters（原子版本）
-  std::atomic<uint32_t> versions_[sizeof...(Ts)]{};
+  std::atomic<uint32_t> versions[N]{};
 #else
   /// @brief SeqLock version counters（volatile + compiler barrier 版本）
-  volatile uint32_t versions_[sizeof...(Ts)]{};
+  volatile uint32_t versions[N]{};
 #endif
 
+  /// @brief 每个类型最近一次写入的负载长度（受 SeqLock 保护）
+  size_t lengths[N]{};
+};
+
+} // namespace Details
+
+/**
+ * @brief 反序列化器实现
+ *
+ * 用于从字节数组中反序列化数据包结构，使用内存池来存储反序列化的数据。
+ * 支持 SeqLock 机制以实现线程安全的读取。通常通过 Deserializer 使用。
+ *
+ * @tparam Storage 存储策略（InlineStorage 或 Linux::ShmStorage）
+ * @tparam Ts 可反序列化的数据包类型列表
+ *
+ * @par 设计原理
+ * - 使用静态内存池避免动态分配
+ * - SeqLock 机制保证读取一致性
+ * - 支持分段写入（用于 BipBuffer 边界跨越场景）
+ */
+template <typename Storage, typename... Ts> class BasicDeserializer {
+  using Collector = Meta::PacketInfoCollector<Ts...>; ///< 用于收集包信息的类型
+  using State = Details::DeserializerState<Collector, sizeof...(Ts)>;
+
+  typename Storage::template Holder<State, Collector> storage_{};
+
 public:
   /**
    * @brief SeqLock 写入方法
@@ -89,32 +136,15 @@ public:
    * - 写入后：version++（变为偶数，表示写入完成）
    * - 读取器：检查 version 是否为偶数且前后一致
    *
-   * @param cmd 命令码
+   * @param cmd 命令码（子包为 Meta::packet_key 组合键）
    * @param src 数据源指针
    * @param len 数据长度
+   *
+   * @note 超过 PacketTraits::size 的部分被截断；变长包短于最大长度时，
+   *       槽位剩余字节清零，实际长度可通过 received_size() 获取
    */
-  void write(uint16_t cmd, const uint8_t *src, size_t len) noexcept {
-    const auto byte_offset = Collector::cmd_index(cmd);
-    if (byte_offset == static_cast<size_t>(-1))
-      return;
-    const auto seq_idx = Collector::cmd_seq_index(cmd);
-
-#ifdef RPL_USE_STD_ATOMIC
-    versions_[seq_idx].fetch_add(1, std::memory_order_release);
-#else
-    versions_[seq_idx] = versions_[seq_idx] + 1;
-    compiler_barrier();
-#endif
-
-    std::memcpy(reinterpret_cast<uint8_t *>(&pool.buffer[byte_offset]), src,
-                len);
-
-#ifdef RPL_USE_STD_ATOMIC
-    versions_[seq_idx].fetch_add(1, std::memory_order_release);
-#else
-    compiler_barrier();
-    versions_[seq_idx] = versions_[seq_idx] + 1;
-#endif
+  void write(uint32_t cmd, const uint8_t *src, size_t len) noexcept {
+    write_segmented(cmd, std::span<const uint8_t>(src, len), {});
   }
 
   /**
@@ -123,39 +153,47 @@ public:
    * 用于处理跨越 BipBuffer 边界的数据包，避免中间拷贝。
    * 当数据跨越缓冲区 A/B 区域边界时，数据会被分为两个 span。
    *
-   * @param cmd 命令码
+   * @param cmd 命令码（子包为 Meta::packet_key 组合键）
    * @param s1 第一段数据（可能为空）
    * @param s2 第二段数据（可能为空）
    *
    * @note 此方法用于零拷贝场景，直接从 BipBuffer 的分段视图写入
    */
-  void write_segmented(uint16_t cmd, std::span<const uint8_t> s1,
+  void write_segmented(uint32_t cmd, std::span<const uint8_t> s1,
                        std::span<const uint8_t> s2) noexcept {
     const auto byte_offset = Collector::cmd_index(cmd);
     if (byte_offset == static_cast<size_t>(-1))
       return;
     const auto seq_idx = Collector::cmd_seq_index(cmd);
+    const size_t capacity = Collector::packet_sizes[seq_idx];
+    const size_t n1 = std::min(s1.size(), capacity);
+    const size_t n2 = std::min(s2.size(), capacity - n1);
 
+    State &st = state();
 #ifdef RPL_USE_STD_ATOMIC
-    versions_[seq_idx].fetch_add(1, std::memory_order_release);
+    st.versions[seq_idx].fetch_add(1, std::memory_order_release);
 #else
-    versions_[seq_idx] = versions_[seq_idx] + 1;
+    st.versions[seq_idx] = st.versions[seq_idx] + 1;
     compiler_barrier();
 #endif
 
-    uint8_t *dest = reinterpret_cast<uint8_t *>(&pool.buffer[byte_offset]);
-    if (!s1.empty()) {
-      std::memcpy(dest, s1.data(), s1.size());
+    uint8_t *dest = reinterpret_cast<uint8_t *>(&st.pool.buffer[byte_offset]);
+    if (n1 > 0) {
+      std::memcpy(dest, s1.data(), n1);
     }
-    if (!s2.empty()) {
-      std::memcpy(dest + s1.size(), s2.data(), s2.size());
+    if (n2 > 0) {
+      std::memcpy(dest + n1, s2.data(), n2);
     }
+    if (Collector::variable_length[seq_idx] && n1 + n2 < capacity) {
+      std::memset(dest + n1 + n2, 0, capacity - n1 - n2);
+    }
+    st.lengths[seq_idx] = n1 + n2;
 
 #ifdef RPL_USE_STD_ATOMIC
-    versions_[seq_idx].fetch_add(1, std::memory_order_release);
+    st.versions[seq_idx].fetch_add(1, std::memory_order_release);
 #else
     compiler_barrier();
-    versions_[seq_idx] = versions_[seq_idx] + 1;
+    st.versions[seq_idx] = st.versions[seq_idx] + 1;
 #endif
   }
 
@@ -180,37 +218,65 @@ public:
   template <typename T>
     requires Deserializable<T, Ts...>
   T get() noexcept {
+    T result;
+    read_locked<T>([&](const uint8_t *ptr) { result = decode<T>(ptr); });
+    return result;
+  };
+
+  /**
+   * @brief 获取指定类型的数据包及其实际负载长度（SeqLock 读循环）
+   *
+   * 数据包与长度在同一次一致性读取中获得。变长包超出 length 的字节为 0。
+   *
+   * @tparam T 要获取的数据包类型
+   * @param length 输出：最近一次收到的负载字节数（尚未收到时为 0）
+   * @return 指定类型的反序列化数据包
+   */
+  template <typename T>
+    requires Deserializable<T, Ts...>
+  T get(size_t &length) noexcept {
     constexpr auto seq_idx = Collector::template type_seq_index<T>();
     T result;
+    read_locked<T>([&](const uint8_t *ptr) {
+      result = decode<T>(ptr);
+      length = state().lengths[seq_idx];
+    });
+    return result;
+  }
+
+  /**
+   * @brief 获取指定类型最近一次收到的负载长度
+   *
+   * 定长包通常等于 PacketTraits::size；变长包为发送方实际发送的字节数。
+   *
+   * @tparam T 数据包类型
+   * @return 负载字节数（尚未收到时为 0）
+   */
+  template <typename T>
+    requires Deserializable<T, Ts...>
+  size_t received_size() noexcept {
+    constexpr auto seq_idx = Collector::template type_seq_index<T>();
+    const State &st = state();
+    size_t length = 0;
     uint32_t v1, v2;
     do {
 #ifdef RPL_USE_STD_ATOMIC
-      v1 = versions_[seq_idx].load(std::memory_order_acquire);
+      v1 = st.versions[seq_idx].load(std::memory_order_acquire);
 #else
-      v1 = versions_[seq_idx];
+      v1 = st.versions[seq_idx];
       compiler_barrier();
 #endif
-
-      auto ptr = reinterpret_cast<uint8_t *>(
-          &pool.buffer[Collector::template type_index<T>()]);
-      Meta::PacketTraits<T>::before_get(ptr);
-      if constexpr (Meta::HasBitLayout<Meta::PacketTraits<T>>) {
-        result = deserialize_bitstream<T>(
-            std::span<const uint8_t>(ptr, Meta::PacketTraits<T>::size));
-      } else {
-        result = *reinterpret_cast<const T *>(ptr);
-      }
-
+      length = st.lengths[seq_idx];
 #ifdef RPL_USE_STD_ATOMIC
       std::atomic_thread_fence(std::memory_order_acquire);
-      v2 = versions_[seq_idx].load(std::memory_order_relaxed);
+      v2 = st.versions[seq_idx].load(std::memory_order_relaxed);
 #else
       compiler_barrier();
-      v2 = versions_[seq_idx];
+      v2 = st.versions[seq_idx];
 #endif
     } while (v1 != v2 || (v1 & 1));
-    return result;
-  };
+    return length;
+  }
 
   /**
    * @brief 获取指定类型的直接引用
@@ -228,17 +294,59 @@ public:
     requires Deserializable<T, Ts...>
   constexpr T &getRawRef() noexcept {
     return reinterpret_cast<T &>(
-        pool.buffer[Collector::template type_index<T>()]);
+        state().pool.buffer[Collector::template type_index<T>()]);
   };
 
+  /**
+   * @brief 获取位流数据包的单个字段（SeqLock 读循环）
+   *
+   * 只提取 BitLayout 中第 I 个字段，不构造完整结构体，
+   * 适合只关心少数字段（如遥控器按键）的场景。
+   *
+   * @tparam T 数据包类型（必须定义 BitLayout）
+   * @tparam I BitLayout 字段索引
+   * @return 字段值
+   */
+  template <typename T, size_t I>
+    requires Deserializable<T, Ts...> &&
+             Meta::HasBitLayout<Meta::PacketTraits<T>>
+  auto get_field() noexcept {
+    typename BitView<T>::Info::template field_type<I> result;
+    read_locked<T>([&](const uint8_t *ptr) {
+      result = BitView<T>{std::span<const uint8_t>(
+                              ptr, Meta::PacketTraits<T>::size)}
+                   .template get<I>();
+    });
+    return result;
+  }
+
+  /**
+   * @brief 获取内存池中位流数据的原地视图
+   *
+   * 返回直接指向内存池的 BitView，无拷贝、无完整解码。
+   *
+   * @warning 与 getRawRef 相同，不提供 SeqLock 一致性保证
+   * @tparam T 数据包类型（必须定义 BitLayout）
+   * @return 指向内存池的只读位域视图
+   */
+  template <typename T>
+    requires Deserializable<T, Ts...> &&
+             Meta::HasBitLayout<Meta::PacketTraits<T>>
+  BitView<T> view() const noexcept {
+    return BitView<T>{std::span<const uint8_t>(
+        reinterpret_cast<const uint8_t *>(
+            &state().pool.buffer[Collector::template type_index<T>()]),
+        Meta::PacketTraits<T>::size)};
+  }
+
   template <typename T>
     requires Deserializable<T, Ts...>
   uint32_t version() const noexcept {
     constexpr auto seq_idx = Collector::template type_seq_index<T>();
 #ifdef RPL_USE_STD_ATOMIC
-    return versions_[seq_idx].load(std::memory_order_acquire);
+    return state().versions[seq_idx].load(std::memory_order_acquire);
 #else
-    return versions_[seq_idx];
+    return state().versions[seq_idx];
 #endif
   }
 
@@ -257,9 +365,109 @@ public:
     const auto index = Collector::cmd_index(cmd);
     if (index == static_cast<size_t>(-1))
       return nullptr;
-    return reinterpret_cast<uint8_t *>(&pool.buffer[index]);
+    return reinterpret_cast<uint8_t *>(&state().pool.buffer[index]);
+  }
+
+  /// @brief 存储策略实例（如 Linux::ShmStorage 的 create / attach）
+  auto &storage() noexcept { return storage_; }
+  const auto &storage() const noexcept { return storage_; }
+
+private:
+  State &state() noexcept { return storage_.state(); }
+  const State &state() const noexcept { return storage_.state(); }
+
+  /**
+   * @brief SeqLock 读循环
+   *
+   * 调用 before_get 后把槽位指针交给 fn，直到读到一致的版本为止。
+   *
+   * @tparam T 数据包类型
+   * @param fn 读取函数，参数为槽位首地址
+   */
+  template <typename T, typename Fn> void read_locked(Fn &&fn) noexcept {
+    constexpr auto seq_idx = Collector::template type_seq_index<T>();
+    State &st = state();
+    uint32_t v1, v2;
+    do {
+#ifdef RPL_USE_STD_ATOMIC
+      v1 = st.versions[seq_idx].load(std::memory_order_acquire);
+#else
+      v1 = st.versions[seq_idx];
+      compiler_barrier();
+#endif
+
+      auto ptr = reinterpret_cast<uint8_t *>(
+          &st.pool.buffer[Collector::template type_index<T>()]);
+      if constexpr (requires { Meta::PacketTraits<T>::before_get_custom(ptr); }) {
+        // 只读映射（如共享内存读者）：在副本上执行 before_get
+        alignas(T) std::array<uint8_t, Collector::template slot_size<T>()> copy;
+        if (!storage_.writable()) {
+          std::memcpy(copy.data(), ptr, copy.size());
+          ptr = copy.data();
+        }
+        Meta::PacketTraits<T>::before_get(ptr);
+      }
+      fn(static_cast<const uint8_t *>(ptr));
+
+#ifdef RPL_USE_STD_ATOMIC
+      std::atomic_thread_fence(std::memory_order_acquire);
+      v2 = st.versions[seq_idx].load(std::memory_order_relaxed);
+#else
+      compiler_barrier();
+      v2 = st.versions[seq_idx];
+#endif
+    } while (v1 != v2 || (v1 & 1));
+  }
+
+  /// @brief 将槽位字节解码为数据包
+  template <typename T> static T decode(const uint8_t *ptr) noexcept {
+    if constexpr (Meta::HasBitLayout<Meta::PacketTraits<T>>) {
+      return deserialize_bitstream<T>(
+          std::span<const uint8_t>(ptr, Meta::PacketTraits<T>::size));
+    } else {
+      return *reinterpret_cast<const T *>(ptr);
+    }
   }
 };
+
+namespace Details {
+// 从模板参数开头提取可选的存储策略，其余为数据包类型
+template <typename Storage, typename... Ts> struct ExtractDeserializerOptions {
+  using type = BasicDeserializer<Storage, Ts...>;
+};
+
+template <typename Storage, typename H, typename... Ts>
+  requires DeserializerStorageConcept<H>
+struct ExtractDeserializerOptions<Storage, H, Ts...>
+    : ExtractDeserializerOptions<H, Ts...> {};
+} // namespace Details
+
+/**
+ * @brief 反序列化器类
+ *
+ * 用于从字节数组中反序列化数据包结构，使用内存池来存储反序列化的数据。
+ * 支持 SeqLock 机制以实现线程安全的读取。
+ *
+ * @tparam Args 模板参数列表，可以是:
+ *              - 仅数据包类型: Deserializer<PacketA, PacketB>
+ *              - 存储策略 + 数据包类型:
+ *                Deserializer<Linux::ShmStorage, PacketA, PacketB>
+ *
+ * @par 使用示例
+ * @code
+ * RPL::Deserializer<PacketA, PacketB> deserializer;
+ *
+ * // Parser 内部调用 write() 写入数据
+ * deserializer.write(PacketA::cmd, data_ptr, sizeof(PacketA));
+ *
+ * // 用户获取数据包
+ * auto packet_a = deserializer.get<PacketA>();
+ * @endcode
+ */
+template <typename... Args>
+class Deserializer
+    : public Details::ExtractDeserializerOptions<InlineStorage, Args...>::type {
+};
 } // namespace RPL
 
 #endif // RPL_DESERIALIZER_HPP
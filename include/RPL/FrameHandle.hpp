@@ -0,0 +1,261 @@
+/**
+ * @file FrameHandle.hpp
+ * @brief RPL 持久发送帧句柄
+ *
+ * 此文件提供 FrameHandle，用于持有一个已序列化的完整帧，并在原地修改
+ * 字段时增量修补帧尾 CRC16，适合周期性发送且每次只变化少数字节的数据包。
+ *
+ * @par 设计原理
+ * - 帧在构造时按 Serializer 相同的格式完整写入一次
+ * - 修改负载或序列号时，只对变化字节区间计算差分 CRC，再借助
+ *   CrcCombine 跳过其后的不变字节，直接异或到原 CRC 上
+ * - 发送时直接交出内部缓冲区指针，无需重新序列化
+ * - 变长包的负载长度变化时整帧重建，长度不变时仍走增量路径
+ *
+ * @par 使用场景
+ * - 自定义客户端数据、图形更新等周期性遥测帧
+ * - MCU 上每个控制周期发送大量小帧
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_FRAME_HANDLE_HPP
+#define RPL_FRAME_HANDLE_HPP
+
+#include "Meta/BitView.hpp"
+#include "Meta/BitstreamSerializer.hpp"
+#include "Meta/FrameTemplate.hpp"
+#include "Meta/PacketTraits.hpp"
+#include "Utils/CrcCombine.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace RPL {
+
+/**
+ * @brief 持久发送帧句柄
+ *
+ * @tparam T 数据包类型
+ *
+ * @par 使用示例
+ * @code
+ * RPL::FrameHandle<PowerTelemetry> frame{initial};
+ *
+ * // 每个控制周期
+ * telemetry.voltage = read_voltage();
+ * frame.update(telemetry);        // 只修补变化的字节与 CRC
+ * frame.advance_seq();
+ * uart_send(frame.data(), frame.size());
+ * @endcode
+ *
+ * @note 句柄本身不是线程安全的；发送期间不应修改帧内容
+ * @note 子包没有独立的帧，需持有 Parent 包的句柄，并把子头与子包数据
+ *       写入 Parent 负载
+ */
+template <typename T> class FrameHandle {
+  static_assert(!Meta::IsSubPacket<T>,
+                "Sub-packets must be serialized with serialize_sub(); hold a "
+                "FrameHandle of the Parent packet instead");
+
+public:
+  using Template = Meta::FrameTemplate<T>;
+  using Protocol = typename Template::Protocol;
+
+  static constexpr size_t header_size = Template::header_size;
+  static constexpr size_t data_size = Template::data_size;
+  static constexpr size_t frame_size = Template::frame_size;
+
+  /// @brief 以默认构造的数据包初始化帧
+  FrameHandle() noexcept : FrameHandle(T{}) {}
+
+  /**
+   * @brief 以给定数据包初始化帧
+   * @param packet 初始数据包
+   * @param seq 初始序列号
+   */
+  explicit FrameHandle(const T &packet, uint8_t seq = 0) noexcept {
+    rebuild(packet, seq);
+  }
+
+  /// @brief 帧起始地址
+  [[nodiscard]] const uint8_t *data() const noexcept { return frame_.data(); }
+
+  /// @brief 完整帧长度（变长包为当前负载对应的长度）
+  [[nodiscard]] size_t size() const noexcept {
+    return header_size + data_len_ + Template::tail_size;
+  }
+
+  /// @brief 完整帧字节
+  [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+    return std::span<const uint8_t>(frame_.data(), size());
+  }
+
+  /// @brief 负载字节（只读）
+  [[nodiscard]] std::span<const uint8_t> payload() const noexcept {
+    return std::span<const uint8_t>(frame_).subspan(header_size, data_len_);
+  }
+
+  /**
+   * @brief 用完整数据包更新负载
+   *
+   * 与当前负载逐字节比较，只修补首个与最后一个差异字节之间的区间。
+   * 内容未变化时不做任何修改；变长包负载长度变化时整帧重建。
+   *
+   * @param packet 新数据包
+   */
+  void update(const T &packet) noexcept {
+    const size_t len = Meta::payload_size<T>(packet);
+    if (len != data_len_) {
+      rebuild(packet, seq());
+      return;
+    }
+
+    std::array<uint8_t, data_size> next{};
+    encode_payload(packet, next.data());
+
+    const uint8_t *cur = frame_.data() + header_size;
+    size_t first = 0;
+    while (first < len && cur[first] == next[first])
+      ++first;
+    if (first == len)
+      return;
+    size_t last = len;
+    while (cur[last - 1] == next[last - 1])
+      --last;
+
+    patch(header_size + first, next.data() + first, last - first);
+  }
+
+  /**
+   * @brief 覆盖负载中的一段字节
+   *
+   * @param offset 相对负载起始的偏移
+   * @param bytes 新字节
+   * @return 区间越界时返回 false，帧保持不变
+   */
+  bool update(size_t offset, std::span<const uint8_t> bytes) noexcept {
+    if (offset > data_len_ || bytes.size() > data_len_ - offset)
+      return false;
+    if (!bytes.empty())
+      patch(header_size + offset, bytes.data(), bytes.size());
+    return true;
+  }
+
+  /**
+   * @brief 写入位流负载的第 I 个字段
+   *
+   * 字段覆盖的字节范围在编译期确定，只修补这几个字节。
+   *
+   * @tparam I BitLayout 字段索引
+   * @param value 新值
+   */
+  template <std::size_t I, typename U = T>
+    requires Meta::HasBitLayout<Meta::PacketTraits<U>>
+  void set(typename BitRef<U>::Info::template field_type<I> value) noexcept {
+    using Info = typename BitRef<U>::Info;
+    constexpr size_t first = Info::template bit_offset<I> / 8;
+    constexpr size_t last =
+        (Info::template bit_offset<I> + Info::template bit_width<I> + 7) / 8;
+    constexpr size_t span = last - first;
+
+    std::array<uint8_t, data_size> scratch{};
+    const uint8_t *cur = frame_.data() + header_size;
+    std::copy_n(cur + first, span, scratch.begin() + first);
+    BitRef<U>{std::span<uint8_t>(scratch)}.template set<I>(value);
+
+    patch(header_size + first, scratch.data() + first, span);
+  }
+
+  /// @brief 读取位流负载的第 I 个字段
+  template <std::size_t I>
+    requires Meta::HasBitLayout<Meta::PacketTraits<T>>
+  [[nodiscard]] auto get() const noexcept {
+    return BitView<T>{payload()}.template get<I>();
+  }
+
+  /// @brief 当前序列号（协议无序列号时恒为 0）
+  [[nodiscard]] uint8_t seq() const noexcept {
+    if constexpr (Template::has_seq) {
+      return frame_[Protocol::seq_offset];
+    } else {
+      return 0;
+    }
+  }
+
+  /**
+   * @brief 修改序列号
+   *
+   * 帧头 CRC8 查表获得，CRC16 只修补帧头中变化的字节。
+   *
+   * @param seq 新序列号
+   */
+  void set_seq(uint8_t seq) noexcept {
+    if constexpr (Template::has_seq) {
+      constexpr size_t first = Template::const_prefix_size;
+      std::array<uint8_t, header_size> header{};
+      Template::write_header(header.data(), seq, data_len_);
+      patch(first, header.data() + first, header_size - first);
+    }
+  }
+
+  /// @brief 序列号加一（用于每次发送前）
+  void advance_seq() noexcept { set_seq(static_cast<uint8_t>(seq() + 1)); }
+
+private:
+  void rebuild(const T &packet, uint8_t seq) noexcept {
+    data_len_ = Meta::payload_size<T>(packet);
+    Template::write_header(frame_.data(), seq, data_len_);
+    encode_payload(packet, frame_.data() + header_size);
+    Template::write_tail(frame_.data(), data_len_);
+  }
+
+  static void encode_payload(const T &packet, uint8_t *dst) noexcept {
+    if constexpr (Meta::HasVariableLength<T>) {
+      std::memcpy(dst, &packet, Meta::payload_size<T>(packet));
+    } else if constexpr (Meta::HasBitLayout<Meta::PacketTraits<T>>) {
+      std::fill_n(dst, data_size, uint8_t{0});
+      serialize_bitstream<T>(std::span<uint8_t>(dst, data_size), packet);
+    } else {
+      std::memcpy(dst, &packet, data_size);
+    }
+  }
+
+  /**
+   * @brief 覆盖帧内一段字节并增量修补 CRC16
+   *
+   * @param pos 帧内偏移（必须位于 CRC 覆盖范围内）
+   * @param src 新字节
+   * @param len 字节数
+   */
+  void patch(size_t pos, const uint8_t *src, size_t len) noexcept {
+    uint8_t *dst = frame_.data() + pos;
+    if constexpr (Template::tail_size > 0) {
+      using Crc = typename Protocol::RPL_CRC;
+      using Combine = CrcCombine<Crc>;
+      typename Crc::type delta = 0;
+      for (size_t i = 0; i < len; ++i) {
+        delta =
+            Combine::update_raw(delta, static_cast<uint8_t>(dst[i] ^ src[i]));
+        dst[i] = src[i];
+      }
+      const size_t crc_end = header_size + data_len_;
+      delta = Combine::shift_zeros(delta, crc_end - (pos + len));
+
+      uint8_t *tail = frame_.data() + crc_end;
+      tail[0] ^= static_cast<uint8_t>(delta & 0xFF);
+      tail[1] ^= static_cast<uint8_t>((delta >> 8) & 0xFF);
+    } else {
+      std::copy_n(src, len, dst);
+    }
+  }
+
+  std::array<uint8_t, frame_size> frame_{};
+  size_t data_len_ = data_size; ///< 当前负载长度
+};
+
+} // namespace RPL
+
+#endif // RPL_FRAME_HANDLE_HPP
@@ -0,0 +1,315 @@
+/**
+ * @file FrameRelay.hpp
+ * @brief RPL 直通转发：不解码地在链路之间转发已校验的帧
+ *
+ * 此文件提供 FrameRelay，把 Parser 校验通过的原始帧按命令码路由到输出端，
+ * 可选地换成另一种协议的帧头 / 帧尾（如裁判系统 UART 帧 → USB 帧）。
+ *
+ * @par 设计原理
+ * - 通过 Parser::set_frame_hook 拿到原始帧视图，不经过 Deserializer / Serializer
+ * - 协议不变时直接交出接收缓冲区中的原始帧视图，负载与 CRC 都不重新处理
+ * - 换协议时只在本地写新的帧头与帧尾，负载仍以视图交出；
+ *   帧尾 CRC 沿负载分段继续计算，不拼接负载
+ * - 输出端收到最多 4 段的 FrameParts（帧头、负载两段、帧尾），
+ *   可以分散写出（writev / 多次 DMA），也可以 copy_to() 到发送缓冲区
+ * - 路由表固定容量；可选的过滤回调在路由之后、输出之前调用
+ *
+ * @par 使用场景
+ * - MCU 把裁判系统 UART 帧转发到上位机 USB，或反向转发
+ * - 网关在两条同协议链路之间转发指定命令码
+ *
+ * @code
+ * RPL::Parser<RefereeA> parser{des};
+ * RPL::FrameRelay relay{[](const RPL::FrameParts &f) {
+ *     uint8_t buf[256];
+ *     return usb_write(buf, f.copy_to(buf, sizeof(buf)));
+ * }};
+ * relay.forward(0x0201);                           // 原样转发
+ * relay.rewrap<RPL::Meta::USBBaseProto>(0x0202);   // 换成 USB 帧头
+ * relay.attach(parser);
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_FRAME_RELAY_HPP
+#define RPL_FRAME_RELAY_HPP
+
+#include "Meta/FrameTemplate.hpp"
+#include "Meta/PacketTraits.hpp"
+#include "Parser.hpp"
+#include "Utils/Def.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+
+namespace RPL {
+
+/**
+ * @brief 待输出帧的分段视图
+ *
+ * 各段按顺序拼接即为完整帧；视图只在输出回调期间有效。
+ */
+struct FrameParts {
+  std::array<std::span<const uint8_t>, 4> parts{};
+  size_t count = 0;
+  uint16_t cmd = 0; ///< 输出帧的命令码
+
+  /// @brief 追加一段（空段忽略）
+  constexpr void append(std::span<const uint8_t> part) noexcept {
+    if (!part.empty())
+      parts[count++] = part;
+  }
+
+  /// @brief 完整帧长度
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i)
+      n += parts[i].size();
+    return n;
+  }
+
+  /**
+   * @brief 把完整帧拷贝到连续缓冲区
+   * @return 写入的字节数；空间不足时返回 0
+   */
+  size_t copy_to(uint8_t *dst, size_t capacity) const noexcept {
+    const size_t total = size();
+    if (total > capacity)
+      return 0;
+    for (size_t i = 0; i < count; ++i) {
+      std::memcpy(dst, parts[i].data(), parts[i].size());
+      dst += parts[i].size();
+    }
+    return total;
+  }
+
+  [[nodiscard]] constexpr auto begin() const noexcept { return parts.begin(); }
+  [[nodiscard]] constexpr auto end() const noexcept {
+    return parts.begin() + count;
+  }
+};
+
+/**
+ * @brief 直通转发器
+ *
+ * @tparam Sink 输出回调 bool(const FrameParts &)，返回是否被接受
+ * @tparam MaxRoutes 路由表容量
+ */
+template <typename Sink, size_t MaxRoutes = 8> class FrameRelay {
+public:
+  /// @brief 匹配所有命令码的路由
+  static constexpr uint32_t any_cmd = 0x10000;
+
+  explicit FrameRelay(Sink sink) : sink_(std::move(sink)) {}
+
+  FrameRelay(const FrameRelay &) = delete;
+  FrameRelay &operator=(const FrameRelay &) = delete;
+
+  /**
+   * @brief 接收 Parser 校验通过的每一帧
+   *
+   * @note 占用 Parser 的原始帧回调
+   */
+  template <typename ParserType> void attach(ParserType &parser) noexcept {
+    parser.set_frame_hook(FrameHook{this, &FrameRelay::on_frame});
+  }
+
+  /**
+   * @brief 原样转发命令码为 cmd 的帧
+   *
+   * @param cmd 命令码（any_cmd 匹配所有未单独路由的帧）
+   * @return 路由表已满时返回 false
+   */
+  bool forward(uint32_t cmd) noexcept {
+    return add_route(Route{cmd, 0, &FrameRelay::emit_original});
+  }
+
+  /// @brief 原样转发所有帧
+  bool forward_all() noexcept { return forward(any_cmd); }
+
+  /**
+   * @brief 以 OutProtocol 的帧头 / 帧尾转发命令码为 cmd 的帧
+   *
+   * 输入帧有序列号时沿用，否则使用转发器自己的递增序列号。
+   *
+   * @tparam OutProtocol 输出协议（须包含长度与命令码字段）
+   * @param cmd 输入命令码（any_cmd 匹配所有未单独路由的帧）
+   * @param out_cmd 输出命令码（默认与输入相同）
+   * @return 路由表已满时返回 false
+   */
+  template <typename OutProtocol>
+  bool rewrap(uint32_t cmd, uint32_t out_cmd = any_cmd) noexcept {
+    static_assert(OutProtocol::has_length_field && OutProtocol::has_cmd_field,
+                  "Output protocol must carry length and cmd fields");
+    static_assert(OutProtocol::header_size <= max_header_size &&
+                      OutProtocol::tail_size <= max_tail_size,
+                  "Output protocol header/tail too large");
+    return add_route(Route{cmd, out_cmd, &FrameRelay::emit_wrapped<OutProtocol>});
+  }
+
+  /// @brief 清空路由表
+  void clear_routes() noexcept { route_count_ = 0; }
+
+  /**
+   * @brief 设置过滤回调
+   *
+   * @param fn 返回 false 时丢弃该帧（nullptr 表示取消）
+   * @param ctx 回调上下文
+   */
+  void set_filter(bool (*fn)(void *ctx, const RawFrame &frame),
+                  void *ctx = nullptr) noexcept {
+    filter_ = fn;
+    filter_ctx_ = ctx;
+  }
+
+  /**
+   * @brief 处理一帧（attach 后由 Parser 调用，也可手动调用）
+   * @return 帧被输出端接受时返回 true
+   */
+  bool relay(const RawFrame &frame) {
+    const Route *route = find(frame.cmd);
+    if (!route) {
+      ++unrouted_;
+      return false;
+    }
+    if (filter_ && !filter_(filter_ctx_, frame)) {
+      ++filtered_;
+      return false;
+    }
+    const bool ok = route->emit(*this, frame, route->out_cmd);
+    ++(ok ? forwarded_ : rejected_);
+    return ok;
+  }
+
+  Sink &sink() noexcept { return sink_; }
+
+  /// @brief 已转发的帧数
+  [[nodiscard]] uint32_t forwarded() const noexcept { return forwarded_; }
+
+  /// @brief 输出端拒绝的帧数
+  [[nodiscard]] uint32_t rejected() const noexcept { return rejected_; }
+
+  /// @brief 没有匹配路由的帧数
+  [[nodiscard]] uint32_t unrouted() const noexcept { return unrouted_; }
+
+  /// @brief 被过滤回调丢弃的帧数
+  [[nodiscard]] uint32_t filtered() const noexcept { return filtered_; }
+
+private:
+  static constexpr size_t max_header_size = 16;
+  static constexpr size_t max_tail_size = 2;
+
+  struct Route {
+    uint32_t cmd;
+    uint32_t out_cmd;
+    bool (*emit)(FrameRelay &self, const RawFrame &frame, uint32_t out_cmd);
+  };
+
+  static bool on_frame(void *ctx, const RawFrame &frame) {
+    (void)static_cast<FrameRelay *>(ctx)->relay(frame);
+    return true;
+  }
+
+  bool add_route(const Route &route) noexcept {
+    for (size_t i = 0; i < route_count_; ++i) {
+      if (routes_[i].cmd == route.cmd) {
+        routes_[i] = route;
+        return true;
+      }
+    }
+    if (route_count_ == MaxRoutes)
+      return false;
+    routes_[route_count_++] = route;
+    return true;
+  }
+
+  /// @brief 精确匹配优先于 any_cmd
+  const Route *find(uint16_t cmd) const noexcept {
+    const Route *fallback = nullptr;
+    for (size_t i = 0; i < route_count_; ++i) {
+      if (routes_[i].cmd == cmd)
+        return &routes_[i];
+      if (routes_[i].cmd == any_cmd)
+        fallback = &routes_[i];
+    }
+    return fallback;
+  }
+
+  static bool emit_original(FrameRelay &self, const RawFrame &frame,
+                            uint32_t) {
+    FrameParts out;
+    out.cmd = frame.cmd;
+    out.append(frame.s1);
+    out.append(frame.s2);
+    return self.sink_(static_cast<const FrameParts &>(out));
+  }
+
+  template <typename P>
+  static bool emit_wrapped(FrameRelay &self, const RawFrame &frame,
+                           uint32_t out_cmd) {
+    const auto cmd =
+        static_cast<uint16_t>(out_cmd == any_cmd ? frame.cmd : out_cmd);
+    const size_t len = frame.payload_size();
+    if constexpr (P::length_field_bytes == 1) {
+      if (len > 0xFF)
+        return false;
+    }
+
+    std::array<uint8_t, max_header_size> header{};
+    header[0] = P::start_byte;
+    if constexpr (P::has_second_byte)
+      header[1] = P::second_byte;
+    header[P::length_offset] = static_cast<uint8_t>(len & 0xFF);
+    if constexpr (P::length_field_bytes == 2)
+      header[P::length_offset + 1] = static_cast<uint8_t>(len >> 8);
+    header[P::cmd_offset] = static_cast<uint8_t>(cmd & 0xFF);
+    if constexpr (P::cmd_field_bytes == 2)
+      header[P::cmd_offset + 1] = static_cast<uint8_t>(cmd >> 8);
+    if constexpr (Meta::protocol_has_seq<P>) {
+      header[P::seq_offset] = frame.seq >= 0 ? static_cast<uint8_t>(frame.seq)
+                                             : self.seq_++;
+    }
+    if constexpr (P::has_header_crc)
+      header[P::header_crc_offset] =
+          ProtocolCRC8::calc(header.data(), P::header_crc_offset);
+
+    std::array<uint8_t, max_tail_size> tail{};
+    if constexpr (P::tail_size > 0) {
+      auto crc = P::RPL_CRC::calc(header.data(), P::header_size);
+      crc = P::RPL_CRC::calc(frame.payload_s1.data(), frame.payload_s1.size(),
+                             crc);
+      crc = P::RPL_CRC::calc(frame.payload_s2.data(), frame.payload_s2.size(),
+                             crc);
+      tail[0] = static_cast<uint8_t>(crc & 0xFF);
+      tail[1] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+    }
+
+    FrameParts out;
+    out.cmd = cmd;
+    out.append({header.data(), P::header_size});
+    out.append(frame.payload_s1);
+    out.append(frame.payload_s2);
+    out.append({tail.data(), P::tail_size});
+    return self.sink_(static_cast<const FrameParts &>(out));
+  }
+
+  Sink sink_;
+  std::array<Route, MaxRoutes> routes_{};
+  size_t route_count_ = 0;
+  bool (*filter_)(void *, const RawFrame &) = nullptr;
+  void *filter_ctx_ = nullptr;
+  uint8_t seq_ = 0;
+
+  uint32_t forwarded_ = 0;
+  uint32_t rejected_ = 0;
+  uint32_t unrouted_ = 0;
+  uint32_t filtered_ = 0;
+};
+
+} // namespace RPL
+
+#endif // RPL_FRAME_RELAY_HPP
@@ -0,0 +1,236 @@
+/**
+ * @file LinkMerger.hpp
+ * @brief RPL 冗余链路合并：多条链路上的同一数据流按首达去重
+ *
+ * 此文件提供 LinkMerger，把两条及以上冗余链路（如 UART + USB、双 UART）
+ * 的 Parser 接到同一个 Deserializer 上，每帧只采用最先到达的一份。
+ *
+ * @par 设计原理
+ * - 通过 Parser::set_frame_hook 在分发之前判断；重复帧返回 false，
+ *   不触发 after_parse / PacketHook，也不写入 Deserializer
+ * - 去重键为（命令码，序列号，负载 FNV-1a 哈希）；
+ *   协议无序列号时只用命令码与哈希
+ * - 最近 History 个首达帧按到达顺序保存在环形表中；超过 window 的记录退役，
+ *   退役时仍未送达的链路计一次丢失
+ * - 重复帧到达时，首达链路累计一次领先时间（两次到达的 tick 差）
+ * - 同一链路在窗口内再次送达相同的键视为新帧（无序列号协议的重复内容），
+ *   其它链路的后续送达按先后顺序与这些记录配对
+ *
+ * @par 使用场景
+ * - 关键数据双链路冗余传输，一条线缆故障时不丢数据
+ * - 比较两条链路的延迟与丢包
+ *
+ * @warning 所有链路共享同一 Deserializer（单写者），各 Parser 须在同一线程中
+ *          push_data；window 应大于链路间的最大延迟差，
+ *          History 应大于 window 内的最大帧数（否则 overflows() 递增）
+ *
+ * @code
+ * RPL::Deserializer<Gimbal> des;
+ * RPL::Parser<Gimbal> uart{des}, usb{des};
+ * RPL::LinkMerger<MyTick> merger{20};   // 20 tick 去重窗口
+ * merger.attach(0, uart);
+ * merger.attach(1, usb);
+ * ...
+ * merger.stats(0).average_lead();       // UART 平均领先多少 tick
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_LINK_MERGER_HPP
+#define RPL_LINK_MERGER_HPP
+
+#include "Parser.hpp"
+#include "Utils/ConnectionMonitor.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace RPL {
+
+/**
+ * @brief 单条链路的统计
+ */
+struct LinkStats {
+  uint32_t frames = 0;       ///< 通过校验的帧数
+  uint32_t first = 0;        ///< 首先到达（被采用）的帧数
+  uint32_t duplicates = 0;   ///< 作为重复帧丢弃的帧数
+  uint32_t missed = 0;       ///< 其它链路送达、本链路在窗口内未送达的帧数
+  uint64_t lead_total = 0;   ///< 首达时领先其它链路的 tick 累计
+  uint32_t lead_samples = 0; ///< lead_total 的样本数
+
+  /// @brief 平均领先 tick（无样本时为 0）
+  [[nodiscard]] double average_lead() const noexcept {
+    return lead_samples ? static_cast<double>(lead_total) / lead_samples : 0.0;
+  }
+};
+
+/**
+ * @brief 冗余链路合并器
+ *
+ * @tparam TickProvider 时间戳提供器
+ * @tparam Links 链路数（2 ~ 8）
+ * @tparam History 去重表容量（首达帧记录数）
+ */
+template <TickProviderConcept TickProvider, size_t Links = 2,
+          size_t History = 64>
+class LinkMerger {
+  static_assert(Links >= 2 && Links <= 8, "Links must be in [2, 8]");
+  static_assert(History > 0, "History must be positive");
+
+public:
+  using tick_type = typename TickProvider::tick_type;
+
+  static constexpr size_t links = Links;
+
+  /**
+   * @param window 去重窗口（tick），超过窗口的首达记录退役
+   */
+  explicit LinkMerger(tick_type window) noexcept : window_(window) {
+    for (size_t i = 0; i < Links; ++i)
+      ports_[i] = Port{this, static_cast<uint8_t>(i)};
+  }
+
+  LinkMerger(const LinkMerger &) = delete;
+  LinkMerger &operator=(const LinkMerger &) = delete;
+
+  /**
+   * @brief 把 parser 作为第 link 条链路接入
+   *
+   * @note 占用 Parser 的原始帧回调
+   */
+  template <typename ParserType>
+  void attach(size_t link, ParserType &parser) noexcept {
+    parser.set_frame_hook(FrameHook{&ports_[link], &LinkMerger::on_frame});
+  }
+
+  /**
+   * @brief 判断第 link 条链路上的一帧是否首次到达
+   *
+   * attach 后由 Parser 调用，也可手动调用。
+   *
+   * @return 首次到达时返回 true（应当处理），重复时返回 false
+   */
+  bool admit(size_t link, const RawFrame &frame) noexcept {
+    return admit(link, frame.cmd, frame.seq,
+                 hash(frame.payload_s2, hash(frame.payload_s1)));
+  }
+
+  /**
+   * @brief 退役超过窗口的首达记录并统计丢失
+   *
+   * admit() 内部会调用；链路全部静默时可周期调用以刷新丢失统计。
+   */
+  void expire() noexcept { expire(TickProvider::now()); }
+
+  /// @brief 立即退役所有首达记录（如统计前或重连后）
+  void settle() noexcept {
+    while (count_ > 0)
+      retire();
+  }
+
+  /// @brief 第 link 条链路的统计
+  [[nodiscard]] const LinkStats &stats(size_t link) const noexcept {
+    return stats_[link];
+  }
+
+  /// @brief 去重表已满、记录在窗口内被挤出的次数
+  [[nodiscard]] uint32_t overflows() const noexcept { return overflows_; }
+
+  /// @brief 清零统计（不影响去重表）
+  void reset_stats() noexcept {
+    stats_ = {};
+    overflows_ = 0;
+  }
+
+  [[nodiscard]] tick_type window() const noexcept { return window_; }
+
+private:
+  struct Port {
+    LinkMerger *self;
+    uint8_t link;
+  };
+
+  struct Entry {
+    uint32_t hash;
+    uint16_t cmd;
+    int16_t seq;
+    tick_type tick;
+    uint8_t first; ///< 首达链路
+    uint8_t seen;  ///< 已送达链路的位掩码
+  };
+
+  static bool on_frame(void *ctx, const RawFrame &frame) {
+    const auto *port = static_cast<const Port *>(ctx);
+    return port->self->admit(port->link, frame);
+  }
+
+  /// @brief FNV-1a（可分段链式计算）
+  static constexpr uint32_t hash(std::span<const uint8_t> data,
+                                 uint32_t h = 2166136261u) noexcept {
+    for (uint8_t b : data)
+      h = (h ^ b) * 16777619u;
+    return h;
+  }
+
+  bool admit(size_t link, uint16_t cmd, int16_t seq, uint32_t h) noexcept {
+    const tick_type now = TickProvider::now();
+    expire(now);
+    LinkStats &st = stats_[link];
+    ++st.frames;
+
+    const auto bit = static_cast<uint8_t>(1u << link);
+    // 从最早的记录向后查找本链路尚未送达的同键记录：无序列号协议的
+    // 重复内容按到达顺序与其它链路的各次送达一一配对
+    for (size_t i = 0; i < count_; ++i) {
+      Entry &e = entries_[(head_ + i) % History];
+      if (e.hash != h || e.cmd != cmd || e.seq != seq || (e.seen & bit))
+        continue;
+      e.seen |= bit;
+      ++st.duplicates;
+      LinkStats &lead = stats_[e.first];
+      lead.lead_total += static_cast<tick_type>(now - e.tick);
+      ++lead.lead_samples;
+      return false;
+    }
+
+    if (count_ == History) {
+      ++overflows_;
+      retire();
+    }
+    entries_[(head_ + count_) % History] =
+        Entry{h, cmd, seq, now, static_cast<uint8_t>(link), bit};
+    ++count_;
+    ++st.first;
+    return true;
+  }
+
+  void expire(tick_type now) noexcept {
+    while (count_ > 0 &&
+           static_cast<tick_type>(now - entries_[head_].tick) > window_)
+      retire();
+  }
+
+  /// @brief 退役最早的记录，未送达的链路计一次丢失
+  void retire() noexcept {
+    const uint8_t seen = entries_[head_].seen;
+    for (size_t i = 0; i < Links; ++i)
+      if (!(seen & (1u << i)))
+        ++stats_[i].missed;
+    head_ = (head_ + 1) % History;
+    --count_;
+  }
+
+  tick_type window_;
+  std::array<Port, Links> ports_{};
+  std::array<Entry, History> entries_{};
+  size_t head_ = 0;
+  size_t count_ = 0;
+  std::array<LinkStats, Links> stats_{};
+  uint32_t overflows_ = 0;
+};
+
+} // namespace RPL
+
+#endif // RPL_LINK_MERGER_HPP
@@ -0,0 +1,494 @@
+/**
+ * @file DatagramBridge.hpp
+ * @brief RPL 帧的 UDP / Unix 数据报跨进程分发
+ *
+ * 此文件提供 DatagramPublisher 与 DatagramSubscriber：持有串口的进程把
+ * Parser 校验通过的原始帧原样转发到 UDP（单播或组播）或 Unix 数据报套接字，
+ * 其他进程用自己的 Parser / Deserializer 接收，不再各自实现 IPC。
+ *
+ * @par 设计原理
+ * - 转发的是通过 CRC 校验的完整帧（经 Parser::set_frame_hook），
+ *   不是重新序列化的结构体；每个数据报恰好一帧
+ * - 发布端在一次解析过程中收集全部帧，解析结束后每个目的地址一次 sendmmsg；
+ *   push() 即 push_data + flush
+ * - 发布端套接字为非阻塞：订阅者不存在或来不及接收时丢帧计数，
+ *   不阻塞解析进程
+ * - 订阅端用一次 recvmmsg 读取一批数据报，逐个 push_data 到 Parser；
+ *   Parser 照常校验，因此订阅端与串口直连时的行为一致
+ * - 套接字调用失败时的错误约定见 SysError.hpp
+ *
+ * @par 使用场景
+ * - 上位机上视觉、导航、UI 等进程共享同一路裁判系统数据
+ *
+ * @code
+ * // 持有串口的进程
+ * RPL::Parser<GameStatus, RobotStatus> parser{des};
+ * RPL::Linux::DatagramPublisher<> pub;
+ * pub.open_udp("239.0.0.1", 30001);
+ * pub.attach(parser);
+ * while (running) {
+ *     ssize_t n = read(serial_fd, buf, sizeof(buf));
+ *     pub.push(parser, buf, n);
+ * }
+ *
+ * // 其他进程
+ * RPL::Parser<GameStatus> sub_parser{sub_des};
+ * RPL::Linux::DatagramSubscriber<decltype(sub_parser)> sub{sub_parser};
+ * sub.open_udp("239.0.0.1", 30001);
+ * while (running)
+ *     sub.receive(true);
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_LINUX_DATAGRAM_BRIDGE_HPP
+#define RPL_LINUX_DATAGRAM_BRIDGE_HPP
+
+#ifndef __linux__
+#error "RPL/Linux/DatagramBridge.hpp requires Linux"
+#endif
+
+#include "RPL/Linux/SysError.hpp"
+#include "RPL/Parser.hpp"
+#include <arpa/inet.h>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <netinet/in.h>
+#include <span>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <tl/expected.hpp>
+#include <unistd.h>
+
+namespace RPL::Linux {
+
+namespace detail {
+
+/// @brief 解析 IPv4 地址与端口
+inline bool make_inet_address(const char *address, uint16_t port,
+                              sockaddr_in &out) {
+  out = {};
+  out.sin_family = AF_INET;
+  out.sin_port = htons(port);
+  return ::inet_pton(AF_INET, address, &out.sin_addr) == 1;
+}
+
+/// @brief 填写 Unix 套接字地址
+inline bool make_unix_address(const char *path, sockaddr_un &out) {
+  out = {};
+  out.sun_family = AF_UNIX;
+  if (std::strlen(path) >= sizeof(out.sun_path))
+    return false;
+  std::strcpy(out.sun_path, path);
+  return true;
+}
+
+inline tl::unexpected<Error> bad_address() {
+  return tl::unexpected(Error{ErrorCode::IoError, "Invalid address"});
+}
+
+} // namespace detail
+
+/**
+ * @brief 原始帧发布端
+ *
+ * @tparam Batch 单次 sendmmsg 的最大帧数（满时自动 flush）
+ * @tparam MaxFrameSize 单帧最大字节数
+ * @tparam MaxPeers 最大目的地址数
+ */
+template <size_t Batch = 32, size_t MaxFrameSize = 512, size_t MaxPeers = 4>
+class DatagramPublisher {
+public:
+  DatagramPublisher() {
+    for (size_t i = 0; i < Batch; ++i) {
+      iov_[i] = {frames_[i].data(), 0};
+      msgs_[i] = {};
+      msgs_[i].msg_hdr.msg_iov = &iov_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+
+  ~DatagramPublisher() { close(); }
+
+  DatagramPublisher(const DatagramPublisher &) = delete;
+  DatagramPublisher &operator=(const DatagramPublisher &) = delete;
+
+  /**
+   * @brief 打开 UDP 套接字并以 address:port 为目的地址
+   *
+   * @param address IPv4 单播或组播地址
+   * @param port 目的端口
+   * @param interface_addr 组播出口接口地址（nullptr 表示由路由决定）
+   * @param ttl 组播 TTL（1 表示不出本网段）
+   */
+  tl::expected<void, Error> open_udp(const char *address, uint16_t port,
+                                     const char *interface_addr = nullptr,
+                                     int ttl = 1) {
+    close();
+    sockaddr_in dest;
+    if (!detail::make_inet_address(address, port, dest))
+      return detail::bad_address();
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0)
+      return detail::errno_error("socket");
+
+    if (IN_MULTICAST(ntohl(dest.sin_addr.s_addr))) {
+      const int loop = 1;
+      if (::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop,
+                       sizeof(loop)) < 0 ||
+          ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) <
+              0)
+        return fail("IP_MULTICAST");
+      if (interface_addr) {
+        in_addr iface{};
+        if (::inet_pton(AF_INET, interface_addr, &iface) != 1) {
+          close();
+          return detail::bad_address();
+        }
+        if (::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &iface,
+                         sizeof(iface)) < 0)
+          return fail("IP_MULTICAST_IF");
+      }
+    }
+    add_peer(&dest, sizeof(dest));
+    return {};
+  }
+
+  /**
+   * @brief 打开 Unix 数据报套接字（目的地址由 add_unix_peer 添加）
+   */
+  tl::expected<void, Error> open_unix() {
+    close();
+    fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0)
+      return detail::errno_error("socket");
+    return {};
+  }
+
+  /**
+   * @brief 添加一个 Unix 数据报订阅者
+   *
+   * @param path 订阅者绑定的路径
+   */
+  tl::expected<void, Error> add_unix_peer(const char *path) {
+    sockaddr_un dest;
+    if (!detail::make_unix_address(path, dest))
+      return detail::bad_address();
+    if (!add_peer(&dest, sizeof(dest)))
+      return tl::unexpected(
+          Error{ErrorCode::BufferOverflow, "Too many peers"});
+    return {};
+  }
+
+  /// @brief 关闭套接字并清空目的地址与待发批次
+  void close() {
+    if (fd_ >= 0)
+      ::close(fd_);
+    fd_ = -1;
+    peer_count_ = 0;
+    count_ = 0;
+  }
+
+  /**
+   * @brief 把 Parser 校验通过的每一帧加入待发批次
+   *
+   * @note 占用 Parser 的原始帧回调
+   */
+  template <typename ParserType> void attach(ParserType &parser) noexcept {
+    parser.set_frame_hook(FrameHook{this, &DatagramPublisher::on_frame});
+  }
+
+  /**
+   * @brief 推送数据到 Parser 并发出本次解析得到的全部帧
+   *
+   * @return Parser 的错误优先，其次是发送错误
+   */
+  template <typename ParserType>
+  tl::expected<void, Error> push(ParserType &parser, const uint8_t *data,
+                                 size_t length) {
+    auto parsed = parser.push_data(data, length);
+    auto sent = flush();
+    if (!parsed)
+      return parsed;
+    return sent;
+  }
+
+  /**
+   * @brief 把一帧加入待发批次（批次满时先 flush）
+   *
+   * @param s1 帧的第一段
+   * @param s2 帧的第二段（跨越环形缓冲区末尾时非空）
+   * @return 帧超过 MaxFrameSize 时返回 false
+   */
+  bool queue(std::span<const uint8_t> s1, std::span<const uint8_t> s2 = {}) {
+    const size_t size = s1.size() + s2.size();
+    if (size > MaxFrameSize) {
+      ++dropped_;
+      return false;
+    }
+    if (count_ == Batch)
+      (void)flush();
+    std::memcpy(frames_[count_].data(), s1.data(), s1.size());
+    if (!s2.empty())
+      std::memcpy(frames_[count_].data() + s1.size(), s2.data(), s2.size());
+    iov_[count_].iov_len = size;
+    ++count_;
+    return true;
+  }
+
+  /**
+   * @brief 向每个目的地址用一次 sendmmsg 发出待发批次
+   *
+   * 订阅者不存在或接收缓冲区已满时丢弃发往该订阅者的剩余帧并计数，
+   * 不视为错误。无论成功与否，待发批次都会被清空。
+   */
+  tl::expected<void, Error> flush() {
+    tl::expected<void, Error> result{};
+    for (size_t p = 0; p < peer_count_ && count_ > 0; ++p) {
+      for (size_t i = 0; i < count_; ++i) {
+        msgs_[i].msg_hdr.msg_name = &peers_[p].addr;
+        msgs_[i].msg_hdr.msg_namelen = peers_[p].len;
+      }
+      size_t done = 0;
+      while (done < count_) {
+        const int n = ::sendmmsg(fd_, msgs_.data() + done,
+                                 static_cast<unsigned>(count_ - done), 0);
+        if (n >= 0) {
+          done += static_cast<size_t>(n);
+          continue;
+        }
+        if (errno == EINTR)
+          continue;
+        if (!peer_unavailable(errno) && result)
+          result = detail::errno_error("sendmmsg");
+        break;
+      }
+      sent_ += done;
+      dropped_ += count_ - done;
+    }
+    count_ = 0;
+    return result;
+  }
+
+  /// @brief 套接字描述符
+  [[nodiscard]] int fd() const noexcept { return fd_; }
+
+  /// @brief 待发批次中的帧数
+  [[nodiscard]] size_t queued() const noexcept { return count_; }
+
+  /// @brief 目的地址数
+  [[nodiscard]] size_t peers() const noexcept { return peer_count_; }
+
+  /// @brief 累计发出的数据报数（每个目的地址分别计数）
+  [[nodiscard]] uint64_t sent() const noexcept { return sent_; }
+
+  /// @brief 累计丢弃的数据报数（每个目的地址分别计数）
+  [[nodiscard]] uint64_t dropped() const noexcept { return dropped_; }
+
+private:
+  struct Peer {
+    sockaddr_storage addr;
+    socklen_t len;
+  };
+
+  static bool on_frame(void *ctx, const RawFrame &frame) {
+    static_cast<DatagramPublisher *>(ctx)->queue(frame.s1, frame.s2);
+    return true;
+  }
+
+  /// @brief 订阅者不存在或来不及接收
+  static bool peer_unavailable(int err) noexcept {
+    return err == EAGAIN || err == EWOULDBLOCK || err == ENOBUFS ||
+           err == ECONNREFUSED || err == ENOENT;
+  }
+
+  bool add_peer(const void *addr, size_t len) noexcept {
+    if (peer_count_ == MaxPeers)
+      return false;
+    std::memcpy(&peers_[peer_count_].addr, addr, len);
+    peers_[peer_count_].len = static_cast<socklen_t>(len);
+    ++peer_count_;
+    return true;
+  }
+
+  tl::unexpected<Error> fail(const char *what) {
+    auto err = detail::errno_error(what);
+    close();
+    return err;
+  }
+
+  int fd_ = -1;
+  std::array<Peer, MaxPeers> peers_{};
+  size_t peer_count_ = 0;
+
+  std::array<std::array<uint8_t, MaxFrameSize>, Batch> frames_{};
+  std::array<iovec, Batch> iov_{};
+  std::array<mmsghdr, Batch> msgs_{};
+  size_t count_ = 0;
+
+  uint64_t sent_ = 0;
+  uint64_t dropped_ = 0;
+};
+
+/**
+ * @brief 原始帧订阅端
+ *
+ * @tparam ParserType 接收端 Parser（数据包集合可以是发布端的子集）
+ * @tparam Batch 单次 recvmmsg 的最大数据报数
+ * @tparam MaxFrameSize 单帧最大字节数
+ */
+template <typename ParserType, size_t Batch = 32, size_t MaxFrameSize = 512>
+class DatagramSubscriber {
+public:
+  explicit DatagramSubscriber(ParserType &parser) : parser_(parser) {
+    for (size_t i = 0; i < Batch; ++i) {
+      iov_[i] = {frames_[i].data(), MaxFrameSize};
+      msgs_[i] = {};
+      msgs_[i].msg_hdr.msg_iov = &iov_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+
+  ~DatagramSubscriber() { close(); }
+
+  DatagramSubscriber(const DatagramSubscriber &) = delete;
+  DatagramSubscriber &operator=(const DatagramSubscriber &) = delete;
+
+  /**
+   * @brief 在 address:port 上接收 UDP 数据报
+   *
+   * 组播地址会加入组播组，并允许同一主机上的多个订阅者共用端口。
+   *
+   * @param address IPv4 单播（本机）或组播地址
+   * @param port 端口
+   * @param interface_addr 加入组播组的接口地址（nullptr 表示任意接口）
+   */
+  tl::expected<void, Error> open_udp(const char *address, uint16_t port,
+                                     const char *interface_addr = nullptr) {
+    close();
+    sockaddr_in local;
+    if (!detail::make_inet_address(address, port, local))
+      return detail::bad_address();
+    const bool multicast = IN_MULTICAST(ntohl(local.sin_addr.s_addr));
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0)
+      return detail::errno_error("socket");
+
+    if (multicast) {
+      const int reuse = 1;
+      if (::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) <
+          0)
+        return fail("SO_REUSEADDR");
+    }
+    if (::bind(fd_, reinterpret_cast<sockaddr *>(&local), sizeof(local)) < 0)
+      return fail("bind");
+    if (multicast) {
+      ip_mreq mreq{};
+      mreq.imr_multiaddr = local.sin_addr;
+      mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+      if (interface_addr &&
+          ::inet_pton(AF_INET, interface_addr, &mreq.imr_interface) != 1) {
+        close();
+        return detail::bad_address();
+      }
+      if (::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq,
+                       sizeof(mreq)) < 0)
+        return fail("IP_ADD_MEMBERSHIP");
+    }
+    return {};
+  }
+
+  /**
+   * @brief 在 Unix 数据报路径上接收（已存在的路径会被替换）
+   *
+   * @param path 绑定路径，close() 时删除
+   */
+  tl::expected<void, Error> open_unix(const char *path) {
+    close();
+    sockaddr_un local;
+    if (!detail::make_unix_address(path, local))
+      return detail::bad_address();
+    fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0)
+      return detail::errno_error("socket");
+    ::unlink(path);
+    if (::bind(fd_, reinterpret_cast<sockaddr *>(&local), sizeof(local)) < 0)
+      return fail("bind");
+    unix_path_ = local;
+    return {};
+  }
+
+  /// @brief 关闭套接字（Unix 数据报时删除绑定路径）
+  void close() {
+    if (fd_ >= 0)
+      ::close(fd_);
+    fd_ = -1;
+    if (unix_path_.sun_path[0] != '\0')
+      ::unlink(unix_path_.sun_path);
+    unix_path_ = {};
+  }
+
+  /**
+   * @brief 用一次 recvmmsg 读取数据报并逐个推送到 Parser
+   *
+   * @param wait 为 true 时阻塞直到至少收到一个数据报
+   * @return 读取的数据报数（无数据且不等待时为 0）
+   */
+  tl::expected<size_t, Error> receive(bool wait = false) {
+    const int flags = wait ? MSG_WAITFORONE : MSG_DONTWAIT;
+    int n;
+    do {
+      n = ::recvmmsg(fd_, msgs_.data(), Batch, flags, nullptr);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return size_t{0};
+      return detail::errno_error("recvmmsg");
+    }
+
+    for (int i = 0; i < n; ++i) {
+      if (msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) {
+        ++truncated_;
+        continue;
+      }
+      (void)parser_.push_data(frames_[i].data(), msgs_[i].msg_len);
+    }
+    datagrams_ += static_cast<uint64_t>(n);
+    return static_cast<size_t>(n);
+  }
+
+  /// @brief 套接字描述符（可加入 epoll）
+  [[nodiscard]] int fd() const noexcept { return fd_; }
+
+  /// @brief 累计收到的数据报数
+  [[nodiscard]] uint64_t datagrams() const noexcept { return datagrams_; }
+
+  /// @brief 因超过 MaxFrameSize 被截断而丢弃的数据报数
+  [[nodiscard]] uint64_t truncated() const noexcept { return truncated_; }
+
+private:
+  tl::unexpected<Error> fail(const char *what) {
+    auto err = detail::errno_error(what);
+    close();
+    return err;
+  }
+
+  ParserType &parser_;
+  int fd_ = -1;
+  sockaddr_un unix_path_{};
+
+  std::array<std::array<uint8_t, MaxFrameSize>, Batch> frames_{};
+  std::array<iovec, Batch> iov_{};
+  std::array<mmsghdr, Batch> msgs_{};
+
+  uint64_t datagrams_ = 0;
+  uint64_t truncated_ = 0;
+};
+
+} // namespace RPL::Linux
+
+#endif // RPL_LINUX_DATAGRAM_BRIDGE_HPP
@@ -0,0 +1,574 @@
+/**
+ * @file Gateway.hpp
+ * @brief RPL 多链路网关运行时：每核一个工作线程，链路级工作窃取
+ *
+ * 此文件提供 Gateway，统一驱动大量串口 / pty / 套接字链路的 Parser：
+ * 每条链路固定归属一个绑核的工作线程，突发流量的链路可被空闲线程窃取。
+ *
+ * @par 设计原理
+ * - 链路是调度单位：Parser 非线程安全，同一时刻只有一个工作线程处理一条链路
+ *   （EPOLLONESHOT 保证），链路内的字节与帧顺序不变
+ * - 每个工作线程一个 epoll，只监听归属于自己的链路；就绪链路进入本线程的运行队列
+ * - 一轮最多 read() budget 次；读完（EAGAIN）重新挂回 epoll，
+ *   未读完的链路放回运行队列尾部，空闲线程从其它线程的运行队列尾部窃取；
+ *   每轮之后不阻塞地收取新就绪的链路，持续有数据的链路不会饿死同线程的其它链路
+ * - LinkMode::Local：Parser 在工作线程中直接写入自己的 Deserializer
+ * - LinkMode::Shared：通过原始帧回调把负载拷贝到当前工作线程的帧队列
+ *   （单生产者 / 单消费者，每次 read() 处理完提交一次），
+ *   由 publish() 在单一线程中交给该链路 Parser 的 dispatch()，
+ *   after_parse、子包分发与 PacketHook 都在 publish() 的线程中执行；
+ *   记录带链路内序号，跨队列发布时保持同一链路的帧顺序
+ * - eventfd / epoll / fcntl 失败时的错误见 SysError.hpp
+ *
+ * @par 使用场景
+ * - 雷达 / 裁判系统网关同时接入多台机器人、图传接收端与裁判系统串口
+ *
+ * @warning add_link() 只能在 start() 之前调用；Gateway 不关闭链路描述符。
+ *          publish() 须始终在同一线程中调用
+ *
+ * @code
+ * RPL::Deserializer<RobotPos> des;
+ * RPL::Parser<RobotPos> p0{des}, p1{des};
+ * RPL::Linux::Gateway<> gw;
+ * gw.add_link(uart0_fd, p0, RPL::Linux::LinkMode::Shared);
+ * gw.add_link(uart1_fd, p1, RPL::Linux::LinkMode::Shared);
+ * gw.start(); // 默认每个可用 CPU 一个工作线程
+ * while (running)
+ *     gw.publish();
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_LINUX_GATEWAY_HPP
+#define RPL_LINUX_GATEWAY_HPP
+
+#ifndef __linux__
+#error "RPL/Linux/Gateway.hpp requires Linux"
+#endif
+
+#include "RPL/Linux/SysError.hpp"
+#include "RPL/Parser.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <span>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <tl/expected.hpp>
+#include <unistd.h>
+#include <vector>
+
+namespace RPL::Linux {
+
+/// @brief 链路的发布方式
+enum class LinkMode : uint8_t {
+  Local,  ///< Parser 在工作线程中直接写入自己的 Deserializer
+  Shared, ///< 帧进入工作线程的帧队列，由 publish() 分发到共享 Deserializer
+};
+
+/// @brief 链路统计快照
+struct GatewayLinkStats {
+  uint64_t bytes = 0;   ///< 读取的字节数
+  uint64_t frames = 0;  ///< 通过校验的帧数
+  uint64_t dropped = 0; ///< 帧队列已满 / 负载过长 / 接收缓冲区溢出丢弃的次数
+  bool open = false;    ///< 链路是否仍可读（EOF 或读错误后为 false）
+};
+
+/**
+ * @brief 多链路网关运行时
+ *
+ * @tparam MaxLinks 最大链路数
+ * @tparam QueueDepth 每个工作线程的帧队列深度（2 的幂）
+ * @tparam MaxPayload Shared 链路单帧负载上限
+ */
+template <size_t MaxLinks = 32, size_t QueueDepth = 256,
+          size_t MaxPayload = 256>
+class Gateway {
+  static_assert(MaxLinks > 0 && MaxLinks < 0xFFFF, "MaxLinks out of range");
+  static_assert(QueueDepth > 0 && (QueueDepth & (QueueDepth - 1)) == 0,
+                "QueueDepth must be a power of 2");
+
+public:
+  /// @brief 单次 read() 的字节数
+  static constexpr size_t read_chunk = 4096;
+
+  Gateway() = default;
+  ~Gateway() { stop(); }
+
+  Gateway(const Gateway &) = delete;
+  Gateway &operator=(const Gateway &) = delete;
+
+  /**
+   * @brief 接入一条链路（描述符被设为非阻塞）
+   *
+   * @note 接管 Parser 的原始帧回调；已设置的回调（如 FrameRelay、LinkMerger）
+   *       被保留，在工作线程中先于 Gateway 调用，返回 false 的帧不再发布。
+   *       这类回调须在 add_link() 之前设置
+   *
+   * @param fd 可读描述符（串口、pty、管道、套接字）
+   * @param parser 该链路的 Parser（须使用内部缓冲区）
+   * @param mode 发布方式
+   * @return 链路编号
+   */
+  template <typename ParserType>
+  tl::expected<size_t, Error> add_link(int fd, ParserType &parser,
+                                       LinkMode mode = LinkMode::Local) {
+    if (running_.load(std::memory_order_relaxed))
+      return tl::unexpected(
+          Error{ErrorCode::InternalError, "Gateway is running"});
+    if (link_count_ == MaxLinks)
+      return tl::unexpected(
+          Error{ErrorCode::BufferOverflow, "Too many links"});
+
+    const int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+      return detail::errno_error("fcntl");
+
+    const size_t id = link_count_++;
+    Link &link = links_[id];
+    link.self = this;
+    link.fd = fd;
+    link.id = static_cast<uint16_t>(id);
+    link.mode = mode;
+    link.parser = &parser;
+    link.feed = &Gateway::feed<ParserType>;
+    link.dispatch = &Gateway::dispatch<ParserType>;
+    link.next = parser.frame_hook();
+    parser.set_frame_hook(FrameHook{&link, &Gateway::on_frame});
+    return id;
+  }
+
+  /**
+   * @brief 启动工作线程
+   *
+   * 链路按编号轮流归属各工作线程；重新启动时丢弃上次未发布的帧。
+   *
+   * @param workers 工作线程数（0 表示可用 CPU 数）
+   * @param pin 是否把第 i 个工作线程绑定到第 i 个可用 CPU
+   */
+  tl::expected<void, Error> start(size_t workers = 0, bool pin = true) {
+    if (running_.load(std::memory_order_relaxed))
+      return {};
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    std::vector<int> cpus;
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+      for (int c = 0; c < CPU_SETSIZE; ++c)
+        if (CPU_ISSET(c, &allowed))
+          cpus.push_back(c);
+    }
+    if (workers == 0)
+      workers = std::max<size_t>(cpus.size(), 1);
+
+    workers_.clear();
+    stop_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    kick_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stop_fd_ < 0 || kick_fd_ < 0)
+      return fail("eventfd");
+
+    for (size_t i = 0; i < workers; ++i) {
+      auto w = std::make_unique<Worker>();
+      w->index = i;
+      w->epfd = ::epoll_create1(EPOLL_CLOEXEC);
+      workers_.push_back(std::move(w));
+      if (workers_.back()->epfd < 0)
+        return fail("epoll_create1");
+      if (!watch(*workers_.back(), stop_fd_, stop_token, EPOLLIN) ||
+          !watch(*workers_.back(), kick_fd_, kick_token, EPOLLIN))
+        return fail("epoll_ctl");
+    }
+
+    for (size_t i = 0; i < link_count_; ++i) {
+      Link &link = links_[i];
+      link.home = i % workers;
+      link.seq = 0;
+      link.open.store(true, std::memory_order_relaxed);
+      next_seq_[i] = 0;
+      if (!watch(*workers_[link.home], link.fd, static_cast<uint32_t>(i),
+                 EPOLLIN | EPOLLONESHOT))
+        return fail("epoll_ctl");
+    }
+
+    queued_.store(0, std::memory_order_relaxed);
+    idle_.store(0, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+    for (auto &w : workers_) {
+      Worker *worker = w.get();
+      worker->thread = std::thread([this, worker] { run(*worker); });
+      if (pin && !cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[worker->index % cpus.size()], &set);
+        if (const int rc = ::pthread_setaffinity_np(
+                worker->thread.native_handle(), sizeof(set), &set);
+            rc != 0) {
+          errno = rc;
+          return fail("pthread_setaffinity_np");
+        }
+      }
+    }
+    return {};
+  }
+
+  /**
+   * @brief 停止并回收工作线程
+   *
+   * 帧队列保留到下次 start()，停止后仍可调用 publish() 发布剩余的帧。
+   */
+  void stop() {
+    running_.store(false, std::memory_order_release);
+    if (stop_fd_ >= 0) {
+      const uint64_t one = 1;
+      (void)!::write(stop_fd_, &one, sizeof(one));
+    }
+    for (auto &w : workers_) {
+      if (w->thread.joinable())
+        w->thread.join();
+      if (w->epfd >= 0)
+        ::close(w->epfd);
+      w->epfd = -1;
+    }
+    for (int *fd : {&stop_fd_, &kick_fd_}) {
+      if (*fd >= 0)
+        ::close(*fd);
+      *fd = -1;
+    }
+  }
+
+  /**
+   * @brief 把各工作线程帧队列中的帧交给所属链路的 Parser 分发
+   *
+   * 与 Local 链路一样执行 after_parse、子包分发与 PacketHook，
+   * 并写入该 Parser 的 Deserializer。
+   * 同一链路的帧按接收顺序分发；某链路更早的帧尚未出现在其它队列时，
+   * 该队列本次停在此处，留待下次调用。
+   *
+   * @return 本次分发的帧数
+   */
+  size_t publish() {
+    size_t total = 0;
+    for (bool progress = true; progress;) {
+      progress = false;
+      for (auto &w : workers_) {
+        size_t head = w->head.load(std::memory_order_relaxed);
+        const size_t tail = w->tail.load(std::memory_order_acquire);
+        while (head != tail) {
+          const Record &r = w->records[head & (QueueDepth - 1)];
+          if (r.seq != next_seq_[r.link])
+            break;
+          const Link &link = links_[r.link];
+          link.dispatch(link.parser, r.cmd, {r.payload.data(), r.len});
+          ++next_seq_[r.link];
+          ++head;
+          ++total;
+          progress = true;
+        }
+        w->head.store(head, std::memory_order_release);
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief 设置每轮处理一条链路时最多 read() 的次数
+   *
+   * 较小的值让突发链路更早让出线程、被其它线程窃取；须在 start() 之前调用。
+   */
+  void set_budget(size_t reads) noexcept { budget_ = std::max<size_t>(reads, 1); }
+
+  /// @brief 链路统计快照
+  [[nodiscard]] GatewayLinkStats link_stats(size_t id) const noexcept {
+    const Link &link = links_[id];
+    return {link.bytes.load(std::memory_order_relaxed),
+            link.frames.load(std::memory_order_relaxed),
+            link.dropped.load(std::memory_order_relaxed),
+            link.open.load(std::memory_order_acquire)};
+  }
+
+  /// @brief 所有工作线程的窃取次数之和
+  [[nodiscard]] uint64_t steals() const noexcept {
+    uint64_t n = 0;
+    for (const auto &w : workers_)
+      n += w->steals.load(std::memory_order_relaxed);
+    return n;
+  }
+
+  [[nodiscard]] bool running() const noexcept {
+    return running_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] size_t link_count() const noexcept { return link_count_; }
+
+  [[nodiscard]] size_t worker_count() const noexcept { return workers_.size(); }
+
+private:
+  static constexpr uint32_t stop_token = 0xFFFFFFFF;
+  static constexpr uint32_t kick_token = 0xFFFFFFFE;
+
+  struct Record {
+    uint16_t link;
+    uint16_t cmd;
+    uint16_t len;
+    uint32_t seq; ///< 链路内序号
+    std::array<uint8_t, MaxPayload> payload;
+  };
+
+  struct alignas(64) Worker {
+    size_t index = 0;
+    int epfd = -1;
+    std::thread thread;
+
+    // 运行队列：每条链路至多出现一次
+    std::mutex mutex;
+    std::array<uint16_t, MaxLinks> run{};
+    size_t run_head = 0;
+    size_t run_count = 0;
+    std::atomic<uint64_t> steals{0};
+
+    // 帧队列：生产者为本线程，消费者为 publish()
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t local_tail = 0;
+    size_t cached_head = 0;
+    alignas(64) std::atomic<size_t> head{0};
+    std::array<Record, QueueDepth> records{};
+
+    std::array<uint8_t, read_chunk> rx{};
+  };
+
+  struct Link {
+    Gateway *self = nullptr;
+    int fd = -1;
+    uint16_t id = 0;
+    LinkMode mode = LinkMode::Local;
+    size_t home = 0;
+    void *parser = nullptr;
+    bool (*feed)(void *parser, const uint8_t *data, size_t len) = nullptr;
+    void (*dispatch)(void *parser, uint16_t cmd,
+                     std::span<const uint8_t> payload) = nullptr;
+    FrameHook next{}; ///< 接入前 Parser 上已有的原始帧回调
+
+    // 以下只由当前处理该链路的线程写入
+    Worker *worker = nullptr;
+    uint32_t seq = 0;
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> open{false};
+  };
+
+  /// @brief 单写者计数器递增（写者随链路转移，但同一时刻只有一个）
+  static void bump(std::atomic<uint64_t> &counter, uint64_t n = 1) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  /// @brief 按 Parser 的连续可写区域分段提交，一次 read() 可以超过接收缓冲区
+  template <typename ParserType>
+  static bool feed(void *p, const uint8_t *data, size_t len) {
+    auto &parser = *static_cast<ParserType *>(p);
+    while (len > 0) {
+      const auto span = parser.get_write_buffer();
+      const size_t n = std::min(len, span.size());
+      if (n == 0)
+        return false;
+      std::memcpy(span.data(), data, n);
+      (void)parser.advance_write_index(n);
+      data += n;
+      len -= n;
+    }
+    return true;
+  }
+
+  /// @brief 只读取 Parser 的回调与 Deserializer，可与工作线程中的解析并发
+  template <typename ParserType>
+  static void dispatch(void *p, uint16_t cmd,
+                       std::span<const uint8_t> payload) {
+    static_cast<ParserType *>(p)->dispatch(cmd, payload);
+  }
+
+  static bool on_frame(void *ctx, const RawFrame &frame) {
+    Link &link = *static_cast<Link *>(ctx);
+    bump(link.frames);
+    if (link.next.fn && !link.next.fn(link.next.ctx, frame))
+      return false;
+    if (link.mode == LinkMode::Local)
+      return true;
+    if (link.self->enqueue(*link.worker, link, frame))
+      ++link.seq;
+    else
+      bump(link.dropped);
+    return false;
+  }
+
+  bool enqueue(Worker &w, const Link &link, const RawFrame &frame) noexcept {
+    const size_t len = frame.payload_size();
+    if (len > MaxPayload)
+      return false;
+    if (w.local_tail - w.cached_head == QueueDepth) {
+      w.cached_head = w.head.load(std::memory_order_acquire);
+      if (w.local_tail - w.cached_head == QueueDepth)
+        return false;
+    }
+    Record &r = w.records[w.local_tail & (QueueDepth - 1)];
+    r.link = link.id;
+    r.cmd = frame.cmd;
+    r.len = static_cast<uint16_t>(len);
+    r.seq = link.seq;
+    std::memcpy(r.payload.data(), frame.payload_s1.data(),
+                frame.payload_s1.size());
+    std::memcpy(r.payload.data() + frame.payload_s1.size(),
+                frame.payload_s2.data(), frame.payload_s2.size());
+    ++w.local_tail;
+    return true;
+  }
+
+  void run(Worker &w) {
+    std::array<epoll_event, 64> events{};
+    while (running_.load(std::memory_order_acquire)) {
+      uint16_t id;
+      if (pop(w, id) || steal(w, id)) {
+        process(w, links_[id]);
+        // 未读完的链路会立即回到运行队列；每轮都收取新就绪的链路排在其后，
+        // 否则持续有数据的链路会让同一线程的其它链路饿死
+        dispatch(w, events.data(),
+                 ::epoll_wait(w.epfd, events.data(),
+                              static_cast<int>(events.size()), 0));
+        continue;
+      }
+
+      // 先登记空闲再检查运行队列：与 push() 的先入队再检查空闲配对，
+      // 两者至少有一方看到对方
+      idle_.fetch_add(1);
+      const int timeout = queued_.load() > 0 ? 0 : -1;
+      const int n = ::epoll_wait(w.epfd, events.data(),
+                                 static_cast<int>(events.size()), timeout);
+      idle_.fetch_sub(1);
+      dispatch(w, events.data(), n);
+    }
+  }
+
+  /// @brief 就绪链路进入运行队列；n 为 epoll_wait() 的返回值
+  void dispatch(Worker &w, const epoll_event *events, int n) {
+    for (int i = 0; i < n; ++i) {
+      const uint32_t token = events[i].data.u32;
+      if (token == kick_token) {
+        uint64_t value;
+        (void)!::read(kick_fd_, &value, sizeof(value));
+      } else if (token != stop_token) {
+        push(w, static_cast<uint16_t>(token));
+      }
+    }
+  }
+
+  void process(Worker &w, Link &link) {
+    link.worker = &w;
+    for (size_t i = 0; i < budget_; ++i) {
+      const ssize_t n = ::read(link.fd, w.rx.data(), w.rx.size());
+      if (n > 0) {
+        bump(link.bytes, static_cast<uint64_t>(n));
+        if (!link.feed(link.parser, w.rx.data(), static_cast<size_t>(n)))
+          bump(link.dropped);
+        // 每次 read() 提交一批，且在链路交给其它线程之前
+        w.tail.store(w.local_tail, std::memory_order_release);
+        continue;
+      }
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.u32 = link.id;
+        (void)::epoll_ctl(workers_[link.home]->epfd, EPOLL_CTL_MOD, link.fd,
+                          &ev);
+        return;
+      }
+      // EOF 或读错误：不再挂回 epoll
+      link.open.store(false, std::memory_order_release);
+      return;
+    }
+    push(w, link.id);
+  }
+
+  void push(Worker &w, uint16_t id) {
+    {
+      std::lock_guard lock(w.mutex);
+      w.run[(w.run_head + w.run_count) % MaxLinks] = id;
+      ++w.run_count;
+    }
+    queued_.fetch_add(1);
+    if (idle_.load() > 0) {
+      const uint64_t one = 1;
+      (void)!::write(kick_fd_, &one, sizeof(one));
+    }
+  }
+
+  bool pop(Worker &w, uint16_t &id) {
+    std::lock_guard lock(w.mutex);
+    if (w.run_count == 0)
+      return false;
+    id = w.run[w.run_head];
+    w.run_head = (w.run_head + 1) % MaxLinks;
+    --w.run_count;
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// @brief 从其它工作线程运行队列的尾部取一条链路
+  bool steal(Worker &w, uint16_t &id) {
+    if (queued_.load(std::memory_order_relaxed) == 0)
+      return false;
+    for (size_t k = 1; k < workers_.size(); ++k) {
+      Worker &victim = *workers_[(w.index + k) % workers_.size()];
+      std::unique_lock lock(victim.mutex, std::try_to_lock);
+      if (!lock || victim.run_count == 0)
+        continue;
+      --victim.run_count;
+      id = victim.run[(victim.run_head + victim.run_count) % MaxLinks];
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+      w.steals.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  static bool watch(Worker &w, int fd, uint32_t token, uint32_t events) {
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.u32 = token;
+    return ::epoll_ctl(w.epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+  }
+
+  tl::unexpected<Error> fail(const char *what) {
+    auto err = detail::errno_error(what);
+    stop();
+    return err;
+  }
+
+  std::array<Link, MaxLinks> links_{};
+  size_t link_count_ = 0;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::array<uint32_t, MaxLinks> next_seq_{}; ///< 仅 publish() 使用
+  size_t budget_ = 4;
+
+  int stop_fd_ = -1;
+  int kick_fd_ = -1;
+  std::atomic<bool> running_{false};
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> idle_{0};
+};
+
+} // namespace RPL::Linux
+
+#endif // RPL_LINUX_GATEWAY_HPP
@@ -0,0 +1,335 @@
+/**
+ * @file ShmStorage.hpp
+ * @brief 把 Deserializer 状态放进 POSIX 共享内存的存储策略
+ *
+ * 此文件提供 ShmStorage：Deserializer 的内存池、SeqLock 版本号与负载长度
+ * 放在 shm_open 或 memfd 共享内存段中。持有串口的解析进程是唯一的写者，
+ * 其他进程以只读方式映射同一段，直接调用 get<T>()，不经过任何系统调用或拷贝。
+ *
+ * @par 段布局
+ * ```
+ * | ShmHeader | ShmEntry × N | 填充 | DeserializerState |
+ * ```
+ * - ShmHeader 记录魔数、布局版本、ABI 标志、条目数与状态区偏移 / 大小
+ * - 每个 ShmEntry 描述一个数据包：命令码（子包为组合键）→ 槽位偏移、
+ *   线格式大小、版本号下标；读者 attach 时逐项与自己的数据包集合比对
+ * - 魔数最后写入（release），读者看到魔数即说明段已初始化完毕
+ *
+ * @par 设计原理
+ * - 写者在段上持有 flock 排他锁，第二个写者 create() 失败；
+ *   写者进程退出后锁自动释放，残留的段可以被新的写者重新初始化
+ * - 读者的映射为 PROT_READ，任何写入都会触发 SIGSEGV 而不是静默破坏数据；
+ *   定义了 before_get_custom 的数据包在副本上处理
+ * - 未 create / attach 时使用进程内的私有状态，行为与默认存储策略一致
+ * - 跨进程 SeqLock 建议定义 RPL_USE_STD_ATOMIC（std::atomic<uint32_t> 无锁且
+ *   与地址无关）；ABI 标志不同的读写者无法互相 attach
+ *
+ * @par 使用场景
+ * - 上位机上高频读取裁判系统状态的多个进程
+ *
+ * @code
+ * using Des = RPL::Deserializer<RPL::Linux::ShmStorage, GameStatus, RobotStatus>;
+ *
+ * // 写者（解析进程）
+ * Des des;
+ * des.storage().create("/rpl_referee");
+ * RPL::Parser<RPL::Linux::ShmStorage, GameStatus, RobotStatus> parser{des};
+ *
+ * // 读者进程
+ * Des reader;
+ * reader.storage().attach("/rpl_referee");
+ * auto status = reader.get<GameStatus>();
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_LINUX_SHM_STORAGE_HPP
+#define RPL_LINUX_SHM_STORAGE_HPP
+
+#ifndef __linux__
+#error "RPL/Linux/ShmStorage.hpp requires Linux"
+#endif
+
+#include "RPL/Deserializer.hpp"
+#include "RPL/Linux/SysError.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tl/expected.hpp>
+#include <unistd.h>
+
+namespace RPL::Linux {
+
+/// @brief 共享内存段头
+struct ShmHeader {
+  static constexpr uint32_t magic_value = 0x53'4C'50'52; ///< "RPLS"
+  static constexpr uint16_t layout_version = 1;
+
+  uint32_t magic;          ///< 初始化完成后写入 magic_value
+  uint16_t version;        ///< layout_version
+  uint16_t entry_count;    ///< 数据包类型数
+  uint32_t abi;            ///< sizeof(size_t) | 原子版本号标志
+  uint32_t state_offset;   ///< DeserializerState 相对段首的偏移
+  uint32_t state_size;     ///< sizeof(DeserializerState)
+  uint32_t pool_size;      ///< 内存池字节数
+  int32_t writer_pid;      ///< 写者进程号
+};
+
+/// @brief 段头中描述一个数据包的条目
+struct ShmEntry {
+  uint32_t key;       ///< 命令码（子包为 Meta::packet_key 组合键）
+  uint32_t offset;    ///< 槽位在内存池中的偏移
+  uint32_t size;      ///< 线格式最大长度
+  uint32_t seq_index; ///< 版本号下标
+};
+
+/**
+ * @brief POSIX 共享内存存储策略
+ *
+ * 作为 Deserializer / Parser 的第一个模板参数使用，
+ * 通过 Deserializer::storage() 调用 create / attach。
+ */
+struct ShmStorage {
+  static constexpr bool is_deserializer_storage = true;
+
+#ifdef RPL_USE_STD_ATOMIC
+  static constexpr uint32_t abi_flags = sizeof(size_t) | 0x100;
+#else
+  static constexpr uint32_t abi_flags = sizeof(size_t);
+#endif
+
+  /// @brief 删除命名共享内存段（已映射的进程不受影响）
+  static void unlink(const char *name) noexcept { ::shm_unlink(name); }
+
+  template <typename State, typename Collector> class Holder {
+    static constexpr size_t entry_count = Collector::packet_sizes.size();
+    static constexpr size_t state_offset =
+        Meta::align_up(sizeof(ShmHeader) + entry_count * sizeof(ShmEntry),
+                       std::max(alignof(State), size_t{64}));
+    static constexpr size_t segment_size = state_offset + sizeof(State);
+
+  public:
+    Holder() = default;
+    ~Holder() { detach(); }
+
+    Holder(const Holder &) = delete;
+    Holder &operator=(const Holder &) = delete;
+
+    State &state() noexcept { return *state_; }
+    const State &state() const noexcept { return *state_; }
+
+    /// @brief 状态是否可写（只读映射的读者为 false）
+    [[nodiscard]] bool writable() const noexcept { return writable_; }
+
+    /// @brief 是否已映射共享内存段
+    [[nodiscard]] bool attached() const noexcept { return map_ != nullptr; }
+
+    /// @brief 共享内存段大小
+    static constexpr size_t size() noexcept { return segment_size; }
+
+    /**
+     * @brief 以写者身份创建（或接管残留的）命名共享内存段
+     *
+     * @param name shm_open 名称（如 "/rpl_referee"）
+     * @return 已有其他写者时返回 IoError
+     */
+    tl::expected<void, Error> create(const char *name) {
+      detach();
+      const int fd = ::shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+      if (fd < 0)
+        return detail::errno_error("shm_open");
+      return init_writer(fd);
+    }
+
+    /**
+     * @brief 以写者身份创建匿名 memfd 段
+     *
+     * 读者通过 fork 继承或 SCM_RIGHTS 传递 fd() 后调用 attach_fd()。
+     *
+     * @param name memfd 名称（仅用于调试）
+     */
+    tl::expected<void, Error> create_memfd(const char *name) {
+      detach();
+      const int fd =
+          ::memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+      if (fd < 0)
+        return detail::errno_error("memfd_create");
+      if (auto r = init_writer(fd); !r)
+        return r;
+      (void)::fcntl(fd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW);
+      return {};
+    }
+
+    /**
+     * @brief 以读者身份只读映射命名共享内存段
+     *
+     * @return 段不存在或尚未初始化返回 Again；布局不一致返回 LayoutMismatch
+     */
+    tl::expected<void, Error> attach(const char *name) {
+      detach();
+      const int fd = ::shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+      if (fd < 0) {
+        if (errno == ENOENT)
+          return tl::unexpected(Error{ErrorCode::Again, "No such segment"});
+        return detail::errno_error("shm_open");
+      }
+      auto r = map_reader(fd);
+      ::close(fd);
+      return r;
+    }
+
+    /**
+     * @brief 以读者身份只读映射 memfd（或任何共享内存 fd）
+     *
+     * @param fd 文件描述符（调用方保留所有权）
+     */
+    tl::expected<void, Error> attach_fd(int fd) {
+      detach();
+      return map_reader(fd);
+    }
+
+    /// @brief 解除映射，回到进程内私有状态
+    void detach() noexcept {
+      if (map_)
+        ::munmap(map_, segment_size);
+      if (fd_ >= 0)
+        ::close(fd_); // 同时释放写者锁
+      map_ = nullptr;
+      fd_ = -1;
+      state_ = &local_;
+      writable_ = true;
+    }
+
+    /// @brief 写者持有的段描述符（读者为 -1）
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+
+    /// @brief 段头（未映射时为 nullptr）
+    [[nodiscard]] const ShmHeader *header() const noexcept {
+      return static_cast<const ShmHeader *>(map_);
+    }
+
+  private:
+    tl::expected<void, Error> init_writer(int fd) {
+      if (::flock(fd, LOCK_EX | LOCK_NB) < 0) {
+        auto err = errno == EWOULDBLOCK
+                       ? tl::unexpected(Error{ErrorCode::IoError,
+                                              "Segment already has a writer"})
+                       : detail::errno_error("flock");
+        ::close(fd);
+        return err;
+      }
+      if (::ftruncate(fd, static_cast<off_t>(segment_size)) < 0) {
+        auto err = detail::errno_error("ftruncate");
+        ::close(fd);
+        return err;
+      }
+      void *map = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, 0);
+      if (map == MAP_FAILED) {
+        auto err = detail::errno_error("mmap");
+        ::close(fd);
+        return err;
+      }
+
+      auto *base = static_cast<uint8_t *>(map);
+      auto *hdr = reinterpret_cast<ShmHeader *>(base);
+      // 接管残留段时先使旧魔数失效，读者在重新初始化期间 attach 会失败
+      std::atomic_ref<uint32_t>(hdr->magic).store(0, std::memory_order_relaxed);
+      hdr->version = ShmHeader::layout_version;
+      hdr->entry_count = static_cast<uint16_t>(entry_count);
+      hdr->abi = abi_flags;
+      hdr->state_offset = static_cast<uint32_t>(state_offset);
+      hdr->state_size = static_cast<uint32_t>(sizeof(State));
+      hdr->pool_size = static_cast<uint32_t>(Collector::totalSize);
+      hdr->writer_pid = static_cast<int32_t>(::getpid());
+      const auto entries = expected_entries();
+      std::memcpy(base + sizeof(ShmHeader), entries.data(),
+                  sizeof(ShmEntry) * entry_count);
+      state_ = new (base + state_offset) State{};
+      std::atomic_ref<uint32_t>(hdr->magic).store(ShmHeader::magic_value,
+                                                  std::memory_order_release);
+
+      map_ = map;
+      fd_ = fd;
+      writable_ = true;
+      return {};
+    }
+
+    tl::expected<void, Error> map_reader(int fd) {
+      struct stat st{};
+      if (::fstat(fd, &st) < 0)
+        return detail::errno_error("fstat");
+      if (st.st_size < static_cast<off_t>(sizeof(ShmHeader)))
+        return tl::unexpected(Error{ErrorCode::Again, "Segment not ready"});
+      if (st.st_size != static_cast<off_t>(segment_size))
+        return tl::unexpected(
+            Error{ErrorCode::LayoutMismatch, "Segment size mismatch"});
+      void *map = ::mmap(nullptr, segment_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (map == MAP_FAILED)
+        return detail::errno_error("mmap");
+      if (auto r = validate(static_cast<const uint8_t *>(map)); !r) {
+        ::munmap(map, segment_size);
+        return r;
+      }
+      map_ = map;
+      // 读者只通过 SeqLock 读路径访问状态
+      state_ = reinterpret_cast<State *>(static_cast<uint8_t *>(map) +
+                                         state_offset);
+      writable_ = false;
+      return {};
+    }
+
+    static tl::expected<void, Error> validate(const uint8_t *base) {
+      const auto *hdr = reinterpret_cast<const ShmHeader *>(base);
+      const uint32_t magic =
+          std::atomic_ref<uint32_t>(const_cast<uint32_t &>(hdr->magic))
+              .load(std::memory_order_acquire);
+      if (magic != ShmHeader::magic_value)
+        return tl::unexpected(Error{ErrorCode::Again, "Segment not ready"});
+      if (hdr->version != ShmHeader::layout_version || hdr->abi != abi_flags ||
+          hdr->entry_count != entry_count ||
+          hdr->state_offset != state_offset ||
+          hdr->state_size != sizeof(State) ||
+          hdr->pool_size != Collector::totalSize)
+        return tl::unexpected(
+            Error{ErrorCode::LayoutMismatch, "Segment header mismatch"});
+      const auto entries = expected_entries();
+      if (std::memcmp(base + sizeof(ShmHeader), entries.data(),
+                      sizeof(ShmEntry) * entry_count) != 0)
+        return tl::unexpected(
+            Error{ErrorCode::LayoutMismatch, "Packet layout mismatch"});
+      return {};
+    }
+
+    /// @brief 按版本号下标排列的本进程数据包布局
+    static constexpr std::array<ShmEntry, entry_count> expected_entries() {
+      std::array<ShmEntry, entry_count> entries{};
+      for (const auto &[key, offset] : Collector::cmdToIndex) {
+        const size_t seq = Collector::cmd_seq_index(key);
+        entries[seq] = ShmEntry{key, static_cast<uint32_t>(offset),
+                                static_cast<uint32_t>(Collector::packet_sizes[seq]),
+                                static_cast<uint32_t>(seq)};
+      }
+      return entries;
+    }
+
+    State local_{};
+    State *state_ = &local_;
+    void *map_ = nullptr;
+    int fd_ = -1;
+    bool writable_ = true;
+  };
+};
+
+} // namespace RPL::Linux
+
+#endif // RPL_LINUX_SHM_STORAGE_HPP
@@ -0,0 +1,30 @@
+/**
+ * @file SysError.hpp
+ * @brief RPL Linux 传输层共用的系统调用错误转换
+ *
+ * RPL/Linux 下的组件在系统调用失败时统一返回 ErrorCode::IoError，
+ * message 为 "<调用名>: <strerror 文本>"。
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_LINUX_SYS_ERROR_HPP
+#define RPL_LINUX_SYS_ERROR_HPP
+
+#include "RPL/Utils/Error.hpp"
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <tl/expected.hpp>
+
+namespace RPL::Linux::detail {
+
+/// @brief 把当前 errno 转换为 ErrorCode::IoError
+inline tl::unexpected<Error> errno_error(const char *what) {
+  return tl::unexpected(
+      Error{ErrorCode::IoError, std::string(what) + ": " + std::strerror(errno)});
+}
+
+} // namespace RPL::Linux::detail
+
+#endif // RPL_LINUX_SYS_ERROR_HPP
@@ -0,0 +1,225 @@
+/**
+ * @file BitView.hpp
+ * @brief RPL 位域原地访问视图
+ *
+ * 此文件提供 BitView / BitRef，用于直接在线格式字节上按字段读写位域，
+ * 无需通过 deserialize_bitstream 构造完整结构体。
+ *
+ * @par 设计原理
+ * - 字段位偏移与位宽由 BitLayoutInfo 在编译期确定
+ * - 每次访问只触及该字段覆盖的字节，解码开销与访问字段数成正比
+ * - BitRef 写入前先清零目标位，可在已有帧上原地修改单个字段
+ *
+ * @par 使用场景
+ * - after_parse 回调中只关心少数字段（如遥控器按键）
+ * - 直接读取 Deserializer 内存池中的位流数据
+ * - 原地构建/修改待发送帧的负载
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_BIT_VIEW_HPP
+#define RPL_BIT_VIEW_HPP
+
+#include "RPL/Meta/BitstreamParser.hpp"
+#include "RPL/Meta/BitstreamSerializer.hpp"
+#include "RPL/Meta/BitstreamTraits.hpp"
+#include "RPL/Meta/PacketTraits.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+namespace RPL::Detail {
+
+/**
+ * @brief 清零字节序列中指定的位区间
+ *
+ * 与 inject_bits 配合使用：inject_bits 采用 OR 注入，
+ * 原地修改字段前必须先清除旧值。
+ *
+ * @tparam BitOffset 起始位索引 (0 是第一个字节的 LSB)
+ * @tparam BitWidth 要清除的位数
+ * @param buffer 要修改的字节序列
+ */
+template <std::size_t BitOffset, std::size_t BitWidth>
+constexpr void clear_bits(std::span<uint8_t> buffer) {
+  std::size_t current_bit_offset = BitOffset;
+  std::size_t bits_cleared = 0;
+
+  while (bits_cleared < BitWidth) {
+    std::size_t byte_index = current_bit_offset / 8;
+    std::size_t bit_in_byte = current_bit_offset % 8;
+    std::size_t bits_to_clear = std::min(
+        BitWidth - bits_cleared, static_cast<std::size_t>(8 - bit_in_byte));
+
+    if (byte_index >= buffer.size()) {
+      break;
+    }
+
+    const auto mask =
+        static_cast<uint8_t>(((1U << bits_to_clear) - 1) << bit_in_byte);
+    buffer[byte_index] &= static_cast<uint8_t>(~mask);
+
+    bits_cleared += bits_to_clear;
+    current_bit_offset += bits_to_clear;
+  }
+}
+
+} // namespace RPL::Detail
+
+namespace RPL {
+
+/**
+ * @brief 只读位域视图
+ *
+ * 包装一段线格式字节，按 BitLayout 字段索引提供类型化访问。
+ * 视图不拥有数据，调用者需保证底层字节在视图使用期间有效。
+ *
+ * @tparam T 数据包类型（必须定义 BitLayout）
+ *
+ * @par 使用示例
+ * @code
+ * RPL::BitView<VT03RemotePacket> view{payload};
+ * if (view.get<9>()) {   // trigger
+ *     fire();
+ * }
+ * @endcode
+ */
+template <typename T>
+  requires Meta::HasBitLayout<Meta::PacketTraits<T>>
+class BitView {
+public:
+  using Info = Meta::BitLayoutInfo<typename Meta::PacketTraits<T>::BitLayout>;
+
+  /// @brief BitLayout 中的字段数量
+  static constexpr std::size_t field_count = Info::field_count;
+
+  constexpr BitView() noexcept = default;
+
+  /**
+   * @brief 构造视图
+   * @param bytes 线格式字节（长度应不小于 PacketTraits<T>::size）
+   */
+  constexpr explicit BitView(std::span<const uint8_t> bytes) noexcept
+      : bytes_(bytes) {}
+
+  /**
+   * @brief 读取第 I 个字段
+   *
+   * @tparam I BitLayout 字段索引
+   * @return 字段值，类型为对应 Field 的基础类型
+   */
+  template <std::size_t I>
+    requires(I < field_count)
+  [[nodiscard]] constexpr typename Info::template field_type<I>
+  get() const noexcept {
+    return Detail::extract_bits<typename Info::template field_type<I>,
+                                Info::template bit_offset<I>,
+                                Info::template bit_width<I>>(bytes_);
+  }
+
+  /**
+   * @brief 解码为完整结构体
+   * @return 等价于 deserialize_bitstream<T>(bytes())
+   */
+  [[nodiscard]] constexpr T decode() const {
+    return deserialize_bitstream<T>(bytes_);
+  }
+
+  /// @brief 获取底层字节
+  [[nodiscard]] constexpr std::span<const uint8_t> bytes() const noexcept {
+    return bytes_;
+  }
+
+private:
+  std::span<const uint8_t> bytes_{};
+};
+
+/**
+ * @brief 可写位域引用
+ *
+ * 在 BitView 的基础上提供按字段原地写入，用于直接在发送缓冲区中
+ * 构建或修改位流负载。写入只修改目标字段覆盖的位，其余位保持不变。
+ *
+ * @tparam T 数据包类型（必须定义 BitLayout）
+ *
+ * @par 使用示例
+ * @code
+ * std::array<uint8_t, 17> payload{};
+ * RPL::BitRef<VT03RemotePacket> ref{payload};
+ * ref.set<9>(1);        // trigger
+ * ref.set<11>(-120);    // mouse_x
+ * @endcode
+ */
+template <typename T>
+  requires Meta::HasBitLayout<Meta::PacketTraits<T>>
+class BitRef {
+public:
+  using Info = Meta::BitLayoutInfo<typename Meta::PacketTraits<T>::BitLayout>;
+
+  static constexpr std::size_t field_count = Info::field_count;
+
+  constexpr BitRef() noexcept = default;
+
+  /**
+   * @brief 构造引用
+   * @param bytes 可写线格式字节（长度应不小于 PacketTraits<T>::size）
+   */
+  constexpr explicit BitRef(std::span<uint8_t> bytes) noexcept
+      : bytes_(bytes) {}
+
+  /// @brief 读取第 I 个字段
+  template <std::size_t I>
+    requires(I < field_count)
+  [[nodiscard]] constexpr typename Info::template field_type<I>
+  get() const noexcept {
+    return view().template get<I>();
+  }
+
+  /**
+   * @brief 写入第 I 个字段
+   *
+   * 先清除字段原有的位，再注入新值；超出位宽的高位被截断。
+   *
+   * @tparam I BitLayout 字段索引
+   * @param value 新值
+   */
+  template <std::size_t I>
+    requires(I < field_count)
+  constexpr void set(typename Info::template field_type<I> value) noexcept {
+    Detail::clear_bits<Info::template bit_offset<I>,
+                       Info::template bit_width<I>>(bytes_);
+    Detail::inject_bits<typename Info::template field_type<I>,
+                        Info::template bit_offset<I>,
+                        Info::template bit_width<I>>(bytes_, value);
+  }
+
+  /**
+   * @brief 用完整结构体覆盖全部字段
+   * @param packet 数据包对象
+   */
+  constexpr void encode(const T &packet) {
+    constexpr std::size_t size = Meta::PacketTraits<T>::size;
+    const std::size_t len = std::min(size, bytes_.size());
+    for (std::size_t i = 0; i < len; ++i)
+      bytes_[i] = 0;
+    serialize_bitstream<T>(bytes_.first(len), packet);
+  }
+
+  /// @brief 转换为只读视图
+  [[nodiscard]] constexpr BitView<T> view() const noexcept {
+    return BitView<T>{std::span<const uint8_t>(bytes_)};
+  }
+
+  /// @brief 获取底层字节
+  [[nodiscard]] constexpr std::span<uint8_t> bytes() const noexcept {
+    return bytes_;
+  }
+
+private:
+  std::span<uint8_t> bytes_{};
+};
+
+} // namespace RPL
+
+#endif // RPL_BIT_VIEW_HPP
@@ -21,6 +21,7 @@
 #include <array>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace RPL::Meta {
 
@@ -90,6 +91,42 @@ concept HasBitLayout = requires {
     typename Traits::BitLayout;
 };
 
+/**
+ * @brief 位布局的编译期元信息
+ *
+ * 在编译期计算每个字段的起始位偏移（前缀和），供按字段随机访问的
+ * BitView / BitRef 使用，运行时不产生任何查表开销。
+ *
+ * @tparam Layout 位布局定义（元组 Field 类型）
+ */
+template <typename Layout>
+struct BitLayoutInfo {
+    /// @brief 字段数量
+    static constexpr std::size_t field_count = std::tuple_size_v<Layout>;
+
+    /// @brief 每个字段的起始位偏移，最后一项为总位数
+    static constexpr auto offsets = []() {
+        std::array<std::size_t, field_count + 1> arr{0};
+        std::size_t current = 0;
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ((arr[Is + 1] = current += std::tuple_element_t<Is, Layout>::bits), ...);
+        }(std::make_index_sequence<field_count>{});
+        return arr;
+    }();
+
+    /// @brief 第 I 个字段的基础类型
+    template <std::size_t I>
+    using field_type = typename std::tuple_element_t<I, Layout>::type;
+
+    /// @brief 第 I 个字段的起始位偏移
+    template <std::size_t I>
+    static constexpr std::size_t bit_offset = offsets[I];
+
+    /// @brief 第 I 个字段占用的位数
+    template <std::size_t I>
+    static constexpr std::size_t bit_width = std::tuple_element_t<I, Layout>::bits;
+};
+
 } // namespace RPL::Meta
 
 #endif // RPL_BITSTREAM_TRAITS_HPP
@@ -0,0 +1,228 @@
+/**
+ * @file FrameTemplate.hpp
+ * @brief RPL 编译期帧头模板
+ *
+ * 此文件为每个数据包类型在编译期生成帧头模板、按序列号索引的 CRC8 表
+ * 以及帧头常量前缀之后的 CRC16 中间状态。
+ *
+ * @par 设计原理
+ * - 起始字节、长度、命令码对每个类型都是编译期常量，直接写入帧头模板
+ * - 帧头中唯一变化的字节是序列号，因此 CRC8 只有 256 种可能，编译期打表
+ * - 帧头常量前缀（序列号之前的字节）的 CRC16 中间状态在编译期算好，
+ *   运行时只需从序列号处继续计算
+ * - 变长包的长度字段在运行时确定，负载短于最大长度时退回运行时计算 CRC
+ *
+ * @par 使用场景
+ * - Serializer 的快速序列化路径
+ * - 编译期预构建的只读（ROM）帧
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_FRAME_TEMPLATE_HPP
+#define RPL_FRAME_TEMPLATE_HPP
+
+#include "RPL/Meta/PacketTraits.hpp"
+#include "RPL/Utils/Def.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace RPL::Meta {
+
+/**
+ * @brief 检查协议是否包含序列号字段
+ *
+ * 兼容未声明 has_seq_field 的自定义协议（视为无序列号）。
+ *
+ * @tparam Protocol 协议类型
+ */
+template <typename Protocol>
+inline constexpr bool protocol_has_seq = []() {
+  if constexpr (requires { Protocol::has_seq_field; }) {
+    return Protocol::has_seq_field;
+  } else {
+    return false;
+  }
+}();
+
+/**
+ * @brief 数据包类型的编译期帧模板
+ *
+ * @tparam T 数据包类型
+ *
+ * @code
+ * using FT = RPL::Meta::FrameTemplate<SampleA>;
+ * uint8_t frame[FT::frame_size];
+ * FT::write_header(frame, seq);
+ * @endcode
+ */
+template <typename T> struct FrameTemplate {
+  static_assert(!IsSubPacket<T>,
+                "Sub-packets have no frame of their own; use the Parent "
+                "template with serialize_sub()");
+
+  using Traits = PacketTraits<T>;
+  using Protocol = typename Traits::Protocol;
+
+  static constexpr size_t header_size = Protocol::header_size;
+  static constexpr size_t data_size = Traits::size;
+  static constexpr size_t tail_size = Protocol::tail_size;
+  static constexpr size_t frame_size = header_size + data_size + tail_size;
+
+  static constexpr bool has_seq = protocol_has_seq<Protocol>;
+
+  /// @brief 帧头开头不随序列号变化的字节数
+  static constexpr size_t const_prefix_size = []() {
+    size_t prefix = header_size;
+    if constexpr (has_seq) {
+      prefix = Protocol::seq_offset;
+      if constexpr (Protocol::has_header_crc) {
+        prefix = std::min(prefix, Protocol::header_crc_offset);
+      }
+    }
+    return prefix;
+  }();
+
+  /// @brief 帧头模板（序列号为 0；有序列号时 CRC8 位置留空，由 crc8_by_seq 填写）
+  static constexpr std::array<uint8_t, header_size> header = []() {
+    std::array<uint8_t, header_size> h{};
+    h[0] = Protocol::start_byte;
+    if constexpr (Protocol::has_second_byte) {
+      h[1] = Protocol::second_byte;
+    }
+    if constexpr (Protocol::has_length_field) {
+      const auto len = static_cast<uint16_t>(data_size);
+      h[Protocol::length_offset] = static_cast<uint8_t>(len & 0xFF);
+      if constexpr (Protocol::length_field_bytes == 2) {
+        h[Protocol::length_offset + 1] = static_cast<uint8_t>(len >> 8);
+      }
+    }
+    if constexpr (Protocol::has_cmd_field) {
+      constexpr uint16_t cmd = Traits::cmd;
+      h[Protocol::cmd_offset] = static_cast<uint8_t>(cmd & 0xFF);
+      if constexpr (Protocol::cmd_field_bytes == 2) {
+        h[Protocol::cmd_offset + 1] = static_cast<uint8_t>(cmd >> 8);
+      }
+    }
+    if constexpr (Protocol::has_header_crc && !has_seq) {
+      h[Protocol::header_crc_offset] =
+          ProtocolCRC8::calc(h.data(), Protocol::header_crc_offset);
+    }
+    return h;
+  }();
+
+  /// @brief 以序列号为下标的帧头 CRC8 表（无序列号或无帧头校验时为空）
+  static constexpr auto crc8_by_seq = []() {
+    constexpr size_t entries = (has_seq && Protocol::has_header_crc) ? 256 : 0;
+    std::array<uint8_t, entries> table{};
+    if constexpr (entries > 0) {
+      for (size_t seq = 0; seq < entries; ++seq) {
+        auto h = header;
+        h[Protocol::seq_offset] = static_cast<uint8_t>(seq);
+        table[seq] = ProtocolCRC8::calc(h.data(), Protocol::header_crc_offset);
+      }
+    }
+    return table;
+  }();
+
+  /// @brief 帧头常量前缀之后的整帧 CRC 中间状态
+  static constexpr auto crc_prefix_state = []() {
+    if constexpr (tail_size > 0) {
+      return Protocol::RPL_CRC::calc(header.data(), const_prefix_size);
+    } else {
+      return 0;
+    }
+  }();
+
+  /**
+   * @brief 写入帧头
+   *
+   * 拷贝帧头模板并填写序列号与对应的 CRC8。
+   *
+   * @param dst 帧起始地址
+   * @param seq 序列号（协议无序列号时忽略）
+   */
+  static constexpr void write_header(uint8_t *dst, uint8_t seq) noexcept {
+    for (size_t i = 0; i < header_size; ++i)
+      dst[i] = header[i];
+    if constexpr (has_seq) {
+      dst[Protocol::seq_offset] = seq;
+      if constexpr (Protocol::has_header_crc) {
+        dst[Protocol::header_crc_offset] = crc8_by_seq[seq];
+      }
+    }
+  }
+
+  /**
+   * @brief 写入负载长度为 data_len 的帧头（变长包）
+   *
+   * 长度等于最大长度时与 write_header(dst, seq) 相同；否则改写长度字段并
+   * 在运行时计算 CRC8。
+   *
+   * @param dst 帧起始地址
+   * @param seq 序列号
+   * @param data_len 实际负载长度
+   */
+  static constexpr void write_header(uint8_t *dst, uint8_t seq,
+                                     size_t data_len) noexcept {
+    write_header(dst, seq);
+    if constexpr (Protocol::has_length_field) {
+      if (data_len == data_size)
+        return;
+      const auto len = static_cast<uint16_t>(data_len);
+      dst[Protocol::length_offset] = static_cast<uint8_t>(len & 0xFF);
+      if constexpr (Protocol::length_field_bytes == 2) {
+        dst[Protocol::length_offset + 1] = static_cast<uint8_t>(len >> 8);
+      }
+      if constexpr (Protocol::has_header_crc) {
+        dst[Protocol::header_crc_offset] =
+            ProtocolCRC8::calc(dst, Protocol::header_crc_offset);
+      }
+    }
+  }
+
+  /**
+   * @brief 计算并写入帧尾 CRC
+   *
+   * 从 crc_prefix_state 继续计算，跳过帧头常量前缀。
+   *
+   * @param frame 已写好帧头与负载的帧起始地址
+   */
+  static constexpr void write_tail(uint8_t *frame) noexcept {
+    if constexpr (tail_size > 0) {
+      const auto crc = Protocol::RPL_CRC::calc(
+          frame + const_prefix_size,
+          header_size + data_size - const_prefix_size, crc_prefix_state);
+      frame[header_size + data_size] = static_cast<uint8_t>(crc & 0xFF);
+      frame[header_size + data_size + 1] =
+          static_cast<uint8_t>((crc >> 8) & 0xFF);
+    }
+  }
+
+  /**
+   * @brief 计算并写入负载长度为 data_len 的帧尾 CRC（变长包）
+   *
+   * 长度字段位于常量前缀内，长度不等于最大长度时前缀状态失效，需整帧计算。
+   *
+   * @param frame 已写好帧头与负载的帧起始地址
+   * @param data_len 实际负载长度
+   */
+  static constexpr void write_tail(uint8_t *frame, size_t data_len) noexcept {
+    if constexpr (tail_size > 0) {
+      if (data_len == data_size) {
+        write_tail(frame);
+        return;
+      }
+      const auto crc = Protocol::RPL_CRC::calc(frame, header_size + data_len);
+      frame[header_size + data_len] = static_cast<uint8_t>(crc & 0xFF);
+      frame[header_size + data_len + 1] =
+          static_cast<uint8_t>((crc >> 8) & 0xFF);
+    }
+  }
+};
+
+} // namespace RPL::Meta
+
+#endif // RPL_FRAME_TEMPLATE_HPP
@@ -51,6 +51,7 @@ constexpr size_t align_up(size_t offset, size_t alignment) {
  * - 计算所有数据包在内存池中的布局（考虑对齐）
  * - 生成命令码到内存偏移量的映射表
  * - 生成命令码到序列索引的映射表（用于 SeqLock）
+ * - 子包以 packet_key 组合键登记，与顶层命令码互不冲突
  *
  * @code
  * using Collector = RPL::Meta::PacketInfoCollector<PacketA, PacketB>;
@@ -59,6 +60,25 @@ constexpr size_t align_up(size_t offset, size_t alignment) {
  * @endcode
  */
 template <typename... Ts> struct PacketInfoCollector {
+  /**
+   * @brief 单个类型在内存池中占用的字节数
+   *
+   * 取结构体大小与线格式最大长度中的较大者，保证按线格式长度写入不会越界。
+   *
+   * @tparam T 数据包类型
+   */
+  template <typename T> static constexpr size_t slot_size() noexcept {
+    return std::max(sizeof(T), PacketTraits<T>::size);
+  }
+
+  /// @brief 按序列索引排列的线格式最大长度（PacketTraits::size）
+  static constexpr std::array<size_t, sizeof...(Ts)> packet_sizes{
+      PacketTraits<Ts>::size...};
+
+  /// @brief 按序列索引排列的变长标志
+  static constexpr std::array<bool, sizeof...(Ts)> variable_length{
+      HasVariableLength<Ts>...};
+
   /**
    * @brief 递归计算偏移量的辅助函数
    *
@@ -76,7 +96,7 @@ template <typename... Ts> struct PacketInfoCollector {
       size_t index) {
     current_offset = align_up(current_offset, alignof(T));
     offsets[index] = current_offset;
-    current_offset += sizeof(T);
+    current_offset += slot_size<T>();
 
     if constexpr (sizeof...(Rest) > 0) {
       calculate_offsets<Rest...>(offsets, current_offset, index + 1);
@@ -112,12 +132,11 @@ template <typename... Ts> struct PacketInfoCollector {
    * 使用 frozen::unordered_map 实现编译期查找表。
    */
   static constexpr auto cmdToIndex = []() {
-    std::array<std::pair<uint16_t, size_t>, sizeof...(Ts)> pairs{};
+    std::array<std::pair<uint32_t, size_t>, sizeof...(Ts)> pairs{};
     size_t index = 0;
 
     // 使用折叠表达式填充数组
-    ((pairs[index] =
-          std::make_pair(PacketTraits<Ts>::cmd, layout.offsets[index]),
+    ((pairs[index] = std::make_pair(packet_key<Ts>(), layout.offsets[index]),
       ++index),
      ...);
 
@@ -133,7 +152,7 @@ template <typename... Ts> struct PacketInfoCollector {
    * @return 该类型的索引（偏移量）
    */
   template <typename T> static constexpr size_t type_index() noexcept {
-    return cmd_index(PacketTraits<T>::cmd);
+    return cmd_index(packet_key<T>());
   }
 
   /**
@@ -141,10 +160,10 @@ template <typename... Ts> struct PacketInfoCollector {
    *
    * 根据命令码获取对应数据包类型在内存池中的索引（偏移量）
    *
-   * @param cmd 命令码
+   * @param cmd 命令码（子包为 packet_key 组合键）
    * @return 对应的索引（偏移量），如果命令码不存在则返回-1
    */
-  static constexpr size_t cmd_index(uint16_t cmd) noexcept {
+  static constexpr size_t cmd_index(uint32_t cmd) noexcept {
     auto it = cmdToIndex.find(cmd);
     return it != cmdToIndex.end() ? it->second : static_cast<size_t>(-1);
   }
@@ -156,20 +175,19 @@ template <typename... Ts> struct PacketInfoCollector {
    * 用于 SeqLock 机制中定位对应的 version 计数器。
    */
   static constexpr auto cmdToSeqIndex = []() {
-    std::array<std::pair<uint16_t, size_t>, sizeof...(Ts)> pairs{};
+    std::array<std::pair<uint32_t, size_t>, sizeof...(Ts)> pairs{};
     size_t index = 0;
-    ((pairs[index] = std::make_pair(PacketTraits<Ts>::cmd, index), ++index),
-     ...);
+    ((pairs[index] = std::make_pair(packet_key<Ts>(), index), ++index), ...);
     return frozen::make_unordered_map(pairs);
   }();
 
   /**
    * @brief 根据命令码获取序列索引
    *
-   * @param cmd 命令码
+   * @param cmd 命令码（子包为 packet_key 组合键）
    * @return 对应的序列索引（0-based 类型序号），如果命令码不存在则返回-1
    */
-  static constexpr size_t cmd_seq_index(uint16_t cmd) noexcept {
+  static constexpr size_t cmd_seq_index(uint32_t cmd) noexcept {
     auto it = cmdToSeqIndex.find(cmd);
     return it != cmdToSeqIndex.end() ? it->second : static_cast<size_t>(-1);
   }
@@ -181,7 +199,7 @@ template <typename... Ts> struct PacketInfoCollector {
    * @return 该类型的序列索引（0-based 类型序号）
    */
   template <typename T> static constexpr size_t type_seq_index() noexcept {
-    return cmd_seq_index(PacketTraits<T>::cmd);
+    return cmd_seq_index(packet_key<T>());
   }
 };
 } // namespace RPL::Meta
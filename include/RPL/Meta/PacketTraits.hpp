@@ -22,6 +22,8 @@
 #define RPL_INFO_HPP
 
 #include "RPL/Utils/Def.hpp"
+#include <algorithm>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 
@@ -33,6 +35,15 @@ enum class PacketCategory : uint8_t {
   Ack,
 };
 
+/**
+ * @brief 发送队列溢出 / 合并策略（TxScheduler 使用）
+ */
+enum class TxPolicy : uint8_t {
+  Queue,      ///< 先进先出排队，队列满时拒绝新包
+  Coalesce,   ///< 只保留最新一包，未发出的旧值被覆盖
+  DropOldest, ///< 先进先出排队，队列满时丢弃最旧的包
+};
+
 /**
  * @brief 默认 RoboMaster 协议定义
  *
@@ -176,6 +187,18 @@ template <typename Derived> struct PacketTraitsBase {
   ///       适合已通过 after_parse 回调直接消费数据的场景。
   static constexpr bool skip_memory_pool = false;
 
+  /// @brief 发送频率上限（Hz），0 表示不限（TxScheduler 使用）
+  static constexpr uint32_t max_rate_hz = 0;
+
+  /// @brief 带宽类别，同类别的包共享一个聚合令牌桶（TxScheduler 使用）
+  static constexpr uint8_t bandwidth_class = 0;
+
+  /// @brief 发送队列策略（TxScheduler 使用）
+  static constexpr TxPolicy tx_policy = TxPolicy::Queue;
+
+  /// @brief 发送优先级，数值越小越紧急；默认最低（USBTransport 发送队列使用）
+  static constexpr uint8_t tx_priority = 0xFF;
+
   /**
    * @brief 获取数据包前的处理
    *
@@ -205,9 +228,13 @@ template <typename Derived> struct PacketTraitsBase {
  * - 必须定义 `cmd` 静态常量（命令码）
  * - 必须定义 `size` 静态常量（数据包大小）
  * - 可选定义 `BitLayout` 类型（用于位流序列化/反序列化）
- * - 可选定义 `after_parse` 函数（解析完成后回调，接收 const T&）
+ * - 可选定义 `after_parse` 函数（解析完成后回调，接收 const T&；位流包也可接收 BitView<T>）
  * - 可选定义 `skip_memory_pool` 静态常量（跳过写入 MemoryPool）
  * - 可选定义 `before_get_custom` 函数（获取前处理）
+ * - 可选定义 `wire_size(const T&)` 静态函数（变长负载，此时 `size` 为最大长度）
+ * - 可选定义 `using Parent = ParentPacket;`（子包，`cmd` 为父包负载内的子命令码）
+ * - 可选定义 `max_rate_hz` / `bandwidth_class` / `tx_policy`（发送调度，见 TxScheduler）
+ * - 可选定义 `tx_priority`（发送队列优先级，见 PriorityTxQueue）
  *
  * @par 完整特化示例
  * @code
@@ -230,6 +257,93 @@ template <typename Derived> struct PacketTraitsBase {
  * @endcode
  */
 template <typename T> struct PacketTraits;
+
+/**
+ * @brief 检查数据包是否为变长负载
+ *
+ * 变长数据包在 PacketTraits 中定义 `static constexpr size_t wire_size(const T&)`，
+ * 返回本次实际使用的负载字节数；`size` 表示最大长度（内存池槽位大小）。
+ * 变长包的协议必须带有长度字段，序列化时只发送前 wire_size 个字节。
+ *
+ * @tparam T 数据包类型
+ *
+ * @code
+ * template <>
+ * struct PacketTraits<TextMessage> : PacketTraitsBase<PacketTraits<TextMessage>> {
+ *     static constexpr uint16_t cmd = 0x0210;
+ *     static constexpr size_t size = sizeof(TextMessage);   // 最大长度
+ *     static constexpr size_t wire_size(const TextMessage &m) {
+ *         return 1 + m.length;                              // 实际长度
+ *     }
+ * };
+ * @endcode
+ */
+template <typename T>
+concept HasVariableLength = requires(const T &packet) {
+  { PacketTraits<T>::wire_size(packet) } -> std::convertible_to<size_t>;
+};
+
+/**
+ * @brief 检查数据包是否为子包
+ *
+ * 子包承载在父包负载内（如 0x0301 机器人交互数据中的图形、字符等），
+ * 由父包负载中的子命令码区分。子包 PacketTraits 需定义 `using Parent = P;`，
+ * 此时 `cmd` 表示子命令码。父包 PacketTraits 需定义：
+ * - `sub_cmd_offset`：子命令码（2 字节小端）在父包负载中的偏移
+ * - `sub_header_size`：子包数据之前的子头长度
+ * - `using SubHeader = H;`：子头结构体（大小等于 sub_header_size）
+ *
+ * @tparam T 数据包类型
+ *
+ * @code
+ * template <>
+ * struct PacketTraits<InteractionFigure> : PacketTraitsBase<PacketTraits<InteractionFigure>> {
+ *     using Parent = RobotInteractionData;
+ *     static constexpr uint16_t cmd = 0x0101;   // data_cmd_id
+ *     static constexpr size_t size = 15;
+ * };
+ * @endcode
+ */
+template <typename T>
+concept IsSubPacket = requires { typename PacketTraits<T>::Parent; };
+
+/**
+ * @brief 数据包在 Deserializer / 分发表中的键
+ *
+ * 顶层包为命令码本身；子包为 (父包命令码 << 16) | 子命令码，
+ * 避免子命令码与顶层命令码冲突（如 0x0101 EventData 与图形子包）。
+ *
+ * @tparam T 数据包类型
+ */
+template <typename T> constexpr uint32_t packet_key() noexcept {
+  if constexpr (IsSubPacket<T>) {
+    using Parent = typename PacketTraits<T>::Parent;
+    return (static_cast<uint32_t>(PacketTraits<Parent>::cmd) << 16) |
+           PacketTraits<T>::cmd;
+  } else {
+    return PacketTraits<T>::cmd;
+  }
+}
+
+/**
+ * @brief 获取数据包本次序列化的负载长度
+ *
+ * 定长包恒为 PacketTraits<T>::size；变长包为 wire_size()，并截断到最大长度。
+ *
+ * @tparam T 数据包类型
+ * @param packet 数据包
+ * @return 负载字节数
+ */
+template <typename T>
+constexpr size_t payload_size(const T &packet) noexcept {
+  if constexpr (HasVariableLength<T>) {
+    return std::min(static_cast<size_t>(PacketTraits<T>::wire_size(packet)),
+                    PacketTraits<T>::size);
+  } else {
+    (void)packet;
+    return PacketTraits<T>::size;
+  }
+}
 } // namespace RPL::Meta
 
 #endif // RPL_INFO_HPP
@@ -0,0 +1,296 @@
+/**
+ * @file OfflineParser.hpp
+ * @brief RPL 离线并行解析：在大块原始录制数据上并行分段与解码
+ *
+ * 此文件提供 OfflineParser，用于分析比赛录制的原始串口字节（数百 MB）：
+ * 多线程定位候选帧，按确定的规则拼接，再多线程解码。
+ *
+ * @par 设计原理
+ * - 分块：数据按 chunk_size 切成若干块，工作线程以原子计数领取
+ * - 候选：每块内的每个起始字节位置调用 Parser::probe，
+ *   与 Parser::try_parse_packets 共用同一套帧头 / CRC8 / 长度 / CRC16 判定；
+ *   probe 可以读到块之外的数据，块边界不影响判定
+ * - 帧尾：ProtocolCRC16 帧尾先跳过，块扫描结束后每 16 帧一批由 CrcBatch 并行校验；
+ *   校验失败的候选回到逐帧 probe 重新判定
+ * - 拼接：按偏移顺序贪心选取不重叠的候选（顺序 Parser 在上一帧末尾之后
+ *   遇到的第一个有效帧），遇到数据不足的候选即停止（顺序 Parser 在此等待）
+ * - 等价性：结果与把全部数据推入顺序 Parser（内部缓冲区不溢出）得到的帧序列相同；
+ *   共享起始字节时同样依赖 probe 的规则——首个未失败的候选决定结果，
+ *   数据不足的候选不会让位给更短的候选，顺序 Parser 的结果因此与分块方式无关
+ * - 解码：帧列表按线程均分，每个线程按序把负载解码为已注册的数据包类型
+ *
+ * @par 使用场景
+ * - 离线回放 / 统计比赛录制数据
+ *
+ * @code
+ * RPL::OfflineParser<GameStatus, RobotPos> offline;
+ * auto seg = offline.segment(capture);       // 帧列表与剩余的未完成尾部
+ * offline.decode(capture, seg.frames, [&](size_t i, const auto &packet) {
+ *     // 多个线程并发调用；i 为帧序号
+ * });
+ * @endcode
+ *
+ * @note 子包（PacketTraits::Parent）不展开；after_parse 与 Deserializer
+ *       不参与离线解析
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_OFFLINE_PARSER_HPP
+#define RPL_OFFLINE_PARSER_HPP
+
+#include "Meta/PacketTraits.hpp"
+#include "Parser.hpp"
+#include "Utils/CrcBatch.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace RPL {
+
+/**
+ * @brief 离线分段得到的一帧（偏移相对于输入数据）
+ */
+struct OfflineFrame {
+  size_t offset = 0;        ///< 帧在输入数据中的偏移
+  uint32_t size = 0;        ///< 完整帧长度
+  uint32_t payload_size = 0;
+  uint16_t header_size = 0;
+  uint16_t cmd = 0;
+  uint8_t protocol = 0xFF; ///< 协议编号（FrameProbe::protocol）
+
+  /// @brief 完整帧视图
+  [[nodiscard]] std::span<const uint8_t>
+  bytes(std::span<const uint8_t> data) const noexcept {
+    return data.subspan(offset, size);
+  }
+
+  /// @brief 负载视图
+  [[nodiscard]] std::span<const uint8_t>
+  payload(std::span<const uint8_t> data) const noexcept {
+    return data.subspan(offset + header_size, payload_size);
+  }
+};
+
+/**
+ * @brief 离线分段结果
+ */
+struct OfflineSegmentation {
+  std::vector<OfflineFrame> frames;
+  /// 顺序 Parser 处理完全部数据后缓冲区中剩余数据的起点
+  /// （未完成的尾帧；可与后续数据拼接后继续分段）
+  size_t consumed = 0;
+};
+
+/**
+ * @brief 离线并行解析器
+ *
+ * @tparam Args 与 Parser 相同的模板参数（只使用其中的数据包类型）
+ */
+template <typename... Args> class OfflineParser {
+  using ParserType = Parser<Args...>;
+  using Packets = typename ParserType::Extracted::Packets;
+
+public:
+  /**
+   * @param threads 工作线程数（0 表示硬件线程数）
+   * @param chunk_size 分块大小（字节）
+   */
+  explicit OfflineParser(size_t threads = 0,
+                         size_t chunk_size = size_t{1} << 20) noexcept
+      : threads_(threads ? threads
+                         : std::max<size_t>(std::thread::hardware_concurrency(),
+                                            1)),
+        chunk_size_(std::max<size_t>(chunk_size, 1)) {}
+
+  /**
+   * @brief 分段：得到与顺序 Parser 相同的帧序列（条件见文件说明）
+   */
+  [[nodiscard]] OfflineSegmentation
+  segment(std::span<const uint8_t> data) const {
+    const size_t chunks = (data.size() + chunk_size_ - 1) / chunk_size_;
+    std::vector<std::vector<OfflineFrame>> found(chunks);
+    parallel_for(chunks, [&](size_t c) {
+      const size_t begin = c * chunk_size_;
+      scan(data, begin, std::min(begin + chunk_size_, data.size()), found[c]);
+    });
+
+    // 拼接：按偏移顺序选取上一帧末尾之后的第一个候选
+    OfflineSegmentation out;
+    out.consumed = data.size();
+    size_t pos = 0;
+    for (const auto &list : found) {
+      for (const OfflineFrame &f : list) {
+        if (f.offset < pos)
+          continue;
+        if (f.size == 0) { // 数据不足：顺序 Parser 在此等待
+          out.consumed = f.offset;
+          return out;
+        }
+        out.frames.push_back(f);
+        pos = f.offset + f.size;
+      }
+    }
+    return out;
+  }
+
+  /**
+   * @brief 并行解码帧列表
+   *
+   * 每个已注册的顶层数据包类型 T 调用 visitor(index, const T &)，
+   * index 为帧在 frames 中的序号；未注册的命令码跳过。
+   * visitor 被多个线程并发调用，每个线程处理一段连续的帧。
+   */
+  template <typename Visitor>
+  void decode(std::span<const uint8_t> data,
+              std::span<const OfflineFrame> frames, Visitor &&visitor) const {
+    const size_t parts = std::min(threads_, frames.size());
+    parallel_for(parts, [&](size_t t) {
+      const size_t begin = frames.size() * t / parts;
+      const size_t end = frames.size() * (t + 1) / parts;
+      for (size_t i = begin; i < end; ++i)
+        visit(i, frames[i], frames[i].payload(data), visitor);
+    });
+  }
+
+  [[nodiscard]] size_t threads() const noexcept { return threads_; }
+  [[nodiscard]] size_t chunk_size() const noexcept { return chunk_size_; }
+
+private:
+  using Batch = CrcBatch<ProtocolCRC16>;
+
+  /// @brief 已被剔除的候选（帧尾校验失败且重新判定无效）
+  static constexpr size_t rejected = static_cast<size_t>(-1);
+
+  /// @brief 在 [begin, end) 的每个起始字节位置探测一帧（可读到 end 之后）
+  static void scan(std::span<const uint8_t> data, size_t begin, size_t end,
+                   std::vector<OfflineFrame> &out) {
+    std::vector<size_t> pending; // 帧尾待批量校验的候选在 out 中的下标
+    const uint8_t *base = data.data();
+    for (size_t p = begin; p < end; ++p) {
+      if constexpr (ParserType::unique_start_byte != 0xFF) {
+        const auto *next = static_cast<const uint8_t *>(
+            std::memchr(base + p, ParserType::unique_start_byte, end - p));
+        if (!next)
+          break;
+        p = static_cast<size_t>(next - base);
+      } else {
+        while (p < end && ParserType::header_lut[base[p]] == 0xFF)
+          ++p;
+        if (p == end)
+          break;
+      }
+
+      const FrameProbe probe =
+          ParserType::template probe<false>(data.subspan(p));
+      if (probe.status != FrameProbe::Status::Invalid) {
+        if (probe.tail_pending)
+          pending.push_back(out.size());
+        out.push_back(candidate(p, probe));
+      }
+    }
+    verify_tails(data, out, pending);
+  }
+
+  static OfflineFrame candidate(size_t offset, const FrameProbe &probe) {
+    if (probe.status == FrameProbe::Status::Incomplete)
+      return OfflineFrame{offset, 0, 0, 0, 0, 0xFF};
+    return OfflineFrame{offset, probe.size, probe.payload_size,
+                        probe.header_size, probe.cmd, probe.protocol};
+  }
+
+  /// @brief 批量校验帧尾；失败的候选按完整规则重新判定
+  static void verify_tails(std::span<const uint8_t> data,
+                           std::vector<OfflineFrame> &out,
+                           std::span<const size_t> pending) {
+    if (pending.empty())
+      return;
+    std::array<std::span<const uint8_t>, Batch::max_batch> frames;
+    for (size_t i = 0; i < pending.size(); i += Batch::max_batch) {
+      const size_t n = std::min(Batch::max_batch, pending.size() - i);
+      for (size_t k = 0; k < n; ++k)
+        frames[k] = out[pending[i + k]].bytes(data);
+      const uint16_t ok = Batch::verify({frames.data(), n});
+      for (size_t k = 0; k < n; ++k) {
+        if (ok & (1u << k))
+          continue;
+        OfflineFrame &f = out[pending[i + k]];
+        const FrameProbe probe = ParserType::probe(data.subspan(f.offset));
+        f = probe.status == FrameProbe::Status::Invalid
+                ? OfflineFrame{rejected}
+                : candidate(f.offset, probe);
+      }
+    }
+    std::erase_if(out,
+                  [](const OfflineFrame &f) { return f.offset == rejected; });
+  }
+
+  template <typename Visitor>
+  static void visit(size_t index, const OfflineFrame &f,
+                    std::span<const uint8_t> payload, Visitor &visitor) {
+    Details::runtime_get(
+        f.protocol, typename ParserType::WorkerTuple{}, [&](auto worker) {
+          using W = decltype(worker);
+          [&]<typename... Ts>(Details::TypeList<Ts...>) {
+            (try_decode<Ts, W>(index, f.cmd, payload, visitor) || ...);
+          }(Packets{});
+        });
+  }
+
+  template <typename T, typename W, typename Visitor>
+  static bool try_decode(size_t index, uint16_t cmd,
+                         std::span<const uint8_t> payload, Visitor &visitor) {
+    using Traits = Meta::PacketTraits<T>;
+    if constexpr (Meta::IsSubPacket<T> ||
+                  !std::is_same_v<
+                      typename ParserType::Impl::template GetWorker<T>::type,
+                      W>) {
+      return false;
+    } else {
+      if (cmd != Traits::cmd)
+        return false;
+      // 与 Deserializer 相同：零填充到最大长度，before_get 后解码
+      alignas(T) std::array<uint8_t, std::max(Traits::size, sizeof(T))> temp{};
+      std::memcpy(temp.data(), payload.data(),
+                  std::min(payload.size(), Traits::size));
+      if constexpr (requires { Traits::before_get_custom(temp.data()); })
+        Traits::before_get(temp.data());
+      if constexpr (Meta::HasBitLayout<Traits>) {
+        visitor(index, deserialize_bitstream<T>(
+                           std::span<const uint8_t>(temp.data(), Traits::size)));
+      } else {
+        visitor(index, *reinterpret_cast<const T *>(temp.data()));
+      }
+      return true;
+    }
+  }
+
+  /// @brief 用 threads_ 个线程（含调用线程）执行 fn(0 .. count-1)
+  template <typename Fn> void parallel_for(size_t count, Fn &&fn) const {
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+      for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+        fn(i);
+    };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < std::min(threads_, count); ++t)
+      pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+      t.join();
+  }
+
+  size_t threads_;
+  size_t chunk_size_;
+};
+
+} // namespace RPL
+
+#endif // RPL_OFFLINE_PARSER_HPP
@@ -26,6 +26,7 @@ struct RPL::Meta::PacketTraits<CustomClientData> : PacketTraitsBase<PacketTraits
 {
     static constexpr uint16_t cmd = 0x0306;
     static constexpr size_t size = 8;
+    static constexpr uint32_t max_rate_hz = 30; ///< 裁判系统频率上限
     using BitLayout = std::tuple<
         Field<uint16_t, 16>,
         Field<uint16_t, 12>,
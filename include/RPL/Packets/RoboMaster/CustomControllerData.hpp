@@ -19,6 +19,7 @@ struct RPL::Meta::PacketTraits<CustomControllerData> : PacketTraitsBase<PacketTr
 {
     static constexpr uint16_t cmd = 0x0302;
     static constexpr size_t size = sizeof(CustomControllerData);
+    static constexpr uint32_t max_rate_hz = 30; ///< 裁判系统频率上限
 };
 #pragma pack(pop)
 #endif // RPL_CUSTOMCONTROLLERDATA_HPP
@@ -21,6 +21,7 @@ struct RPL::Meta::PacketTraits<CustomInfo> : PacketTraitsBase<PacketTraits<Custo
 {
     static constexpr uint16_t cmd = 0x0308;
     static constexpr size_t size = sizeof(CustomInfo);
+    static constexpr uint32_t max_rate_hz = 3; ///< 裁判系统频率上限
 };
 #pragma pack(pop)
 #endif // RPL_CUSTOMINFO_HPP
@@ -19,6 +19,7 @@ struct RPL::Meta::PacketTraits<CustomRobotData> : PacketTraitsBase<PacketTraits<
 {
     static constexpr uint16_t cmd = 0x0309;
     static constexpr size_t size = sizeof(CustomRobotData);
+    static constexpr uint32_t max_rate_hz = 10; ///< 裁判系统频率上限
 };
 #pragma pack(pop)
 #endif // RPL_CUSTOMROBOTDATA_HPP
@@ -6,6 +6,7 @@
 #include <tuple>
 #include <RPL/Meta/BitstreamTraits.hpp>
 #include <RPL/Meta/PacketTraits.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
 #pragma pack(push, 1)
 
 /**
@@ -31,6 +32,7 @@ struct InteractionFigure
 template <>
 struct RPL::Meta::PacketTraits<InteractionFigure> : PacketTraitsBase<PacketTraits<InteractionFigure>>
 {
+    using Parent = RobotInteractionData; ///< 0x0301 子包，cmd 为 data_cmd_id
     static constexpr uint16_t cmd = 0x0101;
     static constexpr size_t size = 15;
     using BitLayout = std::tuple<
@@ -0,0 +1,36 @@
+#ifndef RPL_INTERACTIONFIGUREBATCH_HPP
+#define RPL_INTERACTIONFIGUREBATCH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <RPL/Meta/PacketTraits.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
+#pragma pack(push, 1)
+
+/**
+ * @brief 客户端绘制多个图形 (子协议)
+ *
+ * 每个图形为 15 字节的 InteractionFigure 线格式，N 取 2 / 5 / 7，
+ * 分别对应 data_cmd_id 0x0102 / 0x0103 / 0x0104。未使用的图形位置为全 0（空操作）。
+ *
+ * @tparam N 图形数量
+ */
+template <size_t N>
+struct InteractionFigureBatch
+{
+    static_assert(N == 2 || N == 5 || N == 7, "Figure batch size must be 2, 5 or 7");
+    static constexpr size_t figure_size = 15; ///< 单个图形线格式长度
+
+    std::array<std::array<uint8_t, figure_size>, N> figures; ///< 图形线格式数据
+};
+
+template <size_t N>
+struct RPL::Meta::PacketTraits<InteractionFigureBatch<N>> : PacketTraitsBase<PacketTraits<InteractionFigureBatch<N>>>
+{
+    using Parent = RobotInteractionData; ///< 0x0301 子包，cmd 为 data_cmd_id
+    static constexpr uint16_t cmd = N == 2 ? 0x0102 : N == 5 ? 0x0103 : 0x0104;
+    static constexpr size_t size = sizeof(InteractionFigureBatch<N>);
+};
+#pragma pack(pop)
+#endif // RPL_INTERACTIONFIGUREBATCH_HPP
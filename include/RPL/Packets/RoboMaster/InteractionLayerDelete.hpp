@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <array>
 #include <RPL/Meta/PacketTraits.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
 #pragma pack(push, 1)
 
 /**
@@ -18,6 +19,7 @@ struct InteractionLayerDelete
 template <>
 struct RPL::Meta::PacketTraits<InteractionLayerDelete> : PacketTraitsBase<PacketTraits<InteractionLayerDelete>>
 {
+    using Parent = RobotInteractionData; ///< 0x0301 子包，cmd 为 data_cmd_id
     static constexpr uint16_t cmd = 0x0100;
     static constexpr size_t size = sizeof(InteractionLayerDelete);
 };
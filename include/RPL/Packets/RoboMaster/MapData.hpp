@@ -24,6 +24,7 @@ struct RPL::Meta::PacketTraits<MapData> : PacketTraitsBase<PacketTraits<MapData>
 {
     static constexpr uint16_t cmd = 0x0307;
     static constexpr size_t size = sizeof(MapData);
+    static constexpr uint32_t max_rate_hz = 1; ///< 裁判系统频率上限
 };
 #pragma pack(pop)
 #endif // RPL_MAPDATA_HPP
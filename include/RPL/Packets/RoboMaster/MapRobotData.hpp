@@ -30,6 +30,7 @@ struct RPL::Meta::PacketTraits<MapRobotData> : PacketTraitsBase<PacketTraits<Map
 {
     static constexpr uint16_t cmd = 0x0305;
     static constexpr size_t size = sizeof(MapRobotData);
+    static constexpr uint32_t max_rate_hz = 5; ///< 裁判系统频率上限
 };
 #pragma pack(pop)
 #endif // RPL_MAPROBOTDATA_HPP
@@ -6,6 +6,7 @@
 #include <tuple>
 #include <RPL/Meta/BitstreamTraits.hpp>
 #include <RPL/Meta/PacketTraits.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
 #pragma pack(push, 1)
 
 /**
@@ -21,6 +22,7 @@ struct RadarDecision
 template <>
 struct RPL::Meta::PacketTraits<RadarDecision> : PacketTraitsBase<PacketTraits<RadarDecision>>
 {
+    using Parent = RobotInteractionData; ///< 0x0301 子包，cmd 为 data_cmd_id
     static constexpr uint16_t cmd = 0x0121;
     static constexpr size_t size = 8;
     using BitLayout = std::tuple<
@@ -19,6 +19,7 @@ struct RPL::Meta::PacketTraits<RobotCustomData> : PacketTraitsBase<PacketTraits<
 {
     static constexpr uint16_t cmd = 0x0310;
     static constexpr size_t size = sizeof(RobotCustomData);
+    static constexpr uint32_t max_rate_hz = 50; ///< 裁判系统频率上限
 };
 #pragma pack(pop)
 #endif // RPL_ROBOTCUSTOMDATA_HPP
@@ -6,8 +6,22 @@
 #include <RPL/Meta/PacketTraits.hpp>
 #pragma pack(push, 1)
 
+/**
+ * @brief 0x0301 负载开头的子头，序列化子包时使用
+ */
+struct RobotInteractionHeader
+{
+    uint16_t data_cmd_id; ///< 子内容 ID（序列化子包时自动填写）
+    uint16_t sender_id; ///< 发送者 ID
+    uint16_t receiver_id; ///< 接收者 ID
+};
+
 /**
  * @brief 机器人间交互数据，发送方触发，频率上限 30Hz
+ *
+ * 变长数据包：实际发送长度由 data_cmd_id 决定，见 PacketTraits::wire_size。
+ * 子内容（图形、字符、删除图层、哨兵/雷达决策）是以本包为 Parent 的子包，
+ * 由 Parser 按 data_cmd_id 二级分发。
  */
 struct RobotInteractionData
 {
@@ -21,7 +35,41 @@ template <>
 struct RPL::Meta::PacketTraits<RobotInteractionData> : PacketTraitsBase<PacketTraits<RobotInteractionData>>
 {
     static constexpr uint16_t cmd = 0x0301;
-    static constexpr size_t size = sizeof(RobotInteractionData);
+    static constexpr size_t size = sizeof(RobotInteractionData); ///< 最大长度
+    static constexpr uint32_t max_rate_hz = 30; ///< 裁判系统频率上限
+
+    /// @brief 子包子头类型
+    using SubHeader = RobotInteractionHeader;
+    /// @brief 子内容 ID 在负载中的偏移
+    static constexpr size_t sub_cmd_offset = 0;
+    /// @brief 子内容头长度（data_cmd_id + sender_id + receiver_id）
+    static constexpr size_t sub_header_size = sizeof(RobotInteractionHeader);
+
+    /**
+     * @brief 按子内容 ID 返回内容数据段长度
+     *
+     * 未知子内容（如 0x0200-0x02FF 机器人间自定义数据）按最大长度发送。
+     */
+    static constexpr size_t user_data_size(uint16_t data_cmd_id)
+    {
+        switch (data_cmd_id)
+        {
+        case 0x0100: return 2;   // 删除图层
+        case 0x0101: return 15;  // 绘制一个图形
+        case 0x0102: return 30;  // 绘制两个图形
+        case 0x0103: return 75;  // 绘制五个图形
+        case 0x0104: return 105; // 绘制七个图形
+        case 0x0110: return 45;  // 绘制字符
+        case 0x0120: return 4;   // 哨兵自主决策指令
+        case 0x0121: return 8;   // 雷达自主决策指令
+        default: return 112;
+        }
+    }
+
+    static constexpr size_t wire_size(const RobotInteractionData& data)
+    {
+        return sub_header_size + user_data_size(data.data_cmd_id);
+    }
 };
 #pragma pack(pop)
 #endif // RPL_ROBOTINTERACTIONDATA_HPP
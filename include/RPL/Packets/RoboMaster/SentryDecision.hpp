@@ -6,6 +6,7 @@
 #include <tuple>
 #include <RPL/Meta/BitstreamTraits.hpp>
 #include <RPL/Meta/PacketTraits.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
 #pragma pack(push, 1)
 
 /**
@@ -26,6 +27,7 @@ struct SentryDecision
 template <>
 struct RPL::Meta::PacketTraits<SentryDecision> : PacketTraitsBase<PacketTraits<SentryDecision>>
 {
+    using Parent = RobotInteractionData; ///< 0x0301 子包，cmd 为 data_cmd_id
     static constexpr uint16_t cmd = 0x0120;
     static constexpr size_t size = 4;
     using BitLayout = std::tuple<
@@ -34,6 +34,7 @@ struct PacketTraits<MotorSpeedCmd>
   static constexpr uint16_t cmd = 0x10;
   static constexpr size_t size = sizeof(MotorSpeedCmd);
   static constexpr PacketCategory category = PacketCategory::Request;
+  static constexpr uint8_t tx_priority = 0; ///< 控制指令，最紧急
   using Protocol = USBRequestProto;
 };
 } // namespace RPL::Meta
@@ -13,7 +13,9 @@
 #define RPL_PARSER_HPP
 
 #include "Containers/BipBuffer.hpp"
+#include "Containers/DmaRingBuffer.hpp"
 #include "Deserializer.hpp"
+#include "Meta/FrameTemplate.hpp"
 #include "Meta/PacketTraits.hpp"
 #include "Utils/ConnectionMonitor.hpp"
 #include "Utils/Def.hpp"
@@ -23,9 +25,11 @@
 #include <bit>
 #include <cstring>
 #include <optional>
+#include <span>
 #include <tl/expected.hpp>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 /**
  * @namespace RPL
@@ -122,31 +126,73 @@ template <typename T>
 struct IsConnectionMonitor
     : std::bool_constant<ConnectionMonitorConcept<T> && !IsPacketType<T>> {};
 
-// 从模板参数中提取 Monitor 和 Packets
-template <typename... Args> struct ExtractMonitorAndPackets;
-
-// 第一个参数是 ConnectionMonitor
-template <typename M, typename... Ps>
-  requires IsConnectionMonitor<M>::value
-struct ExtractMonitorAndPackets<M, Ps...> {
-  using Monitor = M;
-  using Packets = TypeList<Ps...>;
-};
+/**
+ * @brief 外部接收缓冲区策略概念
+ *
+ * 作为 Parser 数据包列表之前的可选参数时，Parser 直接在外部内存
+ * （如循环 DMA 缓冲区，见 Containers::DmaRingBuffer）上解析，
+ * 不再使用内部 BipBuffer。
+ *
+ * @tparam B 要检查的类型
+ */
+template <typename B>
+concept ExternalRxBufferConcept =
+    requires(B &b, const B &cb, const uint8_t *ring, size_t n) {
+      b.attach(ring);
+      { b.update_write_index(n) } -> std::same_as<bool>;
+      { cb.get_read_spans(n, n) };
+      { b.discard(n) } -> std::same_as<bool>;
+      { cb.space() } -> std::convertible_to<size_t>;
+    };
 
-// 第一个参数不是 ConnectionMonitor (全部是 Packet)
-template <typename... Ps>
-  requires(
-      sizeof...(Ps) > 0 &&
-      !IsConnectionMonitor<std::tuple_element_t<0, std::tuple<Ps...>>>::value)
-struct ExtractMonitorAndPackets<Ps...> {
-  using Monitor = NullConnectionMonitor;
-  using Packets = TypeList<Ps...>;
+/**
+ * @brief 检查类型是否是外部接收缓冲区 (满足 concept 且不是 Packet)
+ * @tparam T 要检查的类型
+ */
+template <typename T>
+struct IsExternalRxBuffer
+    : std::bool_constant<ExternalRxBufferConcept<T> && !IsPacketType<T>> {};
+
+/// @brief 默认接收缓冲区：Parser 内部的 BipBuffer
+struct InternalRxBuffer {};
+
+// 从模板参数开头逐个提取可选组件（Monitor、接收缓冲区、Deserializer
+// 存储策略，顺序任意），其余为 Packets
+template <typename Monitor, typename Buffer, typename Storage,
+          typename... Args>
+struct ExtractParserOptions {
+  using MonitorType = Monitor;
+  using BufferType = Buffer;
+  using StorageType = Storage;
+  using PacketList = TypeList<Args...>;
 };
 
-// 空参数列表
-template <> struct ExtractMonitorAndPackets<> {
-  using Monitor = NullConnectionMonitor;
-  using Packets = TypeList<>;
+// 下一个参数是 ConnectionMonitor
+template <typename M, typename B, typename S, typename H, typename... Args>
+  requires IsConnectionMonitor<H>::value
+struct ExtractParserOptions<M, B, S, H, Args...>
+    : ExtractParserOptions<H, B, S, Args...> {};
+
+// 下一个参数是外部接收缓冲区
+template <typename M, typename B, typename S, typename H, typename... Args>
+  requires IsExternalRxBuffer<H>::value
+struct ExtractParserOptions<M, B, S, H, Args...>
+    : ExtractParserOptions<M, H, S, Args...> {};
+
+// 下一个参数是 Deserializer 存储策略
+template <typename M, typename B, typename S, typename H, typename... Args>
+  requires DeserializerStorageConcept<H>
+struct ExtractParserOptions<M, B, S, H, Args...>
+    : ExtractParserOptions<M, B, H, Args...> {};
+
+// 从模板参数中提取 Monitor、接收缓冲区、存储策略和 Packets
+template <typename... Args> struct ExtractMonitorAndPackets {
+  using Options = ExtractParserOptions<NullConnectionMonitor, InternalRxBuffer,
+                                       InlineStorage, Args...>;
+  using Monitor = typename Options::MonitorType;
+  using Buffer = typename Options::BufferType;
+  using Storage = typename Options::StorageType;
+  using Packets = typename Options::PacketList;
 };
 
 // --- 数据包 after_parse 分发器 ---
@@ -157,6 +203,9 @@ template <> struct ExtractMonitorAndPackets<> {
  * 在 Parser 成功解析出数据包后，检测该类型是否定义了 after_parse 回调，
  * 并判断是否需要 skip_memory_pool。
  *
+ * 若列表中存在以该类型为 Parent 的子包，则继续读取负载中的子命令码，
+ * 分发到子包的 after_parse 回调并写入子包自己的 Deserializer 槽位。
+ *
  * @tparam DeserializerType Deserializer 类型
  * @tparam List 数据包类型列表 (TypeList<Ts...>)
  */
@@ -167,59 +216,306 @@ template <typename DeserializerType, typename... Ts>
 struct PacketDispatcher<DeserializerType, TypeList<Ts...>> {
   static bool dispatch(uint16_t cmd_id, std::span<const uint8_t> s1,
                        std::span<const uint8_t> s2,
-                       DeserializerType & /*deserializer*/,
-                       bool &skip_pool) {
-    return (try_dispatch<Ts>(cmd_id, s1, s2, skip_pool) || ...);
+                       DeserializerType &deserializer, bool &skip_pool) {
+    return (try_dispatch<Ts>(cmd_id, s1, s2, deserializer, skip_pool) || ...);
   }
 
 private:
+  template <typename S, typename P> static constexpr bool is_sub_of() {
+    if constexpr (Meta::IsSubPacket<S>) {
+      return std::is_same_v<typename Meta::PacketTraits<S>::Parent, P>;
+    } else {
+      return false;
+    }
+  }
+
+  template <typename P>
+  static constexpr bool has_sub_packets = (is_sub_of<Ts, P>() || ...);
+
+  template <typename S> static constexpr bool parent_registered() {
+    if constexpr (Meta::IsSubPacket<S>) {
+      return Contains<typename Meta::PacketTraits<S>::Parent,
+                      TypeList<Ts...>>::value;
+    } else {
+      return true;
+    }
+  }
+
+  static_assert((parent_registered<Ts>() && ...),
+                "Sub-packet requires its Parent packet in the same list");
+
   template <typename T>
   static bool try_dispatch(uint16_t cmd_id, std::span<const uint8_t> s1,
-                           std::span<const uint8_t> s2, bool &skip_pool) {
-    if (cmd_id != Meta::PacketTraits<T>::cmd)
+                           std::span<const uint8_t> s2,
+                           DeserializerType &deserializer, bool &skip_pool) {
+    // 子包只经由父包分发，其命令码可能与顶层命令码重复
+    if constexpr (Meta::IsSubPacket<T>) {
       return false;
+    } else {
+      if (cmd_id != Meta::PacketTraits<T>::cmd)
+        return false;
+
+      invoke_after_parse<T>(s1, s2);
+      skip_pool = skips_memory_pool<T>();
+
+      if constexpr (has_sub_packets<T>) {
+        dispatch_sub<T>(s1, s2, deserializer);
+      }
+      return true;
+    }
+  }
+
+  /**
+   * @brief 子命令分发
+   *
+   * 读取父包负载中的子命令码，跳过子头后将剩余负载交给对应子包。
+   */
+  template <typename P>
+  static void dispatch_sub(std::span<const uint8_t> s1,
+                           std::span<const uint8_t> s2,
+                           DeserializerType &deserializer) {
+    using Traits = Meta::PacketTraits<P>;
+    constexpr size_t offset = Traits::sub_cmd_offset;
+    constexpr size_t skip = Traits::sub_header_size;
+    if (s1.size() + s2.size() < skip)
+      return;
+
+    auto byte_at = [&](size_t i) {
+      return i < s1.size() ? s1[i] : s2[i - s1.size()];
+    };
+    const auto sub_cmd = static_cast<uint16_t>(
+        byte_at(offset) | (static_cast<uint16_t>(byte_at(offset + 1)) << 8));
+
+    std::span<const uint8_t> sub_s1, sub_s2;
+    if (skip < s1.size()) {
+      sub_s1 = s1.subspan(skip);
+      sub_s2 = s2;
+    } else {
+      sub_s2 = s2.subspan(skip - s1.size());
+    }
+
+    (try_dispatch_sub<P, Ts>(sub_cmd, sub_s1, sub_s2, deserializer) || ...);
+  }
+
+  template <typename P, typename S>
+  static bool try_dispatch_sub(uint16_t sub_cmd, std::span<const uint8_t> s1,
+                               std::span<const uint8_t> s2,
+                               DeserializerType &deserializer) {
+    if constexpr (is_sub_of<S, P>()) {
+      if (sub_cmd != Meta::PacketTraits<S>::cmd)
+        return false;
+      invoke_after_parse<S>(s1, s2);
+      if (!skips_memory_pool<S>()) {
+        deserializer.write_segmented(Meta::packet_key<S>(), s1, s2);
+      }
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  template <typename T> static constexpr bool skips_memory_pool() {
+    using Traits = Meta::PacketTraits<T>;
+    if constexpr (requires { Traits::skip_memory_pool; }) {
+      return Traits::skip_memory_pool;
+    } else {
+      return false;
+    }
+  }
+
+  template <typename T>
+  static void invoke_after_parse(std::span<const uint8_t> s1,
+                                 std::span<const uint8_t> s2) {
     using Traits = Meta::PacketTraits<T>;
 
+    // 负载连续且不短于 PacketTraits::size 时直接使用，否则合并到零填充的
+    // 临时缓冲区（跨 BipBuffer 边界，或变长包短于最大长度）
+    const bool contiguous = s2.empty() && s1.size() >= Traits::size;
+    auto merge = [&](std::array<uint8_t, Traits::size> &temp) {
+      const size_t n1 = std::min(s1.size(), temp.size());
+      const size_t n2 = std::min(s2.size(), temp.size() - n1);
+      std::memcpy(temp.data(), s1.data(), n1);
+      std::memcpy(temp.data() + n1, s2.data(), n2);
+    };
+
     // 执行 after_parse 回调（如果定义了）
     if constexpr (requires {
                     Traits::after_parse(std::declval<const T &>());
                   }) {
       if constexpr (Meta::HasBitLayout<Traits>) {
         // BitLayout：先合并到临时缓冲区，再反序列化
-        if (s2.empty()) {
+        if (contiguous) {
           Traits::after_parse(RPL::deserialize_bitstream<T>(s1));
         } else {
           alignas(alignof(T)) std::array<uint8_t, Traits::size> temp{};
-          std::memcpy(temp.data(), s1.data(), s1.size());
-          std::memcpy(temp.data() + s1.size(), s2.data(), s2.size());
+          merge(temp);
           Traits::after_parse(RPL::deserialize_bitstream<T>(
               std::span<const uint8_t>(temp.data(), temp.size())));
         }
       } else {
         // 普通 POD：连续则直接 reinterpret，不连续则先拷贝到对齐缓冲区
-        if (s2.empty()) {
+        if (contiguous) {
           Traits::after_parse(*reinterpret_cast<const T *>(s1.data()));
         } else {
           alignas(alignof(T)) std::array<uint8_t, Traits::size> temp{};
-          std::memcpy(temp.data(), s1.data(), s1.size());
-          std::memcpy(temp.data() + s1.size(), s2.data(), s2.size());
+          merge(temp);
           Traits::after_parse(*reinterpret_cast<const T *>(temp.data()));
         }
       }
+    } else if constexpr (Meta::HasBitLayout<Traits> &&
+                         requires {
+                           Traits::after_parse(std::declval<BitView<T>>());
+                         }) {
+      // BitView 回调：直接在线格式字节上按需访问字段，不构造完整结构体
+      if (contiguous) {
+        Traits::after_parse(BitView<T>{s1});
+      } else {
+        std::array<uint8_t, Traits::size> temp{};
+        merge(temp);
+        Traits::after_parse(
+            BitView<T>{std::span<const uint8_t>(temp.data(), temp.size())});
+      }
+    } else {
+      (void)contiguous;
+      (void)merge;
     }
+  }
+};
 
-    // 判断是否跳过 MemoryPool
-    if constexpr (requires { Traits::skip_memory_pool; }) {
-      skip_pool = Traits::skip_memory_pool;
+/**
+ * @brief 列表中 category 为 PacketCategory::Ack 的数据包
+ *
+ * @tparam List 数据包类型列表 (TypeList<Ts...>)
+ */
+template <typename List> struct AckPackets;
+
+template <typename... Ts> struct AckPackets<TypeList<Ts...>> {
+  template <typename T> static constexpr bool is_ack() {
+    if constexpr (Meta::IsSubPacket<T>) {
+      return false;
+    } else if constexpr (requires { Meta::PacketTraits<T>::category; }) {
+      return Meta::PacketTraits<T>::category == Meta::PacketCategory::Ack;
     } else {
-      skip_pool = false;
+      return false;
     }
+  }
+
+  static constexpr bool any = (is_ack<Ts>() || ...);
+
+  static constexpr bool contains(uint16_t cmd) {
+    return ((is_ack<Ts>() && Meta::PacketTraits<Ts>::cmd == cmd) || ...);
+  }
+};
+
+/**
+ * @brief 连续内存上的只读视图
+ *
+ * 提供与接收缓冲区相同的读取接口，使 Parser 的帧校验可以直接作用于
+ * 离线数据（Parser::probe）。
+ */
+struct FlatView {
+  std::span<const uint8_t> data;
+
+  [[nodiscard]] size_t available() const noexcept { return data.size(); }
+
+  [[nodiscard]] std::pair<std::span<const uint8_t>, std::span<const uint8_t>>
+  get_read_spans(size_t offset, size_t length) const noexcept {
+    if (offset + length > data.size())
+      return {{}, {}};
+    return {data.subspan(offset, length), {}};
+  }
+
+  bool peek(uint8_t *dst, size_t offset, size_t length) const noexcept {
+    if (offset + length > data.size())
+      return false;
+    std::memcpy(dst, data.data() + offset, length);
     return true;
   }
 };
 
 } // namespace Details
 
+template <typename... Args> class OfflineParser;
+
+/**
+ * @brief Parser::probe 的结果：在连续内存起始处识别一帧
+ */
+struct FrameProbe {
+  enum class Status : uint8_t {
+    Frame,      ///< 起始处是通过校验的完整帧
+    Invalid,    ///< 起始处不是帧（Parser 丢弃 1 字节后继续扫描）
+    Incomplete, ///< 数据不足以判定（Parser 等待更多数据）
+  };
+
+  Status status = Status::Invalid;
+  uint8_t protocol = 0xFF;  ///< 协议编号（Parser 内部去重后的协议序号）
+  uint16_t cmd = 0;         ///< 命令码
+  uint16_t header_size = 0; ///< 帧头长度（负载起始偏移）
+  uint32_t size = 0;        ///< 完整帧长度
+  uint32_t payload_size = 0;
+  bool tail_pending = false; ///< 帧尾 CRC16 尚未校验（probe<false>）
+};
+
+/**
+ * @brief 实例级数据包回调
+ *
+ * PacketTraits::after_parse 是静态函数，无法访问对象状态；需要把解析结果
+ * 交给某个对象时使用此回调。
+ * 每成功解析一帧调用一次，在 after_parse 之后，负载可能跨越环形缓冲区边界。
+ */
+struct PacketHook {
+  void *ctx = nullptr;
+  void (*fn)(void *ctx, uint16_t cmd, std::span<const uint8_t> s1,
+             std::span<const uint8_t> s2) = nullptr;
+};
+
+/**
+ * @brief 实例级 Ack 回调
+ *
+ * category 为 PacketCategory::Ack 的数据包（负载为 {req_id, status}）
+ * 解析成功后调用，供 USBTransport 把 Ack 交给 AckManager。
+ * 与 PacketHook 是两个独立的槽位，设置其中一个不会覆盖另一个。
+ */
+struct AckHook {
+  void *ctx = nullptr;
+  void (*fn)(void *ctx, uint8_t req_id, uint8_t status) = nullptr;
+};
+
+/**
+ * @brief 通过校验的原始帧视图
+ *
+ * 所有视图都指向 Parser 的接收缓冲区，只在回调期间有效；
+ * 跨越环形缓冲区末尾时第二段非空。
+ */
+struct RawFrame {
+  uint16_t cmd = 0;                     ///< 命令码
+  std::span<const uint8_t> s1, s2;      ///< 完整帧（帧头 + 负载 + 帧尾）
+  std::span<const uint8_t> payload_s1;  ///< 负载第一段
+  std::span<const uint8_t> payload_s2;  ///< 负载第二段
+  int16_t seq = -1;                     ///< 序列号（协议无序列号时为 -1）
+
+  /// @brief 完整帧长度
+  [[nodiscard]] size_t size() const noexcept { return s1.size() + s2.size(); }
+
+  /// @brief 负载长度
+  [[nodiscard]] size_t payload_size() const noexcept {
+    return payload_s1.size() + payload_s2.size();
+  }
+};
+
+/**
+ * @brief 实例级原始帧回调
+ *
+ * 帧通过校验后、分发与写入 Deserializer 之前调用，交出完整帧，
+ * 用于不经反序列化直接转发原始帧（如 DatagramBridge、FrameRelay）。
+ * 返回 false 时丢弃该帧：不分发、不调用 PacketHook、不写入 Deserializer
+ * （如 LinkMerger 丢弃冗余链路上的重复帧）。
+ */
+struct FrameHook {
+  void *ctx = nullptr;
+  bool (*fn)(void *ctx, const RawFrame &frame) = nullptr;
+};
+
 /**
  * @brief 解析器类
  *
@@ -231,6 +527,10 @@ private:
  *              - 仅数据包类型: Parser<PacketA, PacketB>
  *              - ConnectionMonitor + 数据包类型: Parser<Monitor, PacketA,
  * PacketB>
+ *              - 外部接收缓冲区 + 数据包类型:
+ *                Parser<Containers::DmaRingBuffer<256>, PacketA, PacketB>
+ *              - Deserializer 存储策略 + 数据包类型（构造时传入相同策略的
+ *                Deserializer）: Parser<Linux::ShmStorage, PacketA, PacketB>
  *
  * @code
  * // 方式1: 无监控 (零开销)
@@ -250,6 +550,8 @@ private:
  * @endcode
  */
 template <typename... Args> class Parser {
+  template <typename...> friend class OfflineParser;
+
   // 提取 Monitor 和 Packet 类型
   using Extracted = Details::ExtractMonitorAndPackets<Args...>;
   using MonitorType = typename Extracted::Monitor;
@@ -317,30 +619,106 @@ template <typename... Args> class Parser {
     static constexpr size_t buffer_size = calculate_buffer_size();
 
     // --- 构建查找表 ---
-    template <typename W>
-    static constexpr void register_packet(std::array<uint8_t, 256>& table,
-                                          size_t index) {
-      uint8_t sb = W::Protocol::start_byte;
-      if (table[sb] != 0xFF && table[sb] != index) {
-        RPL_ERROR_START_BYTE_COLLISION();
-      }
-      table[sb] = static_cast<uint8_t>(index);
+    /**
+     * @brief 协议的帧头区分能力（越大越先尝试）
+     *
+     * 起始字节相同的协议按此顺序依次尝试：固定第二字节与帧头 CRC8
+     * 能在帧头到齐时就排除错误的协议，命令码次之。
+     */
+    template <typename W> static constexpr uint8_t discrimination_rank() {
+      using P = typename W::Protocol;
+      return static_cast<uint8_t>((P::has_second_byte ? 4 : 0) +
+                                  (P::has_header_crc ? 2 : 0) +
+                                  (P::has_cmd_field ? 1 : 0));
     }
 
+    template <size_t N> struct CandidateTable {
+      std::array<uint8_t, 256> head{}; ///< 起始字节 -> 首个候选 Worker
+      std::array<uint8_t, N> next{};   ///< Worker -> 同起始字节的下一个候选
+    };
+
+    /**
+     * @brief 构建候选链
+     *
+     * 每个起始字节对应一条按 discrimination_rank 降序（同级保持列表顺序）
+     * 排列的 Worker 链。无任何区分手段（无第二字节、帧头 CRC、命令码与
+     * 帧尾校验）的协议不能与其他协议共享起始字节。
+     */
     template <typename... Ws>
-    static constexpr void build_header_impl(
-        std::array<uint8_t, 256>& table, Details::TypeList<Ws...>) {
-      size_t idx = 0;
-      ((register_packet<Ws>(table, idx++)), ...);
+    static constexpr auto build_candidates(Details::TypeList<Ws...>) {
+      constexpr size_t N = sizeof...(Ws);
+      const std::array<uint8_t, N> sb{Ws::Protocol::start_byte...};
+      const std::array<uint8_t, N> rank{discrimination_rank<Ws>()...};
+      const std::array<bool, N> blind{(discrimination_rank<Ws>() == 0 &&
+                                       Ws::Protocol::tail_size == 0)...};
+
+      CandidateTable<N> t;
+      t.head.fill(0xFF);
+      t.next.fill(0xFF);
+      for (size_t i = 0; i < N; ++i) {
+        if (t.head[sb[i]] != 0xFF &&
+            (blind[i] || blind[t.head[sb[i]]])) {
+          RPL_ERROR_START_BYTE_COLLISION();
+        }
+        // 插入到同起始字节链中第一个区分能力更弱的 Worker 之前
+        uint8_t prev = 0xFF;
+        uint8_t cur = t.head[sb[i]];
+        while (cur != 0xFF && rank[cur] >= rank[i]) {
+          prev = cur;
+          cur = t.next[cur];
+        }
+        t.next[i] = cur;
+        if (prev == 0xFF)
+          t.head[sb[i]] = static_cast<uint8_t>(i);
+        else
+          t.next[prev] = static_cast<uint8_t>(i);
+      }
+      return t;
     }
 
-    static constexpr auto header_lut = []() {
-      std::array<uint8_t, 256> table;
-      table.fill(0xFF);
-      build_header_impl(table, UniqueWorkers{});
-      return table;
+    static constexpr auto candidates = build_candidates(UniqueWorkers{});
+    static constexpr auto &header_lut = candidates.head;
+    static constexpr auto &next_candidate = candidates.next;
+
+    /// @brief 是否存在多个协议共享同一起始字节
+    static constexpr bool has_shared_start_bytes = []() {
+      for (const uint8_t n : next_candidate) {
+        if (n != 0xFF)
+          return true;
+      }
+      return false;
     }();
 
+    /// @brief Worker 的起始字节是否与其他协议共享
+    template <typename W>
+    static constexpr bool shares_start_byte = []() {
+      size_t count = 0;
+      [&]<typename... Ws>(Details::TypeList<Ws...>) {
+        count = ((Ws::Protocol::start_byte == W::Protocol::start_byte ? 1 : 0) +
+                 ... + 0);
+      }(UniqueWorkers{});
+      return count > 1;
+    }();
+
+    /**
+     * @brief 共享起始字节时的命令码 / 长度判别
+     *
+     * 只接受该协议下已注册的顶层命令码，且负载长度不超过该包的（最大）长度。
+     */
+    template <typename W>
+    static constexpr bool accepts_frame(uint16_t cmd, size_t data_len) {
+      auto match = [&]<typename T>() {
+        if constexpr (Meta::IsSubPacket<T> ||
+                      !std::is_same_v<typename GetWorker<T>::type, W>) {
+          return false;
+        } else {
+          return Meta::PacketTraits<T>::cmd == cmd &&
+                 data_len <= Meta::PacketTraits<T>::size;
+        }
+      };
+      return (match.template operator()<Ts>() || ...);
+    }
+
     static constexpr uint8_t unique_start_byte = []() {
       uint8_t first_sb = 0xFF;
       size_t count = 0;
@@ -363,7 +741,6 @@ template <typename... Args> class Parser {
       return count > 1;
     }();
 
-    using DeserializerType = Deserializer<Ts...>;
   };
 
   using Impl = ParserImpl<typename Extracted::Packets>;
@@ -375,12 +752,16 @@ template <typename... Args> class Parser {
   static constexpr auto &header_lut = Impl::header_lut;
   static constexpr uint8_t unique_start_byte = Impl::unique_start_byte;
   static constexpr bool has_multiple_start_bytes = Impl::has_multiple_start_bytes;
+  static constexpr auto &next_candidate = Impl::next_candidate;
+  static constexpr bool has_shared_start_bytes = Impl::has_shared_start_bytes;
 
-  // 从 Packets TypeList 中提取 Deserializer 类型
+  // 从 Packets TypeList 中提取 Deserializer 类型（默认存储策略时不带策略参数）
   template <typename PacketList> struct DeserializerFromPackets;
   template <typename... Ts>
   struct DeserializerFromPackets<Details::TypeList<Ts...>> {
-    using type = Deserializer<Ts...>;
+    using type = std::conditional_t<
+        std::is_same_v<typename Extracted::Storage, InlineStorage>,
+        Deserializer<Ts...>, Deserializer<typename Extracted::Storage, Ts...>>;
   };
 
   using DeserializerType =
@@ -397,14 +778,40 @@ template <typename... Args> class Parser {
     Incomplete  ///< 数据不完整，需要等待更多数据
   };
 
+  /// 是否直接在外部接收缓冲区（如循环 DMA 缓冲区）上解析
+  static constexpr bool uses_external_buffer =
+      !std::is_same_v<typename Extracted::Buffer, Details::InternalRxBuffer>;
+
+  using BufferType =
+      std::conditional_t<uses_external_buffer, typename Extracted::Buffer,
+                         Containers::BipBuffer<buffer_size>>;
+
+  static_assert(!uses_external_buffer || BufferType::size() >= max_frame_size,
+                "External RX buffer must hold at least one max-size frame");
+
   // --- 成员变量 ---
-  Containers::BipBuffer<buffer_size> buffer;
+  BufferType buffer;
   DeserializerType &deserializer;
   [[no_unique_address]] MonitorType monitor_{};
+  PacketHook hook_{};
+  AckHook ack_hook_{};
+  FrameHook frame_hook_{};
 
 public:
   explicit Parser(DeserializerType &des) : deserializer(des) {}
 
+  /**
+   * @brief 构造直接在外部接收缓冲区上解析的 Parser
+   *
+   * @param des 反序列化器
+   * @param ring 外部接收缓冲区（大小由缓冲区策略的模板参数决定）
+   */
+  Parser(DeserializerType &des, const uint8_t *ring)
+    requires uses_external_buffer
+      : deserializer(des) {
+    buffer.attach(ring);
+  }
+
   /**
    * @brief 获取连接监控器引用
    *
@@ -421,6 +828,66 @@ public:
     return monitor_;
   }
 
+  /**
+   * @brief 设置实例级数据包回调
+   *
+   * @param hook 回调（fn 为空表示取消）
+   */
+  void set_packet_hook(PacketHook hook) noexcept { hook_ = hook; }
+
+  /**
+   * @brief 设置实例级 Ack 回调
+   *
+   * @param hook 回调（fn 为空表示取消）
+   */
+  void set_ack_hook(AckHook hook) noexcept { ack_hook_ = hook; }
+
+  /**
+   * @brief 设置实例级原始帧回调
+   *
+   * @param hook 回调（fn 为空表示取消）
+   */
+  void set_frame_hook(FrameHook hook) noexcept { frame_hook_ = hook; }
+
+  /// @brief 当前的实例级原始帧回调（供接管方保存并链式调用）
+  [[nodiscard]] FrameHook frame_hook() const noexcept { return frame_hook_; }
+
+  /**
+   * @brief 按解析成功的帧分发一段负载
+   *
+   * 依次执行 after_parse / 子包分发、AckHook、PacketHook 与写入 Deserializer。
+   * 用于稍后在其它线程处理被原始帧回调截留的帧（如 Linux::Gateway 的 Shared 链路）；
+   * 不访问接收缓冲区。
+   *
+   * @param cmd 命令码
+   * @param s1 负载第一段
+   * @param s2 负载第二段（负载连续时为空）
+   */
+  void dispatch(uint16_t cmd, std::span<const uint8_t> s1,
+                std::span<const uint8_t> s2 = {}) {
+    bool skip_pool = false;
+    Details::PacketDispatcher<DeserializerType,
+                              typename Extracted::Packets>::dispatch(
+        cmd, s1, s2, deserializer, skip_pool);
+
+    using Acks = Details::AckPackets<typename Extracted::Packets>;
+    if constexpr (Acks::any) {
+      if (ack_hook_.fn && Acks::contains(cmd) && s1.size() + s2.size() >= 2) {
+        auto byte_at = [&](size_t i) {
+          return i < s1.size() ? s1[i] : s2[i - s1.size()];
+        };
+        ack_hook_.fn(ack_hook_.ctx, byte_at(0), byte_at(1));
+      }
+    }
+
+    if (hook_.fn)
+      hook_.fn(hook_.ctx, cmd, s1, s2);
+
+    if (!skip_pool) {
+      deserializer.write_segmented(cmd, s1, s2);
+    }
+  }
+
   /**
    * @brief 推送数据到解析器
    *
@@ -432,7 +899,9 @@ public:
    * @return void 或错误（缓冲区溢出）
    */
   tl::expected<void, Error> push_data(const uint8_t *data,
-                                      const size_t length) {
+                                      const size_t length)
+    requires(!uses_external_buffer)
+  {
     if (!buffer.write(data, length)) {
       return tl::unexpected(
           Error{ErrorCode::BufferOverflow, "Buffer overflow"});
@@ -448,7 +917,9 @@ public:
    *
    * @return 可写入的连续内存 span
    */
-  std::span<uint8_t> get_write_buffer() noexcept {
+  std::span<uint8_t> get_write_buffer() noexcept
+    requires(!uses_external_buffer)
+  {
     return buffer.get_write_buffer();
   }
 
@@ -461,7 +932,9 @@ public:
    * @param length 已写入的字节数
    * @return void 或错误（提交长度无效）
    */
-  tl::expected<void, Error> advance_write_index(size_t length) {
+  tl::expected<void, Error> advance_write_index(size_t length)
+    requires(!uses_external_buffer)
+  {
     if (!buffer.advance_write_index(length)) {
       return tl::unexpected(
           Error{ErrorCode::BufferOverflow, "Invalid advance length"});
@@ -469,6 +942,34 @@ public:
     return try_parse_packets();
   }
 
+  /**
+   * @brief 提交外部接收缓冲区的硬件写指针并解析（零拷贝）
+   *
+   * 在 DMA 半满 / 全满 / 空闲中断中调用。数据直接在外部缓冲区中解析，
+   * 跨越缓冲区末尾的帧按两段处理。
+   *
+   * @param hw_index DMA 写指针（缓冲区大小减去 NDTR）
+   * @return void 或错误（DMA 覆盖了未解析数据，这些数据已被丢弃）
+   */
+  tl::expected<void, Error> update_write_index(size_t hw_index)
+    requires uses_external_buffer
+  {
+    if (!buffer.update_write_index(hw_index)) {
+      return tl::unexpected(
+          Error{ErrorCode::BufferOverflow, "DMA ring overrun"});
+    }
+    return try_parse_packets();
+  }
+
+  /**
+   * @brief 重新绑定外部接收缓冲区（丢弃未解析数据）
+   */
+  void attach_buffer(const uint8_t *ring) noexcept
+    requires uses_external_buffer
+  {
+    buffer.attach(ring);
+  }
+
   /**
    * @brief 获取反序列化器的引用
    * @return 反序列化器引用
@@ -483,6 +984,10 @@ public:
   
   /**
    * @brief 获取可用写入空间
+   *
+   * 使用外部接收缓冲区时即 DMA 可以安全覆盖的字节数
+   * （未解析数据之外的部分）。
+   *
    * @return 总空闲字节数
    */
   size_t available_space() const noexcept { return buffer.space(); }
@@ -550,14 +1055,7 @@ public:
           available_bytes -= scan_offset;
         }
 
-        ParseResult result = ParseResult::Incomplete;
-
-        // 使用 tuple_switch 动态分发到编译期生成的 Worker
-        Details::runtime_get(worker_idx, WorkerTuple{},
-                             [&](auto worker_instance) {
-                               using WorkerType = decltype(worker_instance);
-                               result = this->parse_frame_impl<WorkerType>();
-                             });
+        const ParseResult result = parse_candidates(worker_idx);
 
         if (result == ParseResult::Success) {
           monitor_.on_packet_received();
@@ -588,22 +1086,124 @@ public:
     return {};
   }
 
+  /**
+   * @brief 在连续内存的起始处识别一帧（不修改解析器状态）
+   *
+   * 与 try_parse_packets 在同一位置的判定完全一致：起始字节对应的候选协议
+   * 依次尝试，首个未失败的候选决定结果（Frame 或 Incomplete），
+   * 全部失败为 Invalid。
+   * 用于在原始数据上离线定位帧（参见 OfflineParser）。
+   *
+   * @tparam VerifyTail 为 false 时，帧尾为 ProtocolCRC16 的协议跳过帧尾校验并置位
+   *         tail_pending，由调用方批量校验（CrcBatch）；校验失败时须以
+   *         probe<true> 重新判定（可能匹配共享起始字节的其他协议）
+   * @param data 以候选起始字节开头的数据（可以比一帧长）
+   */
+  template <bool VerifyTail = true>
+  static FrameProbe probe(std::span<const uint8_t> data) noexcept {
+    FrameProbe out;
+    if (data.empty()) {
+      out.status = FrameProbe::Status::Incomplete;
+      return out;
+    }
+    uint8_t worker_idx = header_lut[data[0]];
+    if (worker_idx == 0xFF)
+      return out;
+
+    const Details::FlatView view{data};
+    do {
+      ParseResult result = ParseResult::Failure;
+      Details::runtime_get(
+          worker_idx, WorkerTuple{}, [&](auto worker_instance) {
+            using WorkerType = decltype(worker_instance);
+            FrameInfo info;
+            result = check_frame<WorkerType, VerifyTail>(view, info);
+            if (result == ParseResult::Success) {
+              out.tail_pending =
+                  !VerifyTail && deferrable_tail<typename WorkerType::Protocol>;
+              out.cmd = info.cmd;
+              out.header_size = WorkerType::Protocol::header_size;
+              out.size = static_cast<uint32_t>(info.total_len);
+              out.payload_size = static_cast<uint32_t>(info.data_len);
+            }
+          });
+      if (result == ParseResult::Success) {
+        out.status = FrameProbe::Status::Frame;
+        out.protocol = worker_idx;
+        return out;
+      }
+      if (result == ParseResult::Incomplete) {
+        out.status = FrameProbe::Status::Incomplete;
+        return out;
+      }
+      worker_idx = next_candidate[worker_idx];
+    } while (worker_idx != 0xFF);
+    return out;
+  }
+
 private:
-  // --- 通用帧解析实现 ---
-  template <typename Worker> ParseResult parse_frame_impl() {
+  /**
+   * @brief 依次尝试起始字节对应的候选协议
+   *
+   * 只有候选失败才尝试下一个；候选数据不完整时即等待更多数据，
+   * 不让区分能力更弱的候选抢先匹配一帧的前缀，
+   * 使结果与数据的分块方式无关。全部失败才丢弃起始字节。
+   */
+  ParseResult parse_candidates(uint8_t worker_idx) {
+    ParseResult result = ParseResult::Failure;
+    do {
+      // 使用 tuple_switch 动态分发到编译期生成的 Worker
+      Details::runtime_get(worker_idx, WorkerTuple{},
+                           [&](auto worker_instance) {
+                             using WorkerType = decltype(worker_instance);
+                             result = this->parse_frame_impl<WorkerType>();
+                           });
+      if constexpr (!has_shared_start_bytes) {
+        return result;
+      }
+      if (result != ParseResult::Failure)
+        return result;
+      worker_idx = next_candidate[worker_idx];
+    } while (worker_idx != 0xFF);
+    return ParseResult::Failure;
+  }
+
+  /// @brief 帧尾可由调用方批量校验的协议（2 字节 ProtocolCRC16）
+  template <typename P>
+  static constexpr bool deferrable_tail =
+      P::tail_size == 2 &&
+      std::is_same_v<typename P::RPL_CRC, RPL::ProtocolCRC16>;
+
+  /// @brief 通过校验的帧：命令码、长度与分段视图
+  struct FrameInfo {
+    uint16_t cmd = 0;
+    size_t data_len = 0;
+    size_t total_len = 0;
+    std::span<const uint8_t> s1, s2;
+  };
+
+  /**
+   * @brief 在 view 的起始处按 Worker 的协议校验一帧（不修改 view）
+   *
+   * view 可以是接收缓冲区，也可以是连续内存（Details::FlatView）；
+   * try_parse_packets 与 probe 共用此判定。
+   * VerifyTail 为 false 时跳过 deferrable_tail 协议的帧尾校验。
+   */
+  template <typename Worker, bool VerifyTail = true, typename View>
+  static ParseResult check_frame(const View &view, FrameInfo &info) {
     using P = typename Worker::Protocol;
 
-    if (buffer.available() < P::header_size)
+    if (view.available() < P::header_size)
       return ParseResult::Incomplete;
 
     // 获取帧头指针，尽量避免拷贝
     uint8_t header_stack_copy[P::header_size];
     const uint8_t *header_ptr = nullptr;
-    auto [hs1, hs2] = buffer.get_read_spans(0, P::header_size);
+    auto [hs1, hs2] = view.get_read_spans(0, P::header_size);
     if (hs2.empty()) {
       header_ptr = hs1.data();
     } else {
-      buffer.peek(header_stack_copy, 0, P::header_size);
+      view.peek(header_stack_copy, 0, P::header_size);
       header_ptr = header_stack_copy;
     }
 
@@ -638,14 +1238,19 @@ private:
         return ParseResult::Failure;
     }
 
+    if constexpr (Impl::template shares_start_byte<Worker>) {
+      if (!Impl::template accepts_frame<Worker>(cmd_id, data_len))
+        return ParseResult::Failure;
+    }
+
     size_t total_len = P::header_size + data_len + P::tail_size;
-    if (buffer.available() < total_len)
+    if (view.available() < total_len)
       return ParseResult::Incomplete;
 
     // 获取分段读视图
-    auto [s1, s2] = buffer.get_read_spans(0, total_len);
+    const auto [s1, s2] = view.get_read_spans(0, total_len);
 
-    if constexpr (P::tail_size > 0) {
+    if constexpr (P::tail_size > 0 && (VerifyTail || !deferrable_tail<P>)) {
       size_t calc_len = total_len - P::tail_size;
       uint16_t calc_crc = 0;
 
@@ -670,6 +1275,28 @@ private:
         return ParseResult::Failure;
     }
 
+    info.cmd = cmd_id;
+    info.data_len = data_len;
+    info.total_len = total_len;
+    info.s1 = s1;
+    info.s2 = s2;
+    return ParseResult::Success;
+  }
+
+  // --- 通用帧解析实现 ---
+  template <typename Worker> ParseResult parse_frame_impl() {
+    using P = typename Worker::Protocol;
+
+    FrameInfo info;
+    if (const ParseResult r = check_frame<Worker>(buffer, info);
+        r != ParseResult::Success)
+      return r;
+    const uint16_t cmd_id = info.cmd;
+    const size_t data_len = info.data_len;
+    const size_t total_len = info.total_len;
+    const auto s1 = info.s1;
+    const auto s2 = info.s2;
+
     // 反序列化 (分段拷贝)
     std::span<const uint8_t> payload_s1, payload_s2;
 
@@ -686,15 +1313,20 @@ private:
       payload_s2 = s2.subspan(P::header_size - s1.size(), data_len);
     }
 
-    bool skip_pool = false;
-    Details::PacketDispatcher<DeserializerType,
-                              typename Extracted::Packets>::dispatch(
-        cmd_id, payload_s1, payload_s2, deserializer, skip_pool);
-
-    if (!skip_pool) {
-      deserializer.write_segmented(cmd_id, payload_s1, payload_s2);
+    if (frame_hook_.fn) {
+      RawFrame frame{cmd_id, s1, s2, payload_s1, payload_s2};
+      if constexpr (Meta::protocol_has_seq<P>)
+        frame.seq = (P::seq_offset < s1.size()
+                         ? s1[P::seq_offset]
+                         : s2[P::seq_offset - s1.size()]);
+      if (!frame_hook_.fn(frame_hook_.ctx, frame)) {
+        buffer.discard(total_len);
+        return ParseResult::Success;
+      }
     }
 
+    dispatch(cmd_id, payload_s1, payload_s2);
+
     // 统一丢弃
     buffer.discard(total_len);
     return ParseResult::Success;
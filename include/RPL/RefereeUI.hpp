@@ -0,0 +1,504 @@
+/**
+ * @file RefereeUI.hpp
+ * @brief RPL 裁判系统客户端 UI 保留模式绘制层
+ *
+ * 此文件提供 RefereeUI，用于以“声明期望状态”的方式绘制选手端 UI：
+ * 调用者只描述每个图形/字符当前应有的样子，RefereeUI 与上次已发出的状态
+ * 比较，只发送发生变化的部分，并把多个图形合并进尽量少的 0x0301 帧。
+ *
+ * @par 设计原理
+ * - 以 3 字节图形名为键保存期望状态（线格式字节），逐字节比较判断是否变化
+ * - 未上屏的图形发送“增加”，已上屏且变化的发送“修改”，移除的发送“删除”
+ * - 待发图形按数量选择 1 / 2 / 5 / 7 图形帧（0x0101-0x0104），空位填空操作
+ * - 删除图层优先于图形与字符发送；图形与字符交替发送，互不饿死
+ * - 两帧之间至少间隔 min_interval 个 tick，控制 0x0301 发送频率
+ *
+ * @par 使用场景
+ * - 选手端准星、状态条、文字提示等周期性刷新的 UI
+ * - 选手端重连后通过 invalidate_all() 整体重绘
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_REFEREE_UI_HPP
+#define RPL_REFEREE_UI_HPP
+
+#include "Meta/BitView.hpp"
+#include "Packets/RoboMaster/InteractionFigure.hpp"
+#include "Packets/RoboMaster/InteractionFigureBatch.hpp"
+#include "Packets/RoboMaster/InteractionLayerDelete.hpp"
+#include "Packets/RoboMaster/InteractionString.hpp"
+#include "Packets/RoboMaster/RobotInteractionData.hpp"
+#include "Utils/ConnectionMonitor.hpp"
+#include "Utils/Error.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tl/expected.hpp>
+
+namespace RPL {
+
+/**
+ * @brief 裁判系统客户端 UI 保留模式绘制层
+ *
+ * @tparam TickProvider 时间戳提供器，需满足 TickProviderConcept
+ * @tparam MaxFigures 最多同时管理的图形数
+ * @tparam MaxStrings 最多同时管理的字符图形数
+ *
+ * @par 使用示例
+ * @code
+ * RPL::Serializer<RobotInteractionData> serializer;
+ * RPL::RefereeUI<HALTickProvider> ui{robot_id, client_id, 34}; // ~30Hz
+ *
+ * // 每个控制周期声明期望状态
+ * InteractionFigure bar{};
+ * bar.figure_name = {'h', 'p', '0'};
+ * bar.figure_type = 0;
+ * bar.details_d = 960 + hp_ratio * 200;
+ * ui.set_figure(bar);
+ *
+ * // 发送时机到达时取出一帧
+ * uint8_t buf[128];
+ * if (auto len = ui.poll(serializer, buf, sizeof(buf)); len && *len > 0) {
+ *     uart_send(buf, *len);
+ * }
+ * @endcode
+ */
+template <TickProviderConcept TickProvider, size_t MaxFigures = 32,
+          size_t MaxStrings = 8>
+class RefereeUI {
+public:
+  using tick_type = typename TickProvider::tick_type;
+  using FigureName = std::array<uint8_t, 3>;
+
+  /// @brief 图形操作类型（InteractionFigure::operate_type）
+  enum class Operation : uint8_t {
+    None = 0,
+    Add = 1,
+    Modify = 2,
+    Delete = 3,
+  };
+
+  static constexpr size_t max_layer = 9; ///< 图层编号上限
+
+  /**
+   * @brief 构造 UI 绘制层
+   *
+   * @param sender_id 发送者（本机器人）ID
+   * @param receiver_id 接收者（选手端）ID
+   * @param min_interval 两次发送之间的最小 tick 间隔
+   */
+  RefereeUI(uint16_t sender_id, uint16_t receiver_id,
+            tick_type min_interval) noexcept
+      : header_{0, sender_id, receiver_id}, min_interval_(min_interval) {}
+
+  /**
+   * @brief 声明一个图形的期望状态
+   *
+   * 以 figure_name 为键；operate_type 被忽略，由 RefereeUI 决定。
+   * 与上次发出的内容相同时不会产生任何发送。
+   *
+   * @param figure 图形
+   * @return 图形表已满时返回 false
+   */
+  bool set_figure(const InteractionFigure &figure) noexcept {
+    Wire wire{};
+    serialize_bitstream<InteractionFigure>(wire, figure);
+    set_operation(wire, Operation::None);
+    return store(figures_, wire);
+  }
+
+  /**
+   * @brief 移除一个图形
+   *
+   * 已上屏的图形会发送删除操作；尚未发送的图形直接丢弃。
+   *
+   * @param name 图形名
+   * @return 图形不存在时返回 false
+   */
+  bool remove_figure(const FigureName &name) noexcept {
+    return remove(figures_, name);
+  }
+
+  /**
+   * @brief 声明一个字符图形的期望状态
+   *
+   * 以 graphic_data 中的图形名为键，比较配置与文本内容。
+   *
+   * @param text 字符图形
+   * @return 字符表已满时返回 false
+   */
+  bool set_string(const InteractionString &text) noexcept {
+    TextWire wire{};
+    std::copy(text.graphic_data.begin(), text.graphic_data.end(),
+              wire.begin());
+    std::copy(text.data.begin(), text.data.end(),
+              wire.begin() + text.graphic_data.size());
+    set_operation(wire, Operation::None);
+    return store(strings_, wire);
+  }
+
+  /**
+   * @brief 移除一个字符图形
+   * @param name 图形名
+   * @return 字符图形不存在时返回 false
+   */
+  bool remove_string(const FigureName &name) noexcept {
+    return remove(strings_, name);
+  }
+
+  /**
+   * @brief 删除整个图层
+   *
+   * 该图层上的图形与字符从期望状态中移除，并排队一条删除图层指令。
+   *
+   * @param layer 图层编号 (0-9)
+   */
+  void delete_layer(uint8_t layer) noexcept {
+    if (layer > max_layer)
+      return;
+    drop_layer(figures_, layer);
+    drop_layer(strings_, layer);
+    if (!pending_clear_all_)
+      pending_layers_ |= static_cast<uint16_t>(1U << layer);
+  }
+
+  /**
+   * @brief 删除全部图形
+   *
+   * 清空期望状态并排队一条“删除所有”指令。
+   */
+  void clear() noexcept {
+    for (auto &slot : figures_)
+      slot = {};
+    for (auto &slot : strings_)
+      slot = {};
+    pending_layers_ = 0;
+    pending_clear_all_ = true;
+  }
+
+  /**
+   * @brief 使所有已发送状态失效
+   *
+   * 用于选手端重连等客户端状态丢失的场景：所有图形与字符在后续 poll 中
+   * 以“增加”重新发送，待删除的项目直接丢弃。
+   */
+  void invalidate_all() noexcept {
+    invalidate(figures_);
+    invalidate(strings_);
+    pending_layers_ = 0;
+    pending_clear_all_ = false;
+  }
+
+  /**
+   * @brief 待发送的操作数
+   * @return 待发图形数 + 待发字符数 + 待发删除图层指令数
+   */
+  [[nodiscard]] size_t pending() const noexcept {
+    size_t count = static_cast<size_t>(std::popcount(pending_layers_)) +
+                   (pending_clear_all_ ? 1 : 0);
+    for (const auto &slot : figures_)
+      count += slot.dirty ? 1 : 0;
+    for (const auto &slot : strings_)
+      count += slot.dirty ? 1 : 0;
+    return count;
+  }
+
+  /**
+   * @brief 下次允许发送的时刻
+   * @return 上次发送时刻 + min_interval（尚未发送过时为当前时刻）
+   */
+  [[nodiscard]] tick_type next_deadline() const noexcept {
+    if (!has_sent_)
+      return static_cast<tick_type>(TickProvider::now());
+    return static_cast<tick_type>(last_send_ + min_interval_);
+  }
+
+  /**
+   * @brief 取出下一帧
+   *
+   * 发送间隔未到或没有待发内容时返回 0；否则把一帧写入 buffer，
+   * 并将其中的项目标记为已发送。
+   *
+   * @tparam Ser Serializer 类型（需可序列化 RobotInteractionData）
+   * @param serializer 序列化器
+   * @param buffer 输出缓冲区
+   * @param size 缓冲区大小
+   * @return 写入的字节数，或缓冲区不足等错误（此时状态不变）
+   */
+  template <typename Ser>
+  tl::expected<size_t, Error> poll(Ser &serializer, uint8_t *buffer,
+                                   size_t size) {
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    if (has_sent_ &&
+        static_cast<tick_type>(now - last_send_) < min_interval_)
+      return 0;
+
+    tl::expected<size_t, Error> result = 0;
+    if (pending_clear_all_ || pending_layers_ != 0) {
+      result = emit_layer_delete(serializer, buffer, size);
+    } else {
+      const bool has_figures = any_dirty(figures_);
+      const bool has_strings = any_dirty(strings_);
+      if (has_strings && (!has_figures || prefer_strings_)) {
+        result = emit_string(serializer, buffer, size);
+        prefer_strings_ = false;
+      } else if (has_figures) {
+        result = emit_figures(serializer, buffer, size);
+        prefer_strings_ = true;
+      }
+    }
+
+    if (result && *result > 0) {
+      last_send_ = now;
+      has_sent_ = true;
+    }
+    return result;
+  }
+
+private:
+  using Wire = std::array<uint8_t, InteractionFigureBatch<2>::figure_size>;
+  using TextWire =
+      std::array<uint8_t, Meta::PacketTraits<InteractionString>::size>;
+
+  template <typename W> struct Slot {
+    W wire{};              ///< 期望状态（operate_type 为 0）
+    bool used = false;     ///< 槽位已占用
+    bool on_client = false; ///< 已在选手端显示
+    bool dirty = false;    ///< 有待发送的操作
+    bool deleting = false; ///< 待发送删除
+  };
+
+  using FigureSlots = std::array<Slot<Wire>, MaxFigures>;
+  using StringSlots = std::array<Slot<TextWire>, MaxStrings>;
+
+  static constexpr size_t max_batch = 7;
+
+  // --- 图形配置字段访问（字符图形的前 15 字节与图形格式相同） ---
+  template <typename W>
+  static void set_operation(W &wire, Operation op) noexcept {
+    BitRef<InteractionFigure>{std::span<uint8_t>(wire.data(), 15)}
+        .template set<1>(static_cast<uint32_t>(op));
+  }
+
+  template <typename W> static uint32_t layer_of(const W &wire) noexcept {
+    return BitView<InteractionFigure>{std::span<const uint8_t>(wire.data(),
+                                                               15)}
+        .template get<3>();
+  }
+
+  template <typename W>
+  static bool name_equals(const W &wire, const FigureName &name) noexcept {
+    return std::equal(name.begin(), name.end(), wire.begin());
+  }
+
+  template <typename Slots>
+  static auto *find(Slots &slots, const FigureName &name) noexcept {
+    for (auto &slot : slots) {
+      if (slot.used && name_equals(slot.wire, name))
+        return &slot;
+    }
+    return static_cast<typename Slots::value_type *>(nullptr);
+  }
+
+  template <typename Slots, typename W>
+  static bool store(Slots &slots, const W &wire) noexcept {
+    FigureName name{};
+    std::copy_n(wire.begin(), name.size(), name.begin());
+
+    auto *slot = find(slots, name);
+    if (slot) {
+      if (slot->wire == wire && !slot->deleting)
+        return true;
+      slot->wire = wire;
+      slot->deleting = false;
+      slot->dirty = true;
+      return true;
+    }
+
+    for (auto &free_slot : slots) {
+      if (!free_slot.used) {
+        free_slot = {};
+        free_slot.wire = wire;
+        free_slot.used = true;
+        free_slot.dirty = true;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Slots>
+  static bool remove(Slots &slots, const FigureName &name) noexcept {
+    auto *slot = find(slots, name);
+    if (!slot)
+      return false;
+    if (slot->on_client) {
+      slot->deleting = true;
+      slot->dirty = true;
+    } else {
+      *slot = {};
+    }
+    return true;
+  }
+
+  template <typename Slots>
+  static void drop_layer(Slots &slots, uint8_t layer) noexcept {
+    for (auto &slot : slots) {
+      if (slot.used && layer_of(slot.wire) == layer)
+        slot = {};
+    }
+  }
+
+  template <typename Slots> static void invalidate(Slots &slots) noexcept {
+    for (auto &slot : slots) {
+      if (!slot.used)
+        continue;
+      if (slot.deleting) {
+        slot = {};
+      } else {
+        slot.on_client = false;
+        slot.dirty = true;
+      }
+    }
+  }
+
+  template <typename Slots>
+  static bool any_dirty(const Slots &slots) noexcept {
+    return std::any_of(slots.begin(), slots.end(),
+                       [](const auto &slot) { return slot.dirty; });
+  }
+
+  /// @brief 生成待发送的线格式（填入操作类型）
+  template <typename S> static auto outgoing(const S &slot) noexcept {
+    auto wire = slot.wire;
+    set_operation(wire, slot.deleting    ? Operation::Delete
+                        : slot.on_client ? Operation::Modify
+                                         : Operation::Add);
+    return wire;
+  }
+
+  /// @brief 发送成功后更新槽位状态
+  template <typename S> static void mark_sent(S &slot) noexcept {
+    if (slot.deleting) {
+      slot = {};
+    } else {
+      slot.on_client = true;
+      slot.dirty = false;
+    }
+  }
+
+  /// @brief 选择能容纳 count 个图形的最小批量帧
+  static constexpr size_t batch_for(size_t count) noexcept {
+    return count <= 1 ? 1 : count == 2 ? 2 : count <= 5 ? 5 : 7;
+  }
+
+  template <typename Ser>
+  tl::expected<size_t, Error> emit_layer_delete(Ser &serializer,
+                                                uint8_t *buffer,
+                                                size_t size) {
+    InteractionLayerDelete cmd{};
+    uint16_t bit = 0;
+    if (pending_clear_all_) {
+      cmd.delete_type = 2;
+    } else {
+      const auto layer = static_cast<uint8_t>(std::countr_zero(pending_layers_));
+      cmd.delete_type = 1;
+      cmd.layer = layer;
+      bit = static_cast<uint16_t>(1U << layer);
+    }
+
+    auto result = serializer.serialize_sub(buffer, size, header_, cmd);
+    if (result) {
+      if (pending_clear_all_)
+        pending_clear_all_ = false;
+      else
+        pending_layers_ &= static_cast<uint16_t>(~bit);
+    }
+    return result;
+  }
+
+  template <typename Ser>
+  tl::expected<size_t, Error> emit_string(Ser &serializer, uint8_t *buffer,
+                                          size_t size) {
+    auto it = std::find_if(strings_.begin(), strings_.end(),
+                           [](const auto &slot) { return slot.dirty; });
+    const auto wire = outgoing(*it);
+
+    InteractionString text{};
+    std::copy_n(wire.begin(), text.graphic_data.size(),
+                text.graphic_data.begin());
+    std::copy_n(wire.begin() + text.graphic_data.size(), text.data.size(),
+                text.data.begin());
+
+    auto result = serializer.serialize_sub(buffer, size, header_, text);
+    if (result)
+      mark_sent(*it);
+    return result;
+  }
+
+  template <typename Ser>
+  tl::expected<size_t, Error> emit_figures(Ser &serializer, uint8_t *buffer,
+                                           size_t size) {
+    std::array<size_t, max_batch> picked{};
+    size_t count = 0;
+    for (size_t i = 0; i < figures_.size() && count < max_batch; ++i) {
+      if (figures_[i].dirty)
+        picked[count++] = i;
+    }
+
+    tl::expected<size_t, Error> result = 0;
+    switch (batch_for(count)) {
+    case 1: {
+      const auto wire = outgoing(figures_[picked[0]]);
+      result = serializer.serialize_sub(
+          buffer, size, header_,
+          deserialize_bitstream<InteractionFigure>(wire));
+      break;
+    }
+    case 2:
+      result = emit_batch<2>(serializer, buffer, size, picked, count);
+      break;
+    case 5:
+      result = emit_batch<5>(serializer, buffer, size, picked, count);
+      break;
+    default:
+      result = emit_batch<7>(serializer, buffer, size, picked, count);
+      break;
+    }
+
+    if (result) {
+      for (size_t i = 0; i < count; ++i)
+        mark_sent(figures_[picked[i]]);
+    }
+    return result;
+  }
+
+  template <size_t N, typename Ser>
+  tl::expected<size_t, Error>
+  emit_batch(Ser &serializer, uint8_t *buffer, size_t size,
+             const std::array<size_t, max_batch> &picked, size_t count) {
+    InteractionFigureBatch<N> batch{};
+    for (size_t i = 0; i < count; ++i)
+      batch.figures[i] = outgoing(figures_[picked[i]]);
+    return serializer.serialize_sub(buffer, size, header_, batch);
+  }
+
+  RobotInteractionHeader header_;
+  tick_type min_interval_;
+  tick_type last_send_{};
+  bool has_sent_ = false;
+  bool prefer_strings_ = false;
+  bool pending_clear_all_ = false;
+  uint16_t pending_layers_ = 0; ///< 待删除图层位图
+
+  FigureSlots figures_{};
+  StringSlots strings_{};
+};
+
+} // namespace RPL
+
+#endif // RPL_REFEREE_UI_HPP
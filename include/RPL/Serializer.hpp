@@ -12,10 +12,13 @@
 #define RPL_SERIALIZER_HPP
 
 #include "Meta/BitstreamSerializer.hpp"
+#include "Meta/FrameTemplate.hpp"
 #include "Meta/PacketTraits.hpp"
 #include "Utils/Def.hpp"
 #include "Utils/Error.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <optional>
@@ -92,95 +95,23 @@ public:
                                         const Packets &...packets) {
     size_t offset = 0;
 
-    static constexpr size_t total_size = (frame_size<Packets>() + ...);
-    if (size < total_size) {
-      return tl::make_unexpected(
-          Error{ErrorCode::BufferOverflow, "Expecting a larger size buffer"});
+    if constexpr ((Meta::HasVariableLength<std::decay_t<Packets>> || ...)) {
+      const size_t total_size = (frame_size(packets) + ...);
+      if (size < total_size) {
+        return tl::make_unexpected(
+            Error{ErrorCode::BufferOverflow, "Expecting a larger size buffer"});
+      }
+    } else {
+      static constexpr size_t total_size = (frame_size<Packets>() + ...);
+      if (size < total_size) {
+        return tl::make_unexpected(
+            Error{ErrorCode::BufferOverflow, "Expecting a larger size buffer"});
+      }
     }
 
     auto serialize_one = [&]<typename T>(const T &packet) {
       using DecayedT = std::decay_t<T>;
-      using Protocol = typename Meta::PacketTraits<DecayedT>::Protocol;
-      constexpr uint16_t cmd = Meta::PacketTraits<DecayedT>::cmd;
-      constexpr size_t data_size = Meta::PacketTraits<DecayedT>::size;
-      constexpr size_t current_frame_size = frame_size<DecayedT>();
-
-      uint8_t *current_buffer = buffer + offset;
-
-      // 帧头 (起始字节)
-      current_buffer[0] = Protocol::start_byte;
-      if constexpr (Protocol::has_second_byte) {
-        current_buffer[1] = Protocol::second_byte;
-      }
-
-      // 长度字段
-      if constexpr (Protocol::has_length_field) {
-        const auto data_size_u16 = static_cast<uint16_t>(data_size);
-        // 长度字段采用小端格式
-        if constexpr (Protocol::length_field_bytes == 1) {
-          current_buffer[Protocol::length_offset] =
-              static_cast<uint8_t>(data_size_u16 & 0xFF);
-        } else {
-          current_buffer[Protocol::length_offset] =
-              static_cast<uint8_t>(data_size_u16 & 0xFF);
-          current_buffer[Protocol::length_offset + 1] =
-              static_cast<uint8_t>((data_size_u16 >> 8) & 0xFF);
-        }
-      }
-
-      // Sequence 字段
-      if constexpr (requires { Protocol::has_seq_field; }) {
-        if constexpr (Protocol::has_seq_field) {
-          current_buffer[Protocol::seq_offset] = m_Sequence;
-        }
-      }
-
-      // 帧头 CRC
-      if constexpr (Protocol::has_header_crc) {
-        // CRC8 覆盖从 0 到 header_crc_offset 的字节
-        const uint8_t header_crc8 =
-            ProtocolCRC8::calc(current_buffer, Protocol::header_crc_offset);
-        current_buffer[Protocol::header_crc_offset] = header_crc8;
-      }
-
-      // 命令 ID 字段
-      if constexpr (Protocol::has_cmd_field) {
-        // 命令字段采用小端格式
-        if constexpr (Protocol::cmd_field_bytes == 1) {
-          current_buffer[Protocol::cmd_offset] =
-              static_cast<uint8_t>(cmd & 0xFF);
-        } else {
-          current_buffer[Protocol::cmd_offset] =
-              static_cast<uint8_t>(cmd & 0xFF);
-          current_buffer[Protocol::cmd_offset + 1] =
-              static_cast<uint8_t>((cmd >> 8) & 0xFF);
-        }
-      }
-
-      // Data Payload
-      if constexpr (Meta::HasBitLayout<Meta::PacketTraits<DecayedT>>) {
-        std::memset(current_buffer + Protocol::header_size, 0, data_size);
-        serialize_bitstream<DecayedT>(
-            std::span<uint8_t>(current_buffer + Protocol::header_size,
-                               data_size),
-            packet);
-      } else {
-        std::memcpy(current_buffer + Protocol::header_size, &packet, data_size);
-      }
-
-      // 帧尾 (CRC)
-      if constexpr (Protocol::tail_size > 0) {
-        using FrameCRC = typename Protocol::RPL_CRC;
-        const uint16_t frame_crc16 =
-            FrameCRC::calc(current_buffer, Protocol::header_size + data_size);
-
-        current_buffer[Protocol::header_size + data_size] =
-            static_cast<uint8_t>(frame_crc16 & 0xFF);
-        current_buffer[Protocol::header_size + data_size + 1] =
-            static_cast<uint8_t>((frame_crc16 >> 8) & 0xFF);
-      }
-
-      offset += current_frame_size;
+      offset += write_frame<DecayedT>(buffer + offset, packet, m_Sequence);
     };
     (serialize_one(packets), ...);
 
@@ -188,6 +119,61 @@ public:
     return offset;
   }
 
+  /**
+   * @brief 将子包按父包格式序列化为一个完整帧
+   *
+   * 子头由 header 提供（如发送者/接收者 ID），其中的子命令码字段自动设置为
+   * PacketTraits<Sub>::cmd；长度字段只计入子头与子包数据。
+   * 序列号与 serialize() 共用并在成功后递增。
+   *
+   * @tparam Sub 子包类型（PacketTraits 定义了 Parent，且 Parent 可序列化）
+   * @param buffer 用户提供的输出缓冲区
+   * @param size 缓冲区大小
+   * @param header 父包子头
+   * @param packet 子包
+   * @return 序列化成功时返回写入的字节数，失败时返回错误信息
+   *
+   * @code
+   * RPL::Serializer<RobotInteractionData> serializer;
+   * InteractionFigure figure{...};
+   * auto len = serializer.serialize_sub(buf, sizeof(buf),
+   *                                     {.sender_id = 1, .receiver_id = 0x0101},
+   *                                     figure);
+   * @endcode
+   */
+  template <typename Sub>
+    requires Meta::IsSubPacket<Sub> &&
+             Serializable<typename Meta::PacketTraits<Sub>::Parent, Ts...>
+  tl::expected<size_t, Error> serialize_sub(
+      uint8_t *buffer, const size_t size,
+      const typename Meta::PacketTraits<
+          typename Meta::PacketTraits<Sub>::Parent>::SubHeader &header,
+      const Sub &packet) {
+    if (size < sub_frame_size<Sub>()) {
+      return tl::make_unexpected(
+          Error{ErrorCode::BufferOverflow, "Expecting a larger size buffer"});
+    }
+    write_sub_frame(buffer, header, packet, m_Sequence);
+    m_Sequence += 1;
+    return sub_frame_size<Sub>();
+  }
+
+  /**
+   * @brief 计算子包帧大小
+   *
+   * @tparam Sub 子包类型
+   * @return 父包帧头 + 子头 + 子包数据 + 帧尾
+   */
+  template <typename Sub>
+    requires Meta::IsSubPacket<Sub>
+  static constexpr size_t sub_frame_size() noexcept {
+    using Parent = typename Meta::PacketTraits<Sub>::Parent;
+    using Protocol = typename Meta::PacketTraits<Parent>::Protocol;
+    return Protocol::header_size +
+           Meta::PacketTraits<Parent>::sub_header_size +
+           Meta::PacketTraits<Sub>::size + Protocol::tail_size;
+  }
+
   /**
    * @brief 计算指定类型的完整帧大小
    *
@@ -205,6 +191,51 @@ public:
            Protocol::tail_size;
   }
 
+  /**
+   * @brief 计算指定数据包本次序列化的完整帧大小
+   *
+   * 定长包等于 frame_size<T>()；变长包只计入 wire_size() 个负载字节。
+   *
+   * @tparam T 数据包类型
+   * @param packet 数据包
+   * @return 完整帧大小（字节）
+   */
+  template <typename T>
+    requires Serializable<T, Ts...>
+  static constexpr size_t frame_size(const T &packet) noexcept {
+    using DecayedT = std::decay_t<T>;
+    using Protocol = typename Meta::PacketTraits<DecayedT>::Protocol;
+    return Protocol::header_size + Meta::payload_size<DecayedT>(packet) +
+           Protocol::tail_size;
+  }
+
+  /**
+   * @brief 在编译期构建完整帧
+   *
+   * 适用于内容固定的数据包（如固定指令）：帧在编译期生成并可放入只读存储区，
+   * 发送时直接交给传输层，无需任何运行时序列化开销。
+   *
+   * @tparam T 数据包类型
+   * @param packet 数据包（编译期常量）
+   * @param seq 写入帧头的序列号（默认 0）
+   * @return 完整帧字节
+   *
+   * @code
+   * static constexpr auto kStopFrame =
+   *     RPL::Serializer<MotorCmd>::make_frame(MotorCmd{0, 0});
+   * uart_send(kStopFrame.data(), kStopFrame.size());
+   * @endcode
+   */
+  template <typename T>
+    requires Serializable<T, Ts...> &&
+             (!Meta::HasVariableLength<std::decay_t<T>>)
+  static constexpr std::array<uint8_t, frame_size<T>()>
+  make_frame(const T &packet, uint8_t seq = 0) noexcept {
+    std::array<uint8_t, frame_size<T>()> frame{};
+    write_frame<std::decay_t<T>>(frame.data(), packet, seq);
+    return frame;
+  }
+
   /**
    * @brief 计算指定命令码的完整帧大小
    *
@@ -266,6 +297,97 @@ public:
   }
 
 private:
+  /**
+   * @brief 写入单个完整帧
+   *
+   * 帧头来自编译期模板，CRC8 查表获得，CRC16 从帧头常量前缀之后继续计算。
+   * 常量求值时使用 std::bit_cast 代替 memcpy，使 make_frame 可在编译期执行。
+   * 变长包只写入 wire_size() 个负载字节，并写入对应的长度字段。
+   *
+   * @return 写入的帧长度
+   */
+  template <typename T>
+  static constexpr size_t write_frame(uint8_t *dst, const T &packet,
+                                      uint8_t seq) noexcept {
+    using Template = Meta::FrameTemplate<T>;
+    constexpr size_t data_size = Template::data_size;
+    uint8_t *payload = dst + Template::header_size;
+    static_assert(!Meta::IsSubPacket<T>,
+                  "Sub-packets must be serialized with serialize_sub()");
+
+    if constexpr (Meta::HasVariableLength<T>) {
+      static_assert(Template::Protocol::has_length_field,
+                    "Variable-length packets require a length field");
+      static_assert(!Meta::HasBitLayout<Meta::PacketTraits<T>>,
+                    "Variable-length packets cannot use BitLayout");
+      const size_t data_len = Meta::payload_size<T>(packet);
+      Template::write_header(dst, seq, data_len);
+      std::memcpy(payload, &packet, data_len);
+      Template::write_tail(dst, data_len);
+      return Template::header_size + data_len + Template::tail_size;
+    } else {
+      Template::write_header(dst, seq);
+
+      if constexpr (Meta::HasBitLayout<Meta::PacketTraits<T>>) {
+        std::fill_n(payload, data_size, uint8_t{0});
+        serialize_bitstream<T>(std::span<uint8_t>(payload, data_size),
+                               packet);
+      } else if (std::is_constant_evaluated()) {
+        const auto bytes =
+            std::bit_cast<std::array<uint8_t, sizeof(T)>>(packet);
+        std::copy_n(bytes.begin(), data_size, payload);
+      } else {
+        std::memcpy(payload, &packet, data_size);
+      }
+
+      Template::write_tail(dst);
+      return Template::frame_size;
+    }
+  }
+
+  /// @brief 写入子包帧：父包帧头 + 子头 + 子包数据 + 帧尾
+  template <typename Sub>
+  static void write_sub_frame(
+      uint8_t *dst,
+      const typename Meta::PacketTraits<
+          typename Meta::PacketTraits<Sub>::Parent>::SubHeader &header,
+      const Sub &packet, uint8_t seq) noexcept {
+    using Parent = typename Meta::PacketTraits<Sub>::Parent;
+    using ParentTraits = Meta::PacketTraits<Parent>;
+    using Template = Meta::FrameTemplate<Parent>;
+    constexpr size_t sub_size = Meta::PacketTraits<Sub>::size;
+    constexpr size_t data_len = ParentTraits::sub_header_size + sub_size;
+    static_assert(sizeof(typename ParentTraits::SubHeader) ==
+                      ParentTraits::sub_header_size,
+                  "SubHeader size must equal sub_header_size");
+    static_assert(data_len <= ParentTraits::size,
+                  "Sub-packet does not fit in its Parent payload");
+    static_assert(Template::Protocol::has_length_field ||
+                      data_len == ParentTraits::size,
+                  "Sub-packet frames require a length field");
+
+    uint8_t *payload = dst + Template::header_size;
+    Template::write_header(dst, seq, data_len);
+
+    std::memcpy(payload, &header, ParentTraits::sub_header_size);
+    constexpr uint16_t sub_cmd = Meta::PacketTraits<Sub>::cmd;
+    payload[ParentTraits::sub_cmd_offset] =
+        static_cast<uint8_t>(sub_cmd & 0xFF);
+    payload[ParentTraits::sub_cmd_offset + 1] =
+        static_cast<uint8_t>(sub_cmd >> 8);
+
+    uint8_t *sub_payload = payload + ParentTraits::sub_header_size;
+    if constexpr (Meta::HasBitLayout<Meta::PacketTraits<Sub>>) {
+      std::fill_n(sub_payload, sub_size, uint8_t{0});
+      serialize_bitstream<Sub>(std::span<uint8_t>(sub_payload, sub_size),
+                               packet);
+    } else {
+      std::memcpy(sub_payload, &packet, sub_size);
+    }
+
+    Template::write_tail(dst, data_len);
+  }
+
   // 编译期命令码到类型映射的辅助函数
   template <uint16_t cmd, typename T, typename... Rest>
   static constexpr auto create_packet_by_cmd_impl() {
@@ -0,0 +1,424 @@
+/**
+ * @file TxScheduler.hpp
+ * @brief RPL 发送调度器
+ *
+ * 此文件提供 TxScheduler，按裁判系统的频率与带宽限制调度待发送的数据包，
+ * 避免超出上限后被裁判系统静默丢弃。
+ *
+ * @par 设计原理
+ * - 每个线上命令码一个令牌桶，速率取 PacketTraits::max_rate_hz；
+ *   子包与其父包（如 0x0301 的图形、字符）共享同一个命令码令牌桶
+ * - 每个带宽类别（PacketTraits::bandwidth_class）一个字节令牌桶和一个帧令牌桶，
+ *   限制同一链路上多个命令码的总速率，运行时通过 set_class_limit() 配置
+ * - 每个类型一个定长环形队列，溢出时按 PacketTraits::tx_policy 排队、合并或丢弃最旧
+ * - poll() 轮询各队列，写出所有当前允许发送的帧；next_deadline() 给出下一帧
+ *   可发送的时刻，调用者可据此精确休眠
+ *
+ * @par 使用场景
+ * - 向裁判系统发送 0x0301 / 0x0302 / 0x0308 等有频率上限的数据
+ * - 多个模块共享一条串口时的带宽分配
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_TX_SCHEDULER_HPP
+#define RPL_TX_SCHEDULER_HPP
+
+#include "Meta/PacketTraits.hpp"
+#include "Utils/ConnectionMonitor.hpp"
+#include "Utils/Error.hpp"
+#include "Utils/TokenBucket.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace RPL {
+
+/**
+ * @brief TxScheduler 编译期配置
+ *
+ * @tparam TicksPerSecond TickProvider 每秒 tick 数
+ * @tparam QueueDepth 每个类型的排队深度（Coalesce 策略恒为 1）
+ * @tparam ClassCount 带宽类别数量
+ */
+template <uint32_t TicksPerSecond = 1000, size_t QueueDepth = 4,
+          size_t ClassCount = 4>
+struct TxSchedulerConfig {
+  static constexpr uint32_t ticks_per_second = TicksPerSecond;
+  static constexpr size_t queue_depth = QueueDepth;
+  static constexpr size_t class_count = ClassCount;
+};
+
+namespace Details {
+
+/// @brief 数据包在线上使用的类型：子包为其父包，顶层包为自身
+template <typename T> struct WireType {
+  using type = T;
+};
+
+template <typename T>
+  requires Meta::IsSubPacket<T>
+struct WireType<T> {
+  using type = typename Meta::PacketTraits<T>::Parent;
+};
+
+template <typename T> using wire_type_t = typename WireType<T>::type;
+
+} // namespace Details
+
+/**
+ * @brief 发送调度器
+ *
+ * @tparam TickProvider 时间戳提供器，需满足 TickProviderConcept
+ * @tparam Config TxSchedulerConfig
+ * @tparam Ts 可调度的数据包类型（可包含子包）
+ *
+ * @par 使用示例
+ * @code
+ * RPL::Serializer<RobotInteractionData, CustomInfo> serializer;
+ * RPL::TxScheduler<HALTickProvider, InteractionFigure, CustomInfo> tx;
+ * tx.set_class_limit(0, 3000, 256);   // 整条链路 3000 B/s
+ *
+ * tx.submit(header, figure);
+ * tx.submit(info);
+ *
+ * uint8_t buf[256];
+ * if (auto len = tx.poll(serializer, buf, sizeof(buf)); len && *len > 0)
+ *     uart_send(buf, *len);
+ * if (auto deadline = tx.next_deadline())
+ *     sleep_until(*deadline);
+ * @endcode
+ */
+template <TickProviderConcept TickProvider, typename Config, typename... Ts>
+class BasicTxScheduler {
+public:
+  using tick_type = typename TickProvider::tick_type;
+
+  static constexpr size_t lane_count = sizeof...(Ts);
+  static constexpr uint32_t ticks_per_second = Config::ticks_per_second;
+
+  static_assert(lane_count > 0, "TxScheduler requires at least one packet");
+  static_assert(((Meta::PacketTraits<Details::wire_type_t<Ts>>::bandwidth_class <
+                  Config::class_count) &&
+                 ...),
+                "bandwidth_class exceeds TxSchedulerConfig::class_count");
+
+  /// @brief 构造调度器，命令码令牌桶按 max_rate_hz 初始化为满
+  BasicTxScheduler() noexcept {
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    init_rate_buckets(now, std::index_sequence_for<Ts...>{});
+  }
+
+  /**
+   * @brief 配置带宽类别的聚合限制
+   *
+   * @param cls 带宽类别
+   * @param bytes_per_second 字节速率（0 表示不限）
+   * @param burst_bytes 字节突发量
+   * @param frames_per_second 帧速率（0 表示不限）
+   */
+  void set_class_limit(uint8_t cls, uint32_t bytes_per_second,
+                       uint32_t burst_bytes,
+                       uint32_t frames_per_second = 0) noexcept {
+    if (cls >= Config::class_count)
+      return;
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    class_bytes_[cls] =
+        Bucket{bytes_per_second, burst_bytes, ticks_per_second, now};
+    class_frames_[cls] = Bucket{frames_per_second, 1, ticks_per_second, now};
+  }
+
+  /**
+   * @brief 提交一个顶层数据包
+   *
+   * @param packet 数据包
+   * @return Queue 策略下队列已满时返回 BufferOverflow
+   */
+  template <typename T>
+    requires(!Meta::IsSubPacket<T>) && (std::is_same_v<T, Ts> || ...)
+  tl::expected<void, Error> submit(const T &packet) {
+    return push(std::get<lane_index<T>()>(lanes_), packet);
+  }
+
+  /**
+   * @brief 提交一个子包
+   *
+   * @param header 父包子头（子命令码由序列化器填写）
+   * @param packet 子包
+   * @return Queue 策略下队列已满时返回 BufferOverflow
+   */
+  template <typename Sub>
+    requires Meta::IsSubPacket<Sub> && (std::is_same_v<Sub, Ts> || ...)
+  tl::expected<void, Error> submit(
+      const typename Meta::PacketTraits<
+          typename Meta::PacketTraits<Sub>::Parent>::SubHeader &header,
+      const Sub &packet) {
+    return push(std::get<lane_index<Sub>()>(lanes_),
+                SubEntry<Sub>{header, packet});
+  }
+
+  /**
+   * @brief 写出所有当前允许发送的帧
+   *
+   * 各类型队列轮流发送，直到没有可发送的帧或缓冲区放不下下一帧。
+   *
+   * @tparam Ser Serializer 类型（需能序列化各包的线上类型）
+   * @param serializer 序列化器
+   * @param buffer 输出缓冲区
+   * @param size 缓冲区大小
+   * @return 写入的字节数；有帧可发但缓冲区连一帧都放不下时返回 BufferOverflow
+   */
+  template <typename Ser>
+  tl::expected<size_t, Error> poll(Ser &serializer, uint8_t *buffer,
+                                   size_t size) {
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    size_t offset = 0;
+    bool too_small = false;
+
+    for (;;) {
+      bool sent = false;
+      tl::expected<size_t, Error> result = 0;
+      for (size_t k = 0; k < lane_count && !sent; ++k) {
+        const size_t i = (next_lane_ + k) % lane_count;
+        visit_lane(i, [&]<size_t I>(std::integral_constant<size_t, I>) {
+          auto &lane = std::get<I>(lanes_);
+          if (lane.count == 0)
+            return;
+          const auto &entry = lane.front();
+          const size_t frame = frame_size_of(entry);
+          if (!ready<I>(frame, now))
+            return;
+          if (frame > size - offset) {
+            too_small = true;
+            return;
+          }
+          result = emit(serializer, buffer + offset, size - offset, entry);
+          if (!result)
+            return;
+          consume<I>(frame);
+          lane.pop();
+          offset += *result;
+          next_lane_ = i + 1;
+          sent = true;
+        });
+        if (!result)
+          return tl::unexpected(result.error());
+      }
+      if (!sent)
+        break;
+    }
+
+    if (offset == 0 && too_small) {
+      return tl::make_unexpected(
+          Error{ErrorCode::BufferOverflow, "Expecting a larger size buffer"});
+    }
+    return offset;
+  }
+
+  /**
+   * @brief 下一帧可发送的时刻
+   *
+   * @return 没有待发帧时为空；已有帧可发时为当前时刻
+   */
+  [[nodiscard]] std::optional<tick_type> next_deadline() noexcept {
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    std::optional<tick_type> wait;
+    for (size_t i = 0; i < lane_count; ++i) {
+      visit_lane(i, [&]<size_t I>(std::integral_constant<size_t, I>) {
+        const auto &lane = std::get<I>(lanes_);
+        if (lane.count == 0)
+          return;
+        const tick_type w = wait_ticks<I>(frame_size_of(lane.front()), now);
+        if (!wait || w < *wait)
+          wait = w;
+      });
+    }
+    if (!wait)
+      return std::nullopt;
+    return static_cast<tick_type>(now + *wait);
+  }
+
+  /// @brief 所有队列中待发送的包数
+  [[nodiscard]] size_t pending() const noexcept {
+    return std::apply([](const auto &...lane) { return (lane.count + ...); },
+                      lanes_);
+  }
+
+  /// @brief 指定类型待发送的包数
+  template <typename T>
+    requires(std::is_same_v<T, Ts> || ...)
+  [[nodiscard]] size_t pending() const noexcept {
+    return std::get<lane_index<T>()>(lanes_).count;
+  }
+
+  /// @brief DropOldest 策略下因队列满被丢弃的包数
+  [[nodiscard]] uint32_t dropped() const noexcept { return dropped_; }
+
+  /// @brief Coalesce 策略下被新值覆盖的包数
+  [[nodiscard]] uint32_t coalesced() const noexcept { return coalesced_; }
+
+private:
+  using Bucket = TokenBucket<tick_type>;
+
+  template <typename Sub> struct SubEntry {
+    typename Meta::PacketTraits<
+        typename Meta::PacketTraits<Sub>::Parent>::SubHeader header;
+    Sub packet;
+  };
+
+  template <typename T> struct Lane {
+    using Entry =
+        std::conditional_t<Meta::IsSubPacket<T>, SubEntry<T>, T>;
+    static constexpr Meta::TxPolicy policy = Meta::PacketTraits<T>::tx_policy;
+    static constexpr size_t depth =
+        policy == Meta::TxPolicy::Coalesce ? 1 : Config::queue_depth;
+
+    std::array<Entry, depth> slots{};
+    size_t head = 0;
+    size_t count = 0;
+
+    const Entry &front() const noexcept { return slots[head]; }
+    void pop() noexcept {
+      head = (head + 1) % depth;
+      --count;
+    }
+  };
+
+  template <typename T> static constexpr size_t lane_index() noexcept {
+    constexpr std::array<bool, lane_count> match{std::is_same_v<T, Ts>...};
+    return static_cast<size_t>(
+        std::find(match.begin(), match.end(), true) - match.begin());
+  }
+
+  /// @brief 各类型的线上命令码
+  static constexpr std::array<uint16_t, lane_count> wire_cmds{
+      Meta::PacketTraits<Details::wire_type_t<Ts>>::cmd...};
+
+  /// @brief 各类型使用的命令码令牌桶下标（同命令码共享首个类型的桶）
+  static constexpr auto rate_bucket_of = []() {
+    std::array<size_t, lane_count> map{};
+    for (size_t i = 0; i < lane_count; ++i) {
+      map[i] = i;
+      for (size_t j = 0; j < i; ++j) {
+        if (wire_cmds[j] == wire_cmds[i]) {
+          map[i] = j;
+          break;
+        }
+      }
+    }
+    return map;
+  }();
+
+  template <size_t I>
+  using lane_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+  template <size_t I>
+  static constexpr uint8_t class_of =
+      Meta::PacketTraits<Details::wire_type_t<lane_type<I>>>::bandwidth_class;
+
+  template <size_t... I>
+  void init_rate_buckets(tick_type now, std::index_sequence<I...>) noexcept {
+    ((rate_buckets_[I] =
+          Bucket{Meta::PacketTraits<Details::wire_type_t<Ts>>::max_rate_hz, 1,
+                 ticks_per_second, now}),
+     ...);
+  }
+
+  template <typename Fn> static void visit_lane(size_t i, Fn &&fn) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((i == I ? fn(std::integral_constant<size_t, I>{}) : void()), ...);
+    }(std::index_sequence_for<Ts...>{});
+  }
+
+  template <typename T>
+  static size_t frame_size_of(const T &packet) noexcept {
+    using Protocol = typename Meta::PacketTraits<T>::Protocol;
+    return Protocol::header_size + Meta::payload_size<T>(packet) +
+           Protocol::tail_size;
+  }
+
+  template <typename Sub>
+  static size_t frame_size_of(const SubEntry<Sub> &) noexcept {
+    using ParentTraits =
+        Meta::PacketTraits<typename Meta::PacketTraits<Sub>::Parent>;
+    using Protocol = typename ParentTraits::Protocol;
+    return Protocol::header_size + ParentTraits::sub_header_size +
+           Meta::PacketTraits<Sub>::size + Protocol::tail_size;
+  }
+
+  template <typename Ser, typename T>
+  static tl::expected<size_t, Error> emit(Ser &serializer, uint8_t *dst,
+                                          size_t size, const T &packet) {
+    return serializer.serialize(dst, size, packet);
+  }
+
+  template <typename Ser, typename Sub>
+  static tl::expected<size_t, Error>
+  emit(Ser &serializer, uint8_t *dst, size_t size,
+       const SubEntry<Sub> &entry) {
+    return serializer.serialize_sub(dst, size, entry.header, entry.packet);
+  }
+
+  template <size_t I> bool ready(size_t frame, tick_type now) noexcept {
+    return rate_buckets_[rate_bucket_of[I]].available(1, now) &&
+           class_frames_[class_of<I>].available(1, now) &&
+           class_bytes_[class_of<I>].available(
+               static_cast<uint32_t>(frame), now);
+  }
+
+  template <size_t I> void consume(size_t frame) noexcept {
+    rate_buckets_[rate_bucket_of[I]].consume(1);
+    class_frames_[class_of<I>].consume(1);
+    class_bytes_[class_of<I>].consume(static_cast<uint32_t>(frame));
+  }
+
+  template <size_t I> tick_type wait_ticks(size_t frame, tick_type now) {
+    return std::max({rate_buckets_[rate_bucket_of[I]].wait_ticks(1, now),
+                     class_frames_[class_of<I>].wait_ticks(1, now),
+                     class_bytes_[class_of<I>].wait_ticks(
+                         static_cast<uint32_t>(frame), now)});
+  }
+
+  template <typename L, typename E>
+  tl::expected<void, Error> push(L &lane, const E &entry) {
+    if (lane.count == L::depth) {
+      if constexpr (L::policy == Meta::TxPolicy::Queue) {
+        return tl::make_unexpected(
+            Error{ErrorCode::BufferOverflow, "TX queue full"});
+      } else {
+        lane.pop();
+        if constexpr (L::policy == Meta::TxPolicy::Coalesce) {
+          ++coalesced_;
+        } else {
+          ++dropped_;
+        }
+      }
+    }
+    lane.slots[(lane.head + lane.count) % L::depth] = entry;
+    ++lane.count;
+    return {};
+  }
+
+  std::tuple<Lane<Ts>...> lanes_{};
+  std::array<Bucket, lane_count> rate_buckets_{};
+  std::array<Bucket, Config::class_count> class_bytes_{};
+  std::array<Bucket, Config::class_count> class_frames_{};
+  size_t next_lane_ = 0; ///< 轮询起点
+  uint32_t dropped_ = 0;
+  uint32_t coalesced_ = 0;
+};
+
+/**
+ * @brief 使用默认配置（1 tick = 1 ms，队列深度 4，4 个带宽类别）的发送调度器
+ */
+template <TickProviderConcept TickProvider, typename... Ts>
+using TxScheduler = BasicTxScheduler<TickProvider, TxSchedulerConfig<>, Ts...>;
+
+} // namespace RPL
+
+#endif // RPL_TX_SCHEDULER_HPP
@@ -2,11 +2,15 @@
 #define RPL_USB_TRANSPORT_HPP
 
 #include "RPL/Deserializer.hpp"
+#include "RPL/Packets/USBAck.hpp"
 #include "RPL/Parser.hpp"
 #include "RPL/Serializer.hpp"
 #include "RPL/Utils/AckManager.hpp"
+#include <concepts>
 #include <cstdint>
+#include <span>
 #include <tl/expected.hpp>
+#include <type_traits>
 
 namespace RPL {
 namespace detail {
@@ -14,17 +18,165 @@ struct NoSend {
   void operator()(const uint8_t *, size_t) const {}
   explicit operator bool() const { return false; }
 };
+
+/// @brief 仅用于检测 AckMgr::retransmit 接口的发送回调签名
+inline bool accept_all(const uint8_t *, size_t) { return true; }
 } // namespace detail
 
-template <typename AckMgr, typename SendFunc, typename... Packets>
-class USBTransport {
+/**
+ * @brief 空发送队列（默认）：帧在 notify/request 中立即发送
+ */
+struct NullTxQueue {};
+
+/**
+ * @brief 发送队列概念
+ *
+ * 作为 USBTransport 数据包列表之前的可选参数，帧按 PacketTraits::tx_priority
+ * 入队，drain_tx() 总是先发送最紧急的帧（见 Containers::PriorityTxQueue）。
+ *
+ * @tparam Q 要检查的类型
+ */
+template <typename Q>
+concept TxQueueConcept =
+    requires(Q &q, const Q &cq, uint8_t priority, const uint8_t *data,
+             size_t size) {
+      { q.push(priority, data, size) } -> std::same_as<tl::expected<void, Error>>;
+      { cq.empty() } -> std::convertible_to<bool>;
+      { cq.front() } -> std::convertible_to<std::span<const uint8_t>>;
+      q.pop();
+    };
+
+/**
+ * @brief 空发送合并器（默认）：每帧一次发送回调
+ */
+struct NullTxCoalescer {};
+
+/**
+ * @brief 发送合并器概念
+ *
+ * 作为 USBTransport 数据包列表之前的可选参数，把多个帧拼接为一次端点大小的
+ * 传输（见 Containers::TxCoalescer）。
+ *
+ * @tparam C 要检查的类型
+ */
+template <typename C>
+concept TxCoalescerConcept =
+    requires(C &c, const C &cc, const uint8_t *data, size_t size,
+             bool (*emit)(const uint8_t *, size_t)) {
+      { c.append(data, size, emit) } -> std::same_as<bool>;
+      { c.flush(emit) } -> std::same_as<bool>;
+      { cc.expired() } -> std::convertible_to<bool>;
+    };
+
+/**
+ * @brief 借出发送缓冲区的发送端概念
+ *
+ * SendFunc 满足此概念时，USBTransport 请求其借出一段发送内存
+ * （USB 端点缓冲区、DMA 区域、mmap 环形缓冲区等），Serializer 直接写入，
+ * 省去栈缓冲区到发送端的一次拷贝：
+ * - acquire_tx(size) 返回至少 size 字节的可写区域；无法借出时返回空 span，
+ *   此时退回栈缓冲区 + operator() 的拷贝路径
+ * - commit_tx(n) 提交前 n 字节；n 为 0 表示放弃本次借出
+ *
+ * @tparam S 要检查的类型
+ */
+template <typename S>
+concept LendingSinkConcept = requires(S &s, size_t size) {
+  { s.acquire_tx(size) } -> std::convertible_to<std::span<uint8_t>>;
+  s.commit_tx(size);
+};
+
+namespace Details {
+/**
+ * @brief 检查类型是否是发送队列 (满足 concept 且不是 Packet)
+ * @tparam T 要检查的类型
+ */
+template <typename T>
+struct IsTxQueue : std::bool_constant<TxQueueConcept<T> && !IsPacketType<T>> {};
+
+/**
+ * @brief 检查类型是否是发送合并器 (满足 concept 且不是 Packet)
+ * @tparam T 要检查的类型
+ */
+template <typename T>
+struct IsTxCoalescer
+    : std::bool_constant<TxCoalescerConcept<T> && !IsPacketType<T>> {};
+
+/// @brief USBTransport 的可选组件
+template <typename Queue, typename Coalescer> struct TransportOptions {
+  using TxQueue = Queue;
+  using TxCoalescer = Coalescer;
+};
+
+// 从模板参数开头逐个提取可选组件，其余为 Packets
+template <typename Options, typename... Args> struct ExtractTransportOptions {
+  using Opts = Options;
+  using Packets = TypeList<Args...>;
+};
+
+// 下一个参数是发送队列
+template <typename Q, typename C, typename H, typename... Args>
+  requires IsTxQueue<H>::value
+struct ExtractTransportOptions<TransportOptions<Q, C>, H, Args...>
+    : ExtractTransportOptions<TransportOptions<H, C>, Args...> {};
+
+// 下一个参数是发送合并器
+template <typename Q, typename C, typename H, typename... Args>
+  requires IsTxCoalescer<H>::value
+struct ExtractTransportOptions<TransportOptions<Q, C>, H, Args...>
+    : ExtractTransportOptions<TransportOptions<Q, H>, Args...> {};
+} // namespace Details
+
+template <typename AckMgr, typename SendFunc, typename Options,
+          typename PacketList>
+class BasicUSBTransport;
+
+/**
+ * @brief USB 传输层
+ *
+ * SendFunc 返回 bool 时，false 表示发送通道繁忙、帧未被接受。
+ * 发送路径：数据包 -> 发送队列（可选）-> 发送合并器（可选）-> SendFunc。
+ * SendFunc 满足 LendingSinkConcept 且未启用发送队列与合并器时，
+ * 数据包直接序列化到发送端借出的内存中（零拷贝）。
+ *
+ * @tparam AckMgr Ack 管理器
+ * @tparam SendFunc 发送回调类型
+ * @tparam Options 可选组件（Details::TransportOptions）
+ * @tparam Packets 数据包类型列表
+ */
+template <typename AckMgr, typename SendFunc, typename Options,
+          typename... Packets>
+class BasicUSBTransport<AckMgr, SendFunc, Options,
+                        Details::TypeList<Packets...>> {
 public:
   using tick_type = typename AckMgr::tick_type;
+  using TxQueue = typename Options::TxQueue;
+  using TxCoalescer = typename Options::TxCoalescer;
+
+  static constexpr bool has_tx_queue = !std::is_same_v<TxQueue, NullTxQueue>;
+  static constexpr bool has_tx_coalescer =
+      !std::is_same_v<TxCoalescer, NullTxCoalescer>;
+  /// 发送队列与合并器需要自己保存帧，此时不借用发送端内存
+  static constexpr bool lends_tx =
+      LendingSinkConcept<SendFunc> && !has_tx_queue && !has_tx_coalescer;
 
-  USBTransport() : parser_(deserializer_) {}
+  static_assert(!((Meta::PacketTraits<Packets>::category ==
+                   Meta::PacketCategory::Request) ||
+                  ...) ||
+                    Details::Contains<USBAck,
+                                      Details::TypeList<Packets...>>::value,
+                "Request packets require USBAck in the packet list");
 
-  explicit USBTransport(SendFunc cb)
-      : parser_(deserializer_), send_cb_(std::move(cb)), has_send_(true) {}
+  BasicUSBTransport() : parser_(deserializer_) { install_ack_hook(); }
+
+  explicit BasicUSBTransport(SendFunc cb)
+      : parser_(deserializer_), send_cb_(std::move(cb)), has_send_(true) {
+    install_ack_hook();
+  }
+
+  // Parser 的回调持有 this，不可复制或移动
+  BasicUSBTransport(const BasicUSBTransport &) = delete;
+  BasicUSBTransport &operator=(const BasicUSBTransport &) = delete;
 
   Deserializer<Packets...> &deserializer() noexcept { return deserializer_; }
   const Deserializer<Packets...> &deserializer() const noexcept {
@@ -37,6 +189,28 @@ public:
   AckMgr &ack_manager() noexcept { return ack_mgr_; }
   const AckMgr &ack_manager() const noexcept { return ack_mgr_; }
 
+  TxQueue &tx_queue() noexcept
+    requires has_tx_queue
+  {
+    return tx_queue_;
+  }
+  const TxQueue &tx_queue() const noexcept
+    requires has_tx_queue
+  {
+    return tx_queue_;
+  }
+
+  TxCoalescer &tx_coalescer() noexcept
+    requires has_tx_coalescer
+  {
+    return tx_coalescer_;
+  }
+  const TxCoalescer &tx_coalescer() const noexcept
+    requires has_tx_coalescer
+  {
+    return tx_coalescer_;
+  }
+
   void on_send(SendFunc cb) {
     send_cb_ = std::move(cb);
     has_send_ = true;
@@ -44,16 +218,14 @@ public:
 
   bool has_send() const { return has_send_; }
 
+  /**
+   * @brief 输入接收到的字节流
+   *
+   * 数据可以在任意位置分段；USBAck 在 Parser 的分发路径中经 AckHook
+   * 交给 AckMgr，因此跨越多次传输或跟在其他帧之后的 Ack 同样能被识别。
+   * Ack 不占用 Parser 的 PacketHook，parser().set_packet_hook() 可自由使用。
+   */
   tl::expected<void, Error> receive(const uint8_t *buf, size_t len) {
-    if (len >= 7) {
-      uint16_t cmd;
-      std::memcpy(&cmd, buf + 3, 2);
-      if (cmd == Meta::PacketTraits<USBAck>::cmd) {
-        uint8_t req_id = buf[5];
-        uint8_t status = buf[6];
-        ack_mgr_.resolve(req_id, status);
-      }
-    }
     return parser_.push_data(buf, len);
   }
 
@@ -64,16 +236,7 @@ public:
       return tl::unexpected(
           Error{ErrorCode::InternalError, "Send callback not set"});
 
-    constexpr size_t frame_sz =
-        Serializer<Packets...>::template frame_size<T>();
-    uint8_t buffer[frame_sz];
-
-    auto result = serializer_.serialize(buffer, frame_sz, packet);
-    if (!result)
-      return tl::unexpected(result.error());
-
-    send_cb_(buffer, *result);
-    return {};
+    return send_packet(packet, [](const uint8_t *, size_t) {});
   }
 
   template <typename T>
@@ -85,37 +248,254 @@ public:
 
     if constexpr (Meta::PacketTraits<T>::category ==
                   Meta::PacketCategory::Request) {
-      packet.req_id = ack_mgr_.allocate();
+      auto id = ack_mgr_.try_allocate(timeout_ms);
+      if (!id)
+        return tl::unexpected(id.error());
+      packet.req_id = *id;
     }
 
+    if (auto sent = send_packet(packet, track_frame(packet.req_id)); !sent)
+      return tl::unexpected(sent.error());
+    // 等待期间继续推进发送：通道繁忙时请求帧仍留在队列或合并器中，
+    // AckMgr 为 ReliableAckManager 时按 RTO 重传
+    return ack_mgr_.wait_ack(packet.req_id, timeout_ms, [this] {
+      retransmit();
+      drain_tx();
+      flush_tx();
+    });
+  }
+
+  /**
+   * @brief 非阻塞请求
+   *
+   * 发送后立即返回完成句柄，不等待 Ack；Ack 到达时 receive() 中的
+   * resolve() 直接唤醒等待者，超时由 poll() 处理。多个请求可同时在途。
+   * AckMgr 为 ReliableAckManager 时请求帧被登记，poll() 中按 RTO 自动重传。
+   *
+   * @param packet Request 数据包（req_id 由此函数分配）
+   * @param timeout 超时 tick 数（0 表示使用 set_default_timeout 的值）
+   * @return 完成句柄；Ack 窗口已满或发送失败时返回错误
+   */
+  template <typename T>
+    requires Serializable<T, Packets...> &&
+             (Meta::PacketTraits<T>::category == Meta::PacketCategory::Request)
+  tl::expected<AckFuture<AckMgr>, Error> request_async(T &packet,
+                                                       tick_type timeout = 0) {
+    if (!has_send_)
+      return tl::unexpected(
+          Error{ErrorCode::InternalError, "Send callback not set"});
+
+    auto id = ack_mgr_.try_allocate(timeout != 0 ? timeout
+                                                 : default_timeout_ms_);
+    if (!id)
+      return tl::unexpected(id.error());
+    packet.req_id = *id;
+
+    auto sent = send_packet(packet, track_frame(packet.req_id));
+    if (!sent) {
+      ack_mgr_.cancel(packet.req_id);
+      return tl::unexpected(sent.error());
+    }
+    return AckFuture<AckMgr>{ack_mgr_, packet.req_id};
+  }
+
+  /**
+   * @brief 按优先级发送排队中的帧
+   *
+   * 总是先发送最紧急的帧；发送回调报告繁忙时停止，剩余帧留在队列中。
+   *
+   * @return 本次发出的帧数（无发送队列时恒为 0）
+   */
+  size_t drain_tx() {
+    size_t sent = 0;
+    if constexpr (has_tx_queue) {
+      while (!tx_queue_.empty()) {
+        const auto frame = tx_queue_.front();
+        if (!emit(frame.data(), frame.size()))
+          break;
+        tx_queue_.pop();
+        ++sent;
+      }
+    }
+    return sent;
+  }
+
+  /**
+   * @brief 立即发出合并器中缓存的数据
+   * @return 缓存为空或发送被接受时返回 true
+   */
+  bool flush_tx() {
+    if constexpr (has_tx_coalescer) {
+      return tx_coalescer_.flush(
+          [this](const uint8_t *p, size_t n) { return invoke_send(p, n); });
+    } else {
+      return true;
+    }
+  }
+
+  void poll() {
+    retransmit();
+    if constexpr (has_tx_coalescer) {
+      if (tx_coalescer_.expired())
+        flush_tx();
+    }
+    ack_mgr_.check_timeouts();
+  }
+
+  void set_default_timeout(tick_type timeout_ms) {
+    default_timeout_ms_ = timeout_ms;
+    ack_mgr_.set_default_timeout(timeout_ms);
+  }
+
+private:
+  /// @brief 发送前登记请求帧的回调（AckMgr 不支持重传时为空操作）
+  auto track_frame(uint8_t req_id) {
+    return [this, req_id](const uint8_t *frame, size_t size) {
+      if constexpr (requires { ack_mgr_.track(req_id, frame, size); })
+        ack_mgr_.track(req_id, frame, size);
+    };
+  }
+
+  /// @brief 重传已到 RTO 的请求（AckMgr 不支持重传时为空操作）
+  void retransmit() {
+    if constexpr (requires { ack_mgr_.retransmit(&detail::accept_all); }) {
+      ack_mgr_.retransmit(
+          [this](const uint8_t *p, size_t n) { return emit(p, n); });
+    }
+  }
+
+  void install_ack_hook() {
+    if constexpr (Details::Contains<USBAck,
+                                    Details::TypeList<Packets...>>::value) {
+      parser_.set_ack_hook(AckHook{this, &on_ack});
+    }
+  }
+
+  /// @brief Parser 的 Ack 回调：交给 AckMgr
+  static void on_ack(void *ctx, uint8_t req_id, uint8_t status) {
+    static_cast<BasicUSBTransport *>(ctx)->ack_mgr_.resolve(req_id, status);
+  }
+
+  /**
+   * @brief 序列化并发送一个数据包
+   *
+   * 发送端可借出内存时直接序列化到借出的区域并提交，否则序列化到栈缓冲区
+   * 后经 send_frame() 发送。
+   *
+   * @param on_frame 发送前以完整帧调用（如登记重传）
+   */
+  template <typename T, typename OnFrame>
+  tl::expected<void, Error> send_packet(const T &packet, OnFrame &&on_frame) {
     constexpr size_t frame_sz =
         Serializer<Packets...>::template frame_size<T>();
-    uint8_t buffer[frame_sz];
 
+    if constexpr (lends_tx) {
+      const std::span<uint8_t> lent = send_cb_.acquire_tx(frame_sz);
+      if (lent.size() >= frame_sz) {
+        auto result = serializer_.serialize(lent.data(), lent.size(), packet);
+        if (!result) {
+          send_cb_.commit_tx(0);
+          return tl::unexpected(result.error());
+        }
+        on_frame(lent.data(), *result);
+        send_cb_.commit_tx(*result);
+        return {};
+      }
+    }
+
+    uint8_t buffer[frame_sz];
     auto result = serializer_.serialize(buffer, frame_sz, packet);
     if (!result)
       return tl::unexpected(result.error());
+    on_frame(buffer, *result);
+    return send_frame<T>(buffer, *result);
+  }
+
+  /**
+   * @brief 发送一帧：有发送队列时按 tx_priority 入队后排空，否则直接发送
+   *
+   * Request 包需要低时延，发送后立即冲刷合并器。
+   */
+  template <typename T>
+  tl::expected<void, Error> send_frame(const uint8_t *frame, size_t size) {
+    tl::expected<void, Error> result{};
+    if constexpr (has_tx_queue) {
+      result = tx_queue_.push(Meta::PacketTraits<T>::tx_priority, frame, size);
+      if (result)
+        drain_tx();
+    } else {
+      if (!emit(frame, size))
+        result = tl::unexpected(Error{ErrorCode::Again, "Send pipe busy"});
+    }
 
-    send_cb_(buffer, *result);
-    return ack_mgr_.wait_ack(packet.req_id, timeout_ms);
+    if constexpr (Meta::PacketTraits<T>::category ==
+                  Meta::PacketCategory::Request) {
+      if (result)
+        flush_tx();
+    }
+    return result;
   }
 
-  void poll() { ack_mgr_.check_timeouts(default_timeout_ms_); }
+  /// @brief 把一帧交给合并器（如有）或发送回调
+  bool emit(const uint8_t *frame, size_t size) {
+    if constexpr (has_tx_coalescer) {
+      return tx_coalescer_.append(
+          frame, size,
+          [this](const uint8_t *p, size_t n) { return invoke_send(p, n); });
+    } else {
+      return invoke_send(frame, size);
+    }
+  }
 
-  void set_default_timeout(tick_type timeout_ms) {
-    default_timeout_ms_ = timeout_ms;
+  /**
+   * @brief 调用发送回调；仅当回调恰好返回 bool 时以其表示是否被接受
+   *
+   * 返回 int / 枚举的回调（如 HAL_StatusTypeDef，HAL_OK 为 0）视为总是接受。
+   */
+  bool invoke_send(const uint8_t *frame, size_t size) {
+    if constexpr (std::same_as<
+                      std::invoke_result_t<SendFunc &, const uint8_t *, size_t>,
+                      bool>) {
+      return static_cast<bool>(send_cb_(frame, size));
+    } else {
+      send_cb_(frame, size);
+      return true;
+    }
   }
 
-private:
   Deserializer<Packets...> deserializer_{};
   Serializer<Packets...> serializer_{};
   Parser<Packets...> parser_;
   [[no_unique_address]] AckMgr ack_mgr_{};
   [[no_unique_address]] SendFunc send_cb_{};
+  [[no_unique_address]] TxQueue tx_queue_{};
+  [[no_unique_address]] TxCoalescer tx_coalescer_{};
   bool has_send_{false};
   tick_type default_timeout_ms_{100};
 };
 
+/**
+ * @brief USB 传输层
+ *
+ * Args 可以以可选组件开头（发送队列如 Containers::PriorityTxQueue、
+ * 发送合并器如 Containers::TxCoalescer，顺序任意），其余为数据包类型。
+ *
+ * @code
+ * using Queue = RPL::Containers::PriorityTxQueue<HALTickProvider, 4, 16, 64>;
+ * using Coalescer = RPL::Containers::TxCoalescer<MicrosTick, 64>;
+ * RPL::USBTransport<AckMgr, SendFn, Queue, Coalescer, USBAck, SensorData,
+ *                   MotorSpeedCmd> tp;
+ * @endcode
+ */
+template <typename AckMgr, typename SendFunc, typename... Args>
+using USBTransport = BasicUSBTransport<
+    AckMgr, SendFunc,
+    typename Details::ExtractTransportOptions<
+        Details::TransportOptions<NullTxQueue, NullTxCoalescer>, Args...>::Opts,
+    typename Details::ExtractTransportOptions<
+        Details::TransportOptions<NullTxQueue, NullTxCoalescer>,
+        Args...>::Packets>;
+
 template <typename AckMgr, typename... Packets>
 using USBTransportFn =
     USBTransport<AckMgr, void (*)(const uint8_t *, size_t), Packets...>;
@@ -4,100 +4,415 @@
 #include "RPL/Utils/ConnectionMonitor.hpp"
 #include "RPL/Utils/Error.hpp"
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <tl/expected.hpp>
+#include <type_traits>
+
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#include <coroutine>
+#define RPL_HAS_COROUTINE 1
+#else
+#define RPL_HAS_COROUTINE 0
+#endif
 
 namespace RPL {
 
-template <TickProviderConcept TickProvider>
+/// @brief Ack 结果：成功时为设备返回的 status
+using AckResult = tl::expected<uint8_t, Error>;
+
+/**
+ * @brief Ack 完成回调
+ *
+ * 在 resolve()（收到 Ack）或 check_timeouts()（超时）中直接调用。
+ *
+ * @param ctx 注册时传入的上下文
+ * @param req_id 请求 ID
+ * @param result Ack 结果
+ */
+using AckCompletion = void (*)(void *ctx, uint8_t req_id, AckResult result);
+
+/**
+ * @brief 请求 / Ack 匹配管理器
+ *
+ * 在途请求按超时时刻升序挂在侵入式双向链表上：超时检查只查看表头，
+ * 代价为 O(已超时数)；在途数量以计数器维护，pending_count() 为 O(1)。
+ * 插入从表尾向前查找位置，超时相同（常见情况）时为 O(1)。
+ *
+ * @tparam TickProvider 时间戳提供器
+ * @tparam Window 最多同时在途的请求数（2 的幂，不超过 256）；
+ *                req_id 仍为 8 位，槽位为 req_id % Window
+ */
+template <TickProviderConcept TickProvider, size_t Window = 256>
 class AckManager {
+  static_assert(Window > 0 && Window <= 256 && (Window & (Window - 1)) == 0,
+                "Window must be a power of 2 in [1, 256]");
+
 public:
   using tick_type = typename TickProvider::tick_type;
 
-  AckManager() {
-    for (auto &p : pending_)
-      p.req_id = 0xFF;
+  static constexpr size_t window = Window;
+
+  /**
+   * @brief 分配请求 ID
+   *
+   * 窗口已满时强制以超时结束最早到期的请求并复用其槽位；
+   * 不希望丢弃在途请求时使用 try_allocate()。
+   *
+   * @param timeout 该请求的超时 tick 数（0 表示使用默认超时）
+   */
+  uint8_t allocate(tick_type timeout = 0) {
+    if (auto id = try_allocate(timeout))
+      return *id;
+    // 窗口已满：丢弃最早到期的在途请求（无在途请求时丢弃未取走的结果）
+    const uint16_t victim =
+        head_ != npos ? head_ : static_cast<uint16_t>(next_id_ & mask);
+    if (slots_[victim].state == State::Pending)
+      expire(victim);
+    slots_[victim].state = State::Free;
+    return *try_allocate(timeout);
   }
 
-  uint8_t allocate() {
-    uint8_t id = next_id_++;
-    pending_[id].req_id = id;
-    pending_[id].status = 0xFF;
-    pending_[id].send_time = TickProvider::now();
-    pending_[id].resolved = false;
+  /**
+   * @brief 分配请求 ID（窗口满时失败）
+   *
+   * @param timeout 该请求的超时 tick 数（0 表示使用默认超时）
+   * @return 请求 ID；窗口已满时返回 BufferOverflow
+   */
+  tl::expected<uint8_t, Error> try_allocate(tick_type timeout = 0) {
+    // 跳过仍被占用（在途或结果未取走）的槽位
+    size_t probes = 0;
+    while (slots_[next_id_ & mask].state != State::Free) {
+      if (++probes == Window)
+        return tl::unexpected(
+            Error{ErrorCode::BufferOverflow, "Ack window full"});
+      ++next_id_;
+    }
+
+    const uint8_t id = next_id_++;
+    auto &p = slots_[id & mask];
+    p.req_id = id;
+    p.status = 0xFF;
+    p.state = State::Pending;
+    p.timed_out = false;
+    p.sent = static_cast<tick_type>(TickProvider::now());
+    p.deadline = static_cast<tick_type>(
+        p.sent + (timeout != 0 ? timeout : default_timeout_));
+    p.on_complete = nullptr;
+    p.ctx = nullptr;
+    link(static_cast<uint16_t>(id & mask));
     return id;
   }
 
   tl::expected<uint8_t, Error>
   wait_ack(uint8_t req_id, tick_type timeout_ms) {
+    return wait_ack(req_id, timeout_ms, [] {});
+  }
+
+  /**
+   * @brief 等待 Ack，每轮轮询前调用 idle（例如推进发送队列）
+   */
+  template <typename Idle>
+  tl::expected<uint8_t, Error>
+  wait_ack(uint8_t req_id, tick_type timeout_ms, Idle &&idle) {
     tick_type start = TickProvider::now();
 
     while ((TickProvider::now() - start) < timeout_ms) {
-      if (pending_[req_id].resolved) {
-        pending_[req_id].req_id = 0xFF;
-        return pending_[req_id].status;
+      idle();
+      if (is_done(req_id)) {
+        return take(req_id);
       }
     }
 
-    pending_[req_id].req_id = 0xFF;
+    cancel(req_id);
     return tl::unexpected(
         Error{ErrorCode::Timeout, "Ack timeout for req_id"});
   }
 
   tl::expected<uint8_t, Error>
   try_ack(uint8_t req_id) {
-    if (pending_[req_id].resolved) {
-      pending_[req_id].req_id = 0xFF;
-      return pending_[req_id].status;
+    if (is_done(req_id)) {
+      return take(req_id);
     }
     return tl::unexpected(
         Error{ErrorCode::Again, "Ack not yet received"});
   }
 
+  /**
+   * @brief 注册完成回调
+   *
+   * 请求已完成时立即调用；否则在 resolve() / check_timeouts() 中调用。
+   * 回调调用后该请求 ID 即被释放。
+   *
+   * @param req_id 请求 ID
+   * @param fn 回调
+   * @param ctx 回调上下文
+   * @return 请求 ID 不在等待中时返回 false
+   */
+  bool on_complete(uint8_t req_id, AckCompletion fn, void *ctx) {
+    if (is_done(req_id)) {
+      fn(ctx, req_id, take(req_id));
+      return true;
+    }
+    if (!is_pending(req_id))
+      return false;
+    auto &p = slots_[req_id & mask];
+    p.on_complete = fn;
+    p.ctx = ctx;
+    return true;
+  }
+
   void resolve(uint8_t req_id, uint8_t status) {
-    if (pending_[req_id].req_id == req_id) {
-      pending_[req_id].status = status;
-      pending_[req_id].resolved = true;
+    if (is_pending(req_id)) {
+      const auto idx = static_cast<uint16_t>(req_id & mask);
+      unlink(idx);
+      slots_[idx].status = status;
+      slots_[idx].state = State::Done;
+      complete(idx);
     }
   }
 
+  /**
+   * @brief 结束所有已到期的请求
+   *
+   * 只检查链表头部，代价为 O(已超时数)。
+   */
+  void check_timeouts() {
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    while (head_ != npos && !before(now, slots_[head_].deadline))
+      expire(head_);
+  }
+
+  /**
+   * @brief 结束所有分配后已超过 timeout_ms 的请求
+   *
+   * 不看各请求自身的超时，按分配时刻统一判断；链表按到期时刻排序，
+   * 因此需遍历全部在途请求，代价为 O(在途数)。
+   *
+   * @param timeout_ms 请求自分配起允许等待的 tick 数
+   */
   void check_timeouts(tick_type timeout_ms) {
-    tick_type now = TickProvider::now();
-    for (auto &p : pending_) {
-      if (p.req_id != 0xFF && !p.resolved) {
-        if ((now - p.send_time) >= timeout_ms) {
-          p.status = 0xFF;
-          p.resolved = true;
-        }
-      }
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    for (uint16_t idx = head_; idx != npos;) {
+      const uint16_t next = slots_[idx].next;
+      if (static_cast<tick_type>(now - slots_[idx].sent) >= timeout_ms)
+        expire(idx);
+      idx = next;
     }
   }
 
+  /// @brief 设置以 timeout 0 分配的请求使用的默认超时
+  void set_default_timeout(tick_type timeout) { default_timeout_ = timeout; }
+
   void cancel(uint8_t req_id) {
-    pending_[req_id].req_id = 0xFF;
+    auto &p = slots_[req_id & mask];
+    if (p.req_id != req_id || p.state == State::Free)
+      return;
+    if (p.state == State::Pending)
+      unlink(static_cast<uint16_t>(req_id & mask));
+    p.state = State::Free;
   }
 
   bool is_pending(uint8_t req_id) const {
-    return pending_[req_id].req_id != 0xFF && !pending_[req_id].resolved;
+    const auto &p = slots_[req_id & mask];
+    return p.req_id == req_id && p.state == State::Pending;
   }
 
-  size_t pending_count() const {
-    size_t count = 0;
-    for (const auto &p : pending_)
-      if (p.req_id != 0xFF && !p.resolved)
-        count++;
-    return count;
-  }
+  size_t pending_count() const { return count_; }
 
 private:
+  static constexpr size_t mask = Window - 1;
+  static constexpr uint16_t npos = 0xFFFF;
+
+  enum class State : uint8_t { Free, Pending, Done };
+
   struct PendingRequest {
     uint8_t req_id;
     uint8_t status;
-    tick_type send_time;
-    bool resolved;
+    State state;
+    bool timed_out;
+    uint16_t prev;
+    uint16_t next;
+    tick_type sent; ///< 分配时刻
+    tick_type deadline;
+    AckCompletion on_complete;
+    void *ctx;
   };
-  std::array<PendingRequest, 256> pending_{};
+
+  /// @brief a 是否早于 b（允许 tick 回绕）
+  static bool before(tick_type a, tick_type b) {
+    return static_cast<std::make_signed_t<tick_type>>(a - b) < 0;
+  }
+
+  bool is_done(uint8_t req_id) const {
+    const auto &p = slots_[req_id & mask];
+    return p.req_id == req_id && p.state == State::Done;
+  }
+
+  /// @brief 按到期时刻插入链表（从表尾向前查找）
+  void link(uint16_t idx) {
+    auto &p = slots_[idx];
+    uint16_t after = tail_;
+    while (after != npos && before(p.deadline, slots_[after].deadline))
+      after = slots_[after].prev;
+
+    p.prev = after;
+    p.next = after == npos ? head_ : slots_[after].next;
+    if (p.prev != npos)
+      slots_[p.prev].next = idx;
+    else
+      head_ = idx;
+    if (p.next != npos)
+      slots_[p.next].prev = idx;
+    else
+      tail_ = idx;
+    ++count_;
+  }
+
+  void unlink(uint16_t idx) {
+    auto &p = slots_[idx];
+    if (p.prev != npos)
+      slots_[p.prev].next = p.next;
+    else
+      head_ = p.next;
+    if (p.next != npos)
+      slots_[p.next].prev = p.prev;
+    else
+      tail_ = p.prev;
+    --count_;
+  }
+
+  /// @brief 以超时结束一个在途请求
+  void expire(uint16_t idx) {
+    unlink(idx);
+    slots_[idx].state = State::Done;
+    slots_[idx].timed_out = true;
+    complete(idx);
+  }
+
+  /// @brief 取出已完成请求的结果并释放 ID
+  AckResult take(uint8_t req_id) {
+    auto &p = slots_[req_id & mask];
+    p.state = State::Free;
+    if (p.timed_out)
+      return tl::unexpected(
+          Error{ErrorCode::Timeout, "Ack timeout for req_id"});
+    return p.status;
+  }
+
+  /// @brief 有回调时立即唤醒等待者
+  void complete(uint16_t idx) {
+    auto &p = slots_[idx];
+    if (p.on_complete) {
+      const auto fn = p.on_complete;
+      void *ctx = p.ctx;
+      p.on_complete = nullptr;
+      fn(ctx, p.req_id, take(p.req_id));
+    }
+  }
+
+  std::array<PendingRequest, Window> slots_{};
+  uint16_t head_ = npos; ///< 最早到期的在途请求
+  uint16_t tail_ = npos; ///< 最晚到期的在途请求
+  size_t count_ = 0;     ///< 在途请求数
   uint8_t next_id_{0};
+  tick_type default_timeout_{100};
+};
+
+/**
+ * @brief 异步请求的完成句柄
+ *
+ * 由 USBTransport::request_async() 返回，支持三种等待方式：
+ * - 轮询：ready() / get()
+ * - 回调：then(fn, ctx)，在 Ack 到达或超时时直接调用
+ * - C++20 协程：co_await future，由 resolve() 直接恢复协程
+ *
+ * 三种方式只能选择其一；结果被取走后该请求 ID 即被释放。
+ *
+ * @tparam AckMgr Ack 管理器类型
+ *
+ * @code
+ * auto future = transport.request_async(cmd, 20);
+ * // 协程中
+ * auto status = co_await *future;
+ * // 或轮询
+ * while (!future->ready()) transport.poll();
+ * @endcode
+ */
+template <typename AckMgr> class AckFuture {
+public:
+  AckFuture(AckMgr &mgr, uint8_t req_id) noexcept
+      : mgr_(&mgr), req_id_(req_id) {}
+
+  /// @brief 请求 ID
+  [[nodiscard]] uint8_t req_id() const noexcept { return req_id_; }
+
+  /// @brief 结果是否已就绪（Ack 到达或超时）
+  [[nodiscard]] bool ready() const noexcept {
+    return !mgr_->is_pending(req_id_);
+  }
+
+  /**
+   * @brief 取出结果
+   * @return 未就绪时返回 ErrorCode::Again
+   */
+  AckResult get() { return mgr_->try_ack(req_id_); }
+
+  /**
+   * @brief 注册完成回调（已完成时立即调用）
+   * @return 请求 ID 不在等待中时返回 false
+   */
+  bool then(AckCompletion fn, void *ctx) {
+    return mgr_->on_complete(req_id_, fn, ctx);
+  }
+
+#if RPL_HAS_COROUTINE
+  /// @brief 协程等待器
+  struct Awaiter {
+    AckFuture future;
+    std::coroutine_handle<> handle{};
+    AckResult result{tl::unexpected(Error{ErrorCode::Again, "Pending"})};
+
+    explicit Awaiter(AckFuture f) noexcept : future(f) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    /// @return 已完成时返回 false，协程不挂起
+    bool await_suspend(std::coroutine_handle<> h) {
+      handle = h;
+      bool suspended = true;
+      resuming_ = &suspended;
+      if (!future.then(&Awaiter::wake, this)) {
+        result = tl::unexpected(
+            Error{ErrorCode::AckMismatch, "Request is not pending"});
+        suspended = false;
+      }
+      resuming_ = nullptr;
+      return suspended;
+    }
+
+    AckResult await_resume() { return result; }
+
+  private:
+    bool *resuming_ = nullptr; ///< 注册期间同步完成时用于取消挂起
+
+    static void wake(void *ctx, uint8_t, AckResult r) {
+      auto *self = static_cast<Awaiter *>(ctx);
+      self->result = r;
+      if (self->resuming_) {
+        *self->resuming_ = false;
+      } else {
+        self->handle.resume();
+      }
+    }
+  };
+
+  Awaiter operator co_await() const noexcept { return Awaiter{*this}; }
+#endif
+
+private:
+  AckMgr *mgr_;
+  uint8_t req_id_;
 };
 
 } // namespace RPL
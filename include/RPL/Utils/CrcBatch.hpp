@@ -0,0 +1,304 @@
+/**
+ * @file CrcBatch.hpp
+ * @brief RPL 多帧并行 CRC16 校验
+ *
+ * 此文件提供 CrcBatch：一次计算 / 校验至多 16 个互相独立的帧的 CRC16，
+ * 每个帧占一个 SIMD 通道，消除逐字节查表的串行依赖链。
+ *
+ * @par 设计原理
+ * - 反射 CRC16 按半字节推进：crc = (crc >> 4) ^ T[crc & 0xF]，16 项表拆成
+ *   低 / 高字节两张 16 字节表，用 pshufb（AVX2）/ tbl（NEON）在所有通道上同时查表
+ * - 各帧右对齐到最长帧：第 j 步时 j < 起点的通道保持初值，
+ *   因此不同长度的帧可以放在同一批
+ * - 每 16 步一块，块边界与帧尾对齐：每帧在块内是连续 16 字节（只有首块需要补零），
+ *   转置后一行即所有通道在同一步的输入（AVX2 用字节 unpack 完成 16×16 转置）
+ * - x86-64（GCC/Clang）运行时检测 AVX2；AArch64 使用 NEON；
+ *   其他平台（或定义 RPL_CRC_BATCH_NO_SIMD）逐帧调用 Crc::calc，结果相同
+ *
+ * @par 使用场景
+ * - OfflineParser 批量校验候选帧的帧尾
+ * - 网关 / 回放等需要校验大量独立帧的场景
+ *
+ * @code
+ * std::array<std::span<const uint8_t>, 8> frames = ...; // 完整帧（含帧尾）
+ * uint16_t ok = RPL::CrcBatch<>::verify(frames);        // 第 i 位对应 frames[i]
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_CRC_BATCH_HPP
+#define RPL_CRC_BATCH_HPP
+
+#include "Def.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if !defined(RPL_CRC_BATCH_NO_SIMD)
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RPL_CRC_BATCH_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define RPL_CRC_BATCH_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace RPL {
+
+/**
+ * @brief 多帧并行 CRC 计算与帧尾校验
+ *
+ * @tparam Crc cppcrc 风格的 16 位反射 CRC（默认 CRC-16/MCRF4XX）
+ */
+template <typename Crc = ProtocolCRC16> struct CrcBatch {
+  static_assert(sizeof(typename Crc::type) == 2 && Crc::refl_in &&
+                    Crc::refl_out,
+                "CrcBatch requires a reflected 16-bit CRC");
+
+  using type = uint16_t;
+
+  static constexpr size_t max_batch = 16; ///< 一批最多的帧数
+
+  /// @brief 实际使用的实现
+  enum class Backend : uint8_t { Scalar, AVX2, NEON };
+
+  [[nodiscard]] static Backend backend() noexcept {
+#if defined(RPL_CRC_BATCH_AVX2)
+    static const bool avx2 = [] {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return avx2 ? Backend::AVX2 : Backend::Scalar;
+#elif defined(RPL_CRC_BATCH_NEON)
+    return Backend::NEON;
+#else
+    return Backend::Scalar;
+#endif
+  }
+
+  /**
+   * @brief 计算一批消息的 CRC，out[i] == Crc::calc(messages[i])
+   *
+   * @param messages 至多 max_batch 条消息，长度可以各不相同
+   * @param out 结果，至少 messages.size() 项
+   */
+  static void calc(std::span<const std::span<const uint8_t>> messages,
+                   type *out) noexcept {
+    const size_t count = std::min(messages.size(), max_batch);
+    size_t length = 0;
+    for (size_t i = 0; i < count; ++i)
+      length = std::max(length, messages[i].size());
+
+    // 通道起点以 int16 比较，过长的消息逐条计算
+    if (count < 2 || length > 0x7FF0 || backend() == Backend::Scalar) {
+      for (size_t i = 0; i < count; ++i)
+        out[i] = Crc::calc(messages[i].data(), messages[i].size());
+      return;
+    }
+
+    // 前补 pad 个空步，使总步数为 block 的整数倍、块边界与帧尾对齐
+    Lanes lanes{};
+    lanes.pad = (block - length % block) % block;
+    lanes.length = length + lanes.pad;
+    for (size_t i = 0; i < max_batch; ++i) {
+      // 空闲通道的起点为总步数，始终不推进
+      const size_t size = i < count ? messages[i].size() : 0;
+      lanes.data[i] = i < count ? messages[i].data() : nullptr;
+      lanes.start[i] = static_cast<int16_t>(lanes.length - size);
+    }
+
+    alignas(32) std::array<type, max_batch> state{};
+#if defined(RPL_CRC_BATCH_AVX2)
+    calc_avx2(lanes, state.data());
+#elif defined(RPL_CRC_BATCH_NEON)
+    calc_neon(lanes, state.data());
+#endif
+    for (size_t i = 0; i < count; ++i)
+      out[i] = static_cast<type>(state[i] ^ Crc::x_or_out);
+  }
+
+  /**
+   * @brief 校验一批完整帧的帧尾
+   *
+   * 每帧最后 2 字节为小端 CRC，覆盖其之前的全部字节（与 Parser 一致）。
+   *
+   * @param frames 至多 max_batch 个完整帧
+   * @return 第 i 位为 1 表示 frames[i] 校验通过
+   */
+  [[nodiscard]] static uint16_t
+  verify(std::span<const std::span<const uint8_t>> frames) noexcept {
+    const size_t count = std::min(frames.size(), max_batch);
+    std::array<std::span<const uint8_t>, max_batch> bodies{};
+    for (size_t i = 0; i < count; ++i)
+      if (frames[i].size() >= 2)
+        bodies[i] = frames[i].first(frames[i].size() - 2);
+
+    std::array<type, max_batch> crc{};
+    calc(std::span<const std::span<const uint8_t>>(bodies.data(), count),
+         crc.data());
+
+    uint16_t ok = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const auto &f = frames[i];
+      if (f.size() < 2)
+        continue;
+      const type recv = static_cast<type>(
+          f[f.size() - 2] | (static_cast<type>(f[f.size() - 1]) << 8));
+      if (crc[i] == recv)
+        ok |= static_cast<uint16_t>(1u << i);
+    }
+    return ok;
+  }
+
+private:
+  static constexpr size_t block = 16; ///< 每次转置的步数
+
+  struct Lanes {
+    size_t length = 0; ///< 总步数（最长消息长度 + pad）
+    size_t pad = 0;    ///< 首块中全部通道空闲的步数
+    std::array<const uint8_t *, max_batch> data{};
+    alignas(32) std::array<int16_t, max_batch> start{}; ///< 通道开始推进的步
+  };
+
+  /// @brief 反射域中的初始状态（Crc::calc 的默认起点）
+  static constexpr type initial = Crc::null_crc ^ Crc::x_or_out;
+
+  /// @brief 半字节表 T[i] = table[i << 4]，拆成低 / 高字节
+  static constexpr auto nibble_lo = [] {
+    std::array<uint8_t, 16> t{};
+    for (size_t i = 0; i < 16; ++i)
+      t[i] = static_cast<uint8_t>(Crc::table()[i << 4]);
+    return t;
+  }();
+  static constexpr auto nibble_hi = [] {
+    std::array<uint8_t, 16> t{};
+    for (size_t i = 0; i < 16; ++i)
+      t[i] = static_cast<uint8_t>(Crc::table()[i << 4] >> 8);
+    return t;
+  }();
+  static_assert(nibble_lo[0] == 0 && nibble_hi[0] == 0);
+
+  /**
+   * @brief 通道 l 在 [begin, begin + block) 步的输入（连续 block 字节）
+   *
+   * 块边界与帧尾对齐，块完全落在消息内时直接指向消息；
+   * 否则把重叠部分复制到 tmp 的尾部（前部为零）。
+   */
+  static const uint8_t *lane_block(const Lanes &lanes, size_t l, size_t begin,
+                                   uint8_t (&tmp)[block]) noexcept {
+    const size_t start = static_cast<size_t>(lanes.start[l]);
+    if (begin >= start)
+      return lanes.data[l] + (begin - start);
+    std::memset(tmp, 0, block);
+    const size_t skip = start - begin;
+    if (skip < block)
+      std::memcpy(tmp + skip, lanes.data[l], block - skip);
+    return tmp;
+  }
+
+  /// @brief 把 [begin, begin + block) 步的输入转置为 rows[步][通道]
+  static void stage(const Lanes &lanes, size_t begin,
+                    uint8_t (&rows)[block][max_batch]) noexcept {
+    uint8_t tmp[block];
+    for (size_t l = 0; l < max_batch; ++l) {
+      const uint8_t *src = lane_block(lanes, l, begin, tmp);
+      for (size_t s = 0; s < block; ++s)
+        rows[s][l] = src[s];
+    }
+  }
+
+#if defined(RPL_CRC_BATCH_AVX2)
+  __attribute__((target("avx2"))) static void calc_avx2(const Lanes &lanes,
+                                                        type *out) noexcept {
+    const __m256i tlo = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(nibble_lo.data())));
+    const __m256i thi = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(nibble_hi.data())));
+    const __m256i low_nibble = _mm256_set1_epi16(0x000F);
+    const __m256i start = _mm256_load_si256(
+        reinterpret_cast<const __m256i *>(lanes.start.data()));
+    __m256i state = _mm256_set1_epi16(static_cast<int16_t>(initial));
+
+    for (size_t begin = 0; begin < lanes.length; begin += block) {
+      // 16×16 字节转置：四轮 r[i] 与 r[i + 8] 交织后 r[s] 即第 s 步的各通道输入
+      __m128i r[max_batch];
+      uint8_t tmp[block];
+      for (size_t l = 0; l < max_batch; ++l)
+        r[l] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+            lane_block(lanes, l, begin, tmp)));
+      for (int round = 0; round < 4; ++round) {
+        __m128i t[max_batch];
+        for (size_t i = 0; i < max_batch / 2; ++i) {
+          t[2 * i] = _mm_unpacklo_epi8(r[i], r[i + 8]);
+          t[2 * i + 1] = _mm_unpackhi_epi8(r[i], r[i + 8]);
+        }
+        for (size_t i = 0; i < max_batch; ++i)
+          r[i] = t[i];
+      }
+
+      for (size_t s = begin == 0 ? lanes.pad : 0; s < block; ++s) {
+        const __m256i bytes = _mm256_cvtepu8_epi16(r[s]);
+        const __m256i idle = _mm256_cmpgt_epi16(
+            start, _mm256_set1_epi16(static_cast<int16_t>(begin + s)));
+        __m256i x = _mm256_xor_si256(state, bytes);
+        for (int n = 0; n < 2; ++n) {
+          // 各通道高字节的索引为 0，T[0] == 0，查表结果只落在低字节
+          const __m256i idx = _mm256_and_si256(x, low_nibble);
+          const __m256i t = _mm256_or_si256(
+              _mm256_shuffle_epi8(tlo, idx),
+              _mm256_slli_epi16(_mm256_shuffle_epi8(thi, idx), 8));
+          x = _mm256_xor_si256(_mm256_srli_epi16(x, 4), t);
+        }
+        state = _mm256_blendv_epi8(x, state, idle);
+      }
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i *>(out), state);
+  }
+#endif
+
+#if defined(RPL_CRC_BATCH_NEON)
+  static void calc_neon(const Lanes &lanes, type *out) noexcept {
+    const uint8x16_t tlo = vld1q_u8(nibble_lo.data());
+    const uint8x16_t thi = vld1q_u8(nibble_hi.data());
+    const uint16x8_t low_nibble = vdupq_n_u16(0x000F);
+    const int16x8_t start[2] = {vld1q_s16(lanes.start.data()),
+                                vld1q_s16(lanes.start.data() + 8)};
+    uint16x8_t state[2] = {vdupq_n_u16(initial), vdupq_n_u16(initial)};
+
+    alignas(16) uint8_t rows[block][max_batch];
+    for (size_t begin = 0; begin < lanes.length; begin += block) {
+      stage(lanes, begin, rows);
+      for (size_t s = begin == 0 ? lanes.pad : 0; s < block; ++s) {
+        const uint8x16_t row = vld1q_u8(rows[s]);
+        const uint16x8_t bytes[2] = {vmovl_u8(vget_low_u8(row)),
+                                     vmovl_u8(vget_high_u8(row))};
+        const int16x8_t step = vdupq_n_s16(static_cast<int16_t>(begin + s));
+        for (int h = 0; h < 2; ++h) {
+          const uint16x8_t idle = vcgtq_s16(start[h], step);
+          uint16x8_t x = veorq_u16(state[h], bytes[h]);
+          for (int n = 0; n < 2; ++n) {
+            const uint8x16_t idx =
+                vreinterpretq_u8_u16(vandq_u16(x, low_nibble));
+            const uint16x8_t t = vorrq_u16(
+                vreinterpretq_u16_u8(vqtbl1q_u8(tlo, idx)),
+                vshlq_n_u16(vreinterpretq_u16_u8(vqtbl1q_u8(thi, idx)), 8));
+            x = veorq_u16(vshrq_n_u16(x, 4), t);
+          }
+          state[h] = vbslq_u16(idle, state[h], x);
+        }
+      }
+    }
+    vst1q_u16(out, state[0]);
+    vst1q_u16(out + 8, state[1]);
+  }
+#endif
+};
+
+} // namespace RPL
+
+#endif // RPL_CRC_BATCH_HPP
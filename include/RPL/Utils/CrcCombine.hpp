@@ -0,0 +1,157 @@
+/**
+ * @file CrcCombine.hpp
+ * @brief RPL CRC 增量修补工具
+ *
+ * 此文件利用 CRC 在 GF(2) 上的线性，实现“只重算变化字节”的增量 CRC 更新。
+ *
+ * @par 设计原理
+ * - 对等长消息有 crc(M ^ D) = crc(M) ^ raw(D)，raw 为初值 0、无输出异或的 CRC
+ * - D 仅在区间 [a, b) 非零：前导零字节对 raw 无贡献，只需对变化字节计算
+ *   raw，再乘以 x^(8·(n-b)) mod P 跳过其后的全零字节
+ * - 乘方通过 x^(2^k) 表与 GF(2) 多项式乘法完成（与 zlib crc32_combine 同法）；
+ *   255 字节以内的跳跃直接查 x8n_table，只需一次乘法
+ *
+ * @par 使用场景
+ * - FrameHandle 原地修改持久发送帧的少数字段
+ *
+ * @note 仅支持输入/输出均反射的 CRC（库内 CRC8/CRC16 均满足）
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_CRC_COMBINE_HPP
+#define RPL_CRC_COMBINE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace RPL {
+
+/**
+ * @brief 反射 CRC 的增量修补运算
+ *
+ * @tparam Crc cppcrc 风格的 CRC 类型（提供 type / poly / refl_in / refl_out /
+ *             table()）
+ *
+ * @code
+ * using Combine = RPL::CrcCombine<RPL::ProtocolCRC16>;
+ * uint16_t d = 0;
+ * for (size_t i = a; i < b; ++i)
+ *   d = Combine::update_raw(d, old_bytes[i] ^ new_bytes[i]);
+ * crc ^= Combine::shift_zeros(d, n - b);
+ * @endcode
+ */
+template <typename Crc> struct CrcCombine {
+  static_assert(Crc::refl_in && Crc::refl_out,
+                "CrcCombine requires a reflected CRC");
+
+  using type = typename Crc::type;
+
+  static constexpr size_t width = sizeof(type) * 8;
+
+  /// @brief 反射域中表示 x^0 的位
+  static constexpr type one = static_cast<type>(type{1} << (width - 1));
+
+  /// @brief 反射后的生成多项式（如 0x1021 -> 0x8408）
+  static constexpr type reflected_poly = []() {
+    type r = 0;
+    for (size_t i = 0; i < width; ++i)
+      if (Crc::poly & (type{1} << i))
+        r |= static_cast<type>(type{1} << (width - 1 - i));
+    return r;
+  }();
+
+  /**
+   * @brief 计算 a·b mod P（反射域）
+   */
+  static constexpr type multmodp(type a, type b) noexcept {
+    type m = one;
+    type p = 0;
+    for (;;) {
+      if (a & m) {
+        p ^= b;
+        if ((a & static_cast<type>(m - 1)) == 0)
+          break;
+      }
+      m >>= 1;
+      b = (b & 1) ? static_cast<type>((b >> 1) ^ reflected_poly)
+                  : static_cast<type>(b >> 1);
+    }
+    return p;
+  }
+
+  /// @brief x^(2^k) mod P，k = 0..63
+  static constexpr auto x2n_table = []() {
+    std::array<type, 64> t{};
+    type p = static_cast<type>(one >> 1); // x^1
+    for (auto &e : t) {
+      e = p;
+      p = multmodp(p, p);
+    }
+    return t;
+  }();
+
+  /**
+   * @brief 计算 x^(8·n) mod P
+   * @param n 字节数
+   */
+  static constexpr type x8nmodp(size_t n) noexcept {
+    type p = one;
+    size_t k = 3;
+    while (n) {
+      if (n & 1)
+        p = multmodp(x2n_table[k & 63], p);
+      n >>= 1;
+      ++k;
+    }
+    return p;
+  }
+
+  /**
+   * @brief 以初值 0、无输出异或的方式推进一个字节
+   *
+   * @param state 当前原始 CRC 状态
+   * @param byte 差分字节（旧值 ^ 新值）
+   */
+  static constexpr type update_raw(type state, uint8_t byte) noexcept {
+    const auto &table = Crc::table();
+    if constexpr (width == 8) {
+      return table[static_cast<uint8_t>(state ^ byte)];
+    } else {
+      return static_cast<type>(table[static_cast<uint8_t>(state ^ byte)] ^
+                               (state >> 8));
+    }
+  }
+
+  /// @brief x^(8·n) mod P，n = 0..255（覆盖常见帧长，避免运行时逐位求幂）
+  static constexpr auto x8n_table = []() {
+    std::array<type, 256> t{};
+    type p = one;
+    for (auto &e : t) {
+      e = p;
+      p = multmodp(p, x2n_table[3]);
+    }
+    return t;
+  }();
+
+  /**
+   * @brief 将原始 CRC 推进 n 个全零字节
+   *
+   * @param raw 差分区间的原始 CRC
+   * @param n 差分区间之后、CRC 覆盖范围之内的字节数
+   * @return 需要异或到原 CRC 上的修正值
+   */
+  static constexpr type shift_zeros(type raw, size_t n) noexcept {
+    if (raw == 0 || n == 0)
+      return raw;
+    type shift = x8n_table[n & 0xFF];
+    if (n >= x8n_table.size())
+      shift = multmodp(shift, x8nmodp(n & ~size_t{0xFF}));
+    return multmodp(shift, raw);
+  }
+};
+
+} // namespace RPL
+
+#endif // RPL_CRC_COMBINE_HPP
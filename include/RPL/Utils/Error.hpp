@@ -32,6 +32,8 @@ namespace RPL
         InvalidCommand,   ///< 无效命令
         Timeout,          ///< 超时（Ack 超时）
         AckMismatch,      ///< Ack 匹配失败
+        IoError,          ///< 系统调用失败（详见 message）
+        LayoutMismatch,   ///< 共享内存布局与本进程的数据包集合不一致
     };
 
     /**
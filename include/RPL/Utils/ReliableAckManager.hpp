@@ -0,0 +1,297 @@
+/**
+ * @file ReliableAckManager.hpp
+ * @brief RPL 滑动窗口可靠投递
+ *
+ * 此文件提供 ReliableAckManager（主机端）与 AckReplayCache（设备端），
+ * 在 USBTransport 的请求 / Ack 机制上实现自动重传与去重。
+ *
+ * @par 设计原理
+ * - ReliableAckManager 可直接替换 AckManager 作为 USBTransport 的 AckMgr：
+ *   在途请求的帧被保存在窗口槽位中，超时未收到 Ack 或收到 NACK 时自动重传
+ * - 重传超时（RTO）按 RFC 6298 由平滑 RTT（SRTT）与 RTT 偏差（RTTVAR）计算，
+ *   每次重传指数退避；按 Karn 算法只用未重传过的请求采样 RTT
+ * - 请求的总超时（allocate 时给定）仍由 AckManager 的到期链表处理，
+ *   重传次数用尽后等待总超时结束
+ * - 设备端 AckReplayCache 记录最近处理过的 req_id 与返回的 status，
+ *   重复请求直接重放缓存的 Ack，不再重复执行
+ *
+ * @par 使用场景
+ * - 有丢包的 USB / 串口链路上的控制指令
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_RELIABLE_ACK_MANAGER_HPP
+#define RPL_RELIABLE_ACK_MANAGER_HPP
+
+#include "RPL/Utils/AckManager.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace RPL {
+
+/**
+ * @brief 带自动重传的 Ack 管理器（主机端）
+ *
+ * USBTransport 检测到 AckMgr 提供 track() / retransmit() 时，
+ * 在 request() / request_async() 中登记请求帧；阻塞的 request()
+ * 在等待 Ack 期间执行重传，异步请求在 poll() 中执行重传。
+ *
+ * @tparam TickProvider 时间戳提供器
+ * @tparam Window 最多同时在途的请求数
+ * @tparam MaxFrameSize 可重传请求帧的最大字节数
+ *
+ * @code
+ * using AckMgr = RPL::ReliableAckManager<HALTickProvider, 16>;
+ * RPL::USBTransport<AckMgr, SendFn, USBAck, MotorSpeedCmd> transport{send};
+ * auto future = transport.request_async(cmd, 200); // 总超时 200 tick
+ * // 主循环中
+ * transport.poll();                                // 按 RTO 重传
+ * @endcode
+ */
+template <TickProviderConcept TickProvider, size_t Window = 16,
+          size_t MaxFrameSize = 64>
+class ReliableAckManager : public AckManager<TickProvider, Window> {
+  using Base = AckManager<TickProvider, Window>;
+
+public:
+  using tick_type = typename TickProvider::tick_type;
+
+  /**
+   * @brief 登记请求帧，之后可被重传
+   *
+   * @param req_id 请求 ID（由 allocate 分配）
+   * @param frame 完整请求帧
+   * @param size 帧长度
+   * @return 帧超过 MaxFrameSize 时返回 false（该请求不重传）
+   */
+  bool track(uint8_t req_id, const uint8_t *frame, size_t size) {
+    auto &s = slots_[req_id & mask];
+    s.req_id = req_id;
+    s.tracked = size <= MaxFrameSize;
+    if (!s.tracked)
+      return false;
+    std::copy_n(frame, size, s.frame.begin());
+    s.size = static_cast<uint8_t>(size);
+    s.transmissions = 1;
+    s.rto = rto_;
+    s.first_tx = static_cast<tick_type>(TickProvider::now());
+    s.retransmit_at = static_cast<tick_type>(s.first_tx + s.rto);
+    return true;
+  }
+
+  /**
+   * @brief 处理 Ack
+   *
+   * status 为 NACK 且仍可重传时安排立即重传，否则完成请求。
+   * 首次发送即被确认的请求用于更新 RTT 估计。
+   */
+  void resolve(uint8_t req_id, uint8_t status) {
+    if (!Base::is_pending(req_id))
+      return;
+    auto &s = slots_[req_id & mask];
+    const bool tracked = s.tracked && s.req_id == req_id;
+    const auto now = static_cast<tick_type>(TickProvider::now());
+
+    if (tracked && status == nack_status_ &&
+        s.transmissions <= max_retries_) {
+      ++nacks_;
+      s.retransmit_at = now;
+      return;
+    }
+    if (tracked) {
+      if (s.transmissions == 1)
+        sample_rtt(static_cast<tick_type>(now - s.first_tx));
+      s.tracked = false;
+    }
+    Base::resolve(req_id, status);
+  }
+
+  /**
+   * @brief 重传所有已到 RTO 的在途请求
+   *
+   * @param emit 发送回调 bool(const uint8_t*, size_t)
+   * @return 本次重传的帧数
+   */
+  template <typename Emit> size_t retransmit(Emit &&emit) {
+    const auto now = static_cast<tick_type>(TickProvider::now());
+    size_t sent = 0;
+    for (auto &s : slots_) {
+      if (!s.tracked || !Base::is_pending(s.req_id))
+        continue;
+      if (before(now, s.retransmit_at) || s.transmissions > max_retries_)
+        continue;
+      if (!emit(s.frame.data(), s.size))
+        break;
+      ++s.transmissions;
+      ++retransmissions_;
+      s.rto = std::min<tick_type>(static_cast<tick_type>(s.rto * 2), max_rto_);
+      s.retransmit_at = static_cast<tick_type>(now + s.rto);
+      ++sent;
+    }
+    return sent;
+  }
+
+  /// @brief 设置视为 NACK 的 status（默认 0xFE）
+  void set_nack_status(uint8_t status) { nack_status_ = status; }
+
+  /// @brief 设置单个请求的最大重传次数（默认 4）
+  void set_max_retries(uint8_t retries) { max_retries_ = retries; }
+
+  /**
+   * @brief 设置 RTO 上下限与初始值
+   *
+   * @param initial 尚无 RTT 采样时的 RTO
+   * @param min_rto RTO 下限
+   * @param max_rto RTO 上限（指数退避的上限）
+   */
+  void set_rto(tick_type initial, tick_type min_rto, tick_type max_rto) {
+    min_rto_ = min_rto;
+    max_rto_ = max_rto;
+    rto_ = std::clamp(initial, min_rto, max_rto);
+  }
+
+  /// @brief 当前 RTO
+  [[nodiscard]] tick_type rto() const { return rto_; }
+
+  /// @brief 平滑 RTT（尚无采样时为 0）
+  [[nodiscard]] tick_type srtt() const {
+    return static_cast<tick_type>(srtt8_ / 8);
+  }
+
+  /// @brief 累计重传次数
+  [[nodiscard]] uint32_t retransmissions() const { return retransmissions_; }
+
+  /// @brief 累计收到的 NACK 数
+  [[nodiscard]] uint32_t nacks() const { return nacks_; }
+
+private:
+  static constexpr size_t mask = Window - 1;
+
+  struct Slot {
+    std::array<uint8_t, MaxFrameSize> frame{};
+    uint8_t size = 0;
+    uint8_t req_id = 0;
+    bool tracked = false;
+    uint8_t transmissions = 0; ///< 已发送次数（含首次）
+    tick_type rto{};           ///< 该请求当前的重传间隔
+    tick_type first_tx{};
+    tick_type retransmit_at{};
+  };
+
+  static bool before(tick_type a, tick_type b) {
+    return static_cast<std::make_signed_t<tick_type>>(a - b) < 0;
+  }
+
+  /**
+   * @brief RFC 6298 RTT 估计（整数定点：SRTT×8、RTTVAR×4）
+   */
+  void sample_rtt(tick_type rtt) {
+    const auto r = static_cast<uint64_t>(rtt);
+    if (srtt8_ == 0) {
+      srtt8_ = r * 8;
+      rttvar4_ = r * 2; // RTTVAR = R / 2
+    } else {
+      const uint64_t srtt = srtt8_ / 8;
+      const uint64_t err = r > srtt ? r - srtt : srtt - r;
+      rttvar4_ = rttvar4_ - rttvar4_ / 4 + err;    // β = 1/4
+      srtt8_ = srtt8_ - srtt8_ / 8 + r;            // α = 1/8
+    }
+    const uint64_t rto = srtt8_ / 8 + std::max<uint64_t>(1, rttvar4_);
+    rto_ = static_cast<tick_type>(std::clamp<uint64_t>(
+        rto, static_cast<uint64_t>(min_rto_), static_cast<uint64_t>(max_rto_)));
+  }
+
+  std::array<Slot, Window> slots_{};
+  tick_type rto_{20};
+  tick_type min_rto_{2};
+  tick_type max_rto_{1000};
+  uint64_t srtt8_ = 0;
+  uint64_t rttvar4_ = 0;
+  uint8_t nack_status_ = 0xFE;
+  uint8_t max_retries_ = 4;
+  uint32_t retransmissions_ = 0;
+  uint32_t nacks_ = 0;
+};
+
+/**
+ * @brief 设备端 Ack 重放缓存
+ *
+ * 记录最近 Size 个已处理请求的 req_id 与 status。重传导致的重复请求
+ * 命中缓存时直接重放 Ack，不再重复执行指令。
+ *
+ * @tparam Size 缓存条目数（应不小于主机端窗口）
+ *
+ * @code
+ * RPL::AckReplayCache<16> cache;
+ * // MotorSpeedCmd 的 after_parse 中
+ * const uint8_t status = cache.handle(cmd.req_id, [&] { return apply(cmd); });
+ * send_ack(cmd.req_id, status);
+ * @endcode
+ */
+template <size_t Size = 16> class AckReplayCache {
+public:
+  /**
+   * @brief 查询已处理请求的 status
+   * @return 未处理过时为空
+   */
+  [[nodiscard]] std::optional<uint8_t> lookup(uint8_t req_id) const {
+    for (size_t i = 0; i < count_; ++i) {
+      if (entries_[i].req_id == req_id)
+        return entries_[i].status;
+    }
+    return std::nullopt;
+  }
+
+  /// @brief 记录已处理请求（覆盖最旧的条目）
+  void store(uint8_t req_id, uint8_t status) {
+    entries_[next_] = Entry{req_id, status};
+    next_ = (next_ + 1) % Size;
+    count_ = std::min(count_ + 1, Size);
+  }
+
+  /**
+   * @brief 执行或重放请求
+   *
+   * @param req_id 请求 ID
+   * @param execute 执行指令并返回 status 的函数
+   * @return 应回复的 status
+   */
+  template <typename Exec> uint8_t handle(uint8_t req_id, Exec &&execute) {
+    if (auto cached = lookup(req_id)) {
+      ++replays_;
+      return *cached;
+    }
+    const uint8_t status = execute();
+    store(req_id, status);
+    return status;
+  }
+
+  /// @brief 重放次数（即被过滤的重复请求数）
+  [[nodiscard]] uint32_t replays() const { return replays_; }
+
+  /// @brief 清空缓存（如主机重连）
+  void clear() {
+    count_ = 0;
+    next_ = 0;
+  }
+
+private:
+  struct Entry {
+    uint8_t req_id;
+    uint8_t status;
+  };
+
+  std::array<Entry, Size> entries_{};
+  size_t next_ = 0;
+  size_t count_ = 0;
+  uint32_t replays_ = 0;
+};
+
+} // namespace RPL
+
+#endif // RPL_RELIABLE_ACK_MANAGER_HPP
@@ -0,0 +1,140 @@
+/**
+ * @file TokenBucket.hpp
+ * @brief RPL 令牌桶限速工具
+ *
+ * 此文件提供基于 tick 的整数令牌桶，用于发送频率与字节速率限制。
+ *
+ * @par 设计原理
+ * - 令牌以 1/ticks_per_second 为最小单位存储，每个 tick 补充 rate 个单位，
+ *   全程整数运算，不依赖浮点
+ * - 惰性补充：只在查询或消耗时按经过的 tick 数补充
+ * - 消耗量超过桶容量时按容量计算，避免大于突发量的请求永远无法通过
+ * - rate 为 0 表示不限速，所有请求立即通过
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_TOKEN_BUCKET_HPP
+#define RPL_TOKEN_BUCKET_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+namespace RPL {
+
+/**
+ * @brief 整数令牌桶
+ *
+ * @tparam Tick tick 类型（无符号整数，允许回绕）
+ *
+ * @code
+ * // 30 次/秒，突发 1 次，1 tick = 1 ms
+ * RPL::TokenBucket<uint32_t> bucket{30, 1, 1000, HAL_GetTick()};
+ * if (bucket.try_consume(1, HAL_GetTick())) {
+ *     send();
+ * }
+ * @endcode
+ */
+template <typename Tick> class TokenBucket {
+public:
+  /// @brief 构造不限速的令牌桶
+  constexpr TokenBucket() noexcept = default;
+
+  /**
+   * @brief 构造令牌桶（初始为满）
+   *
+   * @param rate 每秒补充的令牌数（0 表示不限速）
+   * @param burst 桶容量（令牌数，至少为 1）
+   * @param ticks_per_second 每秒 tick 数
+   * @param now 当前 tick
+   */
+  constexpr TokenBucket(uint32_t rate, uint32_t burst,
+                        uint32_t ticks_per_second, Tick now) noexcept
+      : rate_(rate), unit_(ticks_per_second),
+        capacity_(static_cast<uint64_t>(std::max<uint32_t>(burst, 1)) *
+                  ticks_per_second),
+        level_(capacity_), last_(now) {}
+
+  /// @brief 是否不限速
+  [[nodiscard]] constexpr bool unlimited() const noexcept { return rate_ == 0; }
+
+  /**
+   * @brief 检查当前是否有足够令牌
+   *
+   * @param tokens 需要的令牌数
+   * @param now 当前 tick
+   */
+  [[nodiscard]] constexpr bool available(uint32_t tokens, Tick now) noexcept {
+    if (unlimited())
+      return true;
+    refill(now);
+    return level_ >= cost(tokens);
+  }
+
+  /**
+   * @brief 扣除令牌（调用者需先确认 available）
+   *
+   * @param tokens 令牌数
+   */
+  constexpr void consume(uint32_t tokens) noexcept {
+    if (unlimited())
+      return;
+    const uint64_t c = cost(tokens);
+    level_ = level_ > c ? level_ - c : 0;
+  }
+
+  /**
+   * @brief 令牌足够时扣除
+   *
+   * @param tokens 令牌数
+   * @param now 当前 tick
+   * @return 是否成功扣除
+   */
+  constexpr bool try_consume(uint32_t tokens, Tick now) noexcept {
+    if (!available(tokens, now))
+      return false;
+    consume(tokens);
+    return true;
+  }
+
+  /**
+   * @brief 距离令牌足够还需等待的 tick 数
+   *
+   * @param tokens 需要的令牌数
+   * @param now 当前 tick
+   * @return 0 表示现在即可发送
+   */
+  [[nodiscard]] constexpr Tick wait_ticks(uint32_t tokens, Tick now) noexcept {
+    if (!available(tokens, now))
+      return static_cast<Tick>((cost(tokens) - level_ + rate_ - 1) / rate_);
+    return 0;
+  }
+
+private:
+  [[nodiscard]] constexpr uint64_t cost(uint32_t tokens) const noexcept {
+    return std::min(static_cast<uint64_t>(tokens) * unit_, capacity_);
+  }
+
+  constexpr void refill(Tick now) noexcept {
+    const Tick elapsed = static_cast<Tick>(now - last_);
+    last_ = now;
+    const uint64_t room = capacity_ - level_;
+    // elapsed 足够填满时直接置满，避免乘法溢出
+    if (static_cast<uint64_t>(elapsed) >= room / rate_ + 1) {
+      level_ = capacity_;
+    } else {
+      level_ += static_cast<uint64_t>(elapsed) * rate_;
+      level_ = std::min(level_, capacity_);
+    }
+  }
+
+  uint32_t rate_ = 0;     ///< 每 tick 补充的单位数（= 每秒令牌数）
+  uint32_t unit_ = 1;     ///< 每个令牌的单位数（= 每秒 tick 数）
+  uint64_t capacity_ = 0; ///< 桶容量（单位）
+  uint64_t level_ = 0;    ///< 当前令牌（单位）
+  Tick last_{};           ///< 上次补充时刻
+};
+
+} // namespace RPL
+
+#endif // RPL_TOKEN_BUCKET_HPP
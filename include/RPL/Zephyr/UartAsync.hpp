@@ -0,0 +1,307 @@
+/**
+ * @file UartAsync.hpp
+ * @brief RPL 的 Zephyr UART 异步 API 传输层
+ *
+ * 此文件提供 RPL::Zephyr::UartAsync，把 Zephyr UART 异步 API（DMA）
+ * 与 Parser / Serializer 连接起来，收发两个方向都不经过中间拷贝。
+ *
+ * @par 设计原理
+ * - 接收：环形缓冲区分为两半交给 uart_rx_enable / uart_rx_buf_rsp 做双缓冲，
+ *   UART_RX_RDY 事件只记录 DMA 写指针并唤醒解析线程；解析线程以
+ *   Parser::update_write_index() 在环形缓冲区上原地解析
+ *   （Parser 需使用 Containers::DmaRingBuffer 缓冲区策略）
+ * - 发送：两个发送缓冲区交替使用，一个由 DMA 发送时另一个继续接收新帧；
+ *   sink() 返回满足 LendingSinkConcept 的发送端，Serializer 直接写入发送缓冲区，
+ *   也可直接作为 USBTransport 的 SendFunc
+ * - 缓冲区大小与线程优先级由 Kconfig（CONFIG_RPL_ZEPHYR_UART_*）配置
+ *
+ * @par 使用场景
+ * - Zephyr 上通过 UART 收发裁判系统或上位机数据
+ *
+ * @code
+ * using Ring = RPL::Containers::DmaRingBuffer<CONFIG_RPL_ZEPHYR_UART_RX_BUF_SIZE>;
+ * RPL::Deserializer<SensorData> des;
+ * RPL::Parser<Ring, SensorData> parser{des};
+ * RPL::Zephyr::UartAsync<decltype(parser)> uart{DEVICE_DT_GET(DT_NODELABEL(usart1)), parser};
+ *
+ * uart.start();          // 开始接收并启动解析线程
+ * RPL::Serializer<SensorData> ser;
+ * uart.send(ser, SensorData{...});
+ * @endcode
+ *
+ * @author WindWeaver
+ */
+
+#ifndef RPL_ZEPHYR_UART_ASYNC_HPP
+#define RPL_ZEPHYR_UART_ASYNC_HPP
+
+#if !defined(CONFIG_RPL_ZEPHYR_UART)
+#error "RPL/Zephyr/UartAsync.hpp requires CONFIG_RPL_ZEPHYR_UART=y"
+#endif
+
+#include "RPL/Utils/Error.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <tl/expected.hpp>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+namespace RPL::Zephyr {
+
+/**
+ * @brief Zephyr UART 异步 API 传输层
+ *
+ * @tparam ParserType 使用 Containers::DmaRingBuffer<RxSize> 缓冲区策略的 Parser
+ * @tparam RxSize 接收环形缓冲区大小（2 的幂）
+ * @tparam TxSize 单个发送缓冲区大小
+ *
+ * @note acquire_tx / commit_tx / send 应在同一个线程中调用
+ */
+template <typename ParserType,
+          size_t RxSize = CONFIG_RPL_ZEPHYR_UART_RX_BUF_SIZE,
+          size_t TxSize = CONFIG_RPL_ZEPHYR_UART_TX_BUF_SIZE>
+  requires requires(ParserType &p, size_t index) {
+    p.update_write_index(index);
+  }
+class UartAsync {
+  static_assert(RxSize >= 2 && (RxSize & (RxSize - 1)) == 0,
+                "RxSize must be a power of 2");
+
+public:
+  /**
+   * @brief 满足 LendingSinkConcept 的发送端句柄（可按值复制）
+   */
+  struct Sink {
+    UartAsync *uart;
+
+    std::span<uint8_t> acquire_tx(size_t size) {
+      return uart->acquire_tx(size);
+    }
+    void commit_tx(size_t n) { uart->commit_tx(n); }
+    bool operator()(const uint8_t *data, size_t size) {
+      return uart->write(data, size);
+    }
+  };
+
+  /**
+   * @brief 构造传输层并把接收环形缓冲区绑定到 Parser
+   *
+   * @param dev UART 设备
+   * @param parser 解析器
+   */
+  UartAsync(const struct device *dev, ParserType &parser)
+      : dev_(dev), parser_(parser) {
+    parser_.attach_buffer(rx_ring_);
+    k_sem_init(&rx_sem_, 0, K_SEM_MAX_LIMIT);
+  }
+
+  UartAsync(const UartAsync &) = delete;
+  UartAsync &operator=(const UartAsync &) = delete;
+
+  /**
+   * @brief 注册 UART 回调、开始接收并启动解析线程
+   * @return Zephyr 错误码（0 表示成功）
+   */
+  int start() {
+    if (int err = start_rx(); err != 0)
+      return err;
+    k_thread_create(&thread_, stack_, K_KERNEL_STACK_SIZEOF(stack_),
+                    &UartAsync::thread_entry, this, nullptr, nullptr,
+                    CONFIG_RPL_ZEPHYR_UART_THREAD_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&thread_, "rpl_uart");
+    return 0;
+  }
+
+  /**
+   * @brief 只注册回调并开始接收，由调用方在自己的线程中调用 process()
+   * @return Zephyr 错误码（0 表示成功）
+   */
+  int start_rx() {
+    if (int err = uart_callback_set(dev_, &UartAsync::uart_callback, this);
+        err != 0)
+      return err;
+    next_half_ = 1;
+    return uart_rx_enable(dev_, rx_ring_, half,
+                          CONFIG_RPL_ZEPHYR_UART_RX_TIMEOUT_US);
+  }
+
+  /**
+   * @brief 等待接收事件并解析新数据
+   *
+   * @param timeout 等待时间
+   * @return 超时返回 Again；DMA 覆盖了未解析数据时返回 BufferOverflow
+   */
+  tl::expected<void, Error> process(k_timeout_t timeout = K_FOREVER) {
+    if (k_sem_take(&rx_sem_, timeout) != 0)
+      return tl::unexpected(Error{ErrorCode::Again, "No RX event"});
+    if (atomic_test_and_clear_bit(&flags_, resync_bit)) {
+      // 接收重启后写指针跳到新的半区：跳过其间的旧数据
+      (void)parser_.update_write_index(
+          static_cast<size_t>(atomic_get(&hw_index_)));
+      parser_.clear_buffer();
+      return {};
+    }
+    return parser_.update_write_index(
+        static_cast<size_t>(atomic_get(&hw_index_)));
+  }
+
+  /// @brief 满足 LendingSinkConcept 的发送端
+  Sink sink() noexcept { return Sink{this}; }
+
+  /**
+   * @brief 借出发送缓冲区
+   * @return 空间不足时返回空 span
+   */
+  std::span<uint8_t> acquire_tx(size_t size) {
+    const unsigned int key = irq_lock();
+    std::span<uint8_t> lent;
+    if (size <= TxSize - fill_len_) {
+      lent = std::span<uint8_t>(tx_buf_[fill_] + fill_len_, size);
+      lent_ = true;
+    }
+    irq_unlock(key);
+    return lent;
+  }
+
+  /**
+   * @brief 提交借出的前 n 字节；DMA 空闲时立即发送
+   */
+  void commit_tx(size_t n) {
+    const unsigned int key = irq_lock();
+    fill_len_ += n;
+    lent_ = false;
+    if (!in_flight_)
+      start_tx_locked();
+    irq_unlock(key);
+  }
+
+  /**
+   * @brief 拷贝一帧到发送缓冲区
+   * @return 发送缓冲区已满时返回 false
+   */
+  bool write(const uint8_t *data, size_t size) {
+    const auto lent = acquire_tx(size);
+    if (lent.empty())
+      return false;
+    std::memcpy(lent.data(), data, size);
+    commit_tx(size);
+    return true;
+  }
+
+  /**
+   * @brief 把若干数据包直接序列化到发送缓冲区并发送
+   *
+   * @param serializer 包含这些数据包类型的 Serializer
+   * @param packets 数据包
+   * @return 发送缓冲区已满时返回 Again
+   */
+  template <typename Ser, typename... Ps>
+  tl::expected<void, Error> send(Ser &serializer, const Ps &...packets) {
+    constexpr size_t size = (Ser::template frame_size<Ps>() + ...);
+    const auto lent = acquire_tx(size);
+    if (lent.empty())
+      return tl::unexpected(Error{ErrorCode::Again, "TX buffers full"});
+    auto written = serializer.serialize(lent.data(), lent.size(), packets...);
+    commit_tx(written ? *written : 0);
+    if (!written)
+      return tl::unexpected(written.error());
+    return {};
+  }
+
+  /// @brief 累计发送失败（uart_tx 返回错误或发送被中止）次数
+  [[nodiscard]] uint32_t tx_errors() const noexcept { return tx_errors_; }
+
+private:
+  static constexpr size_t half = RxSize / 2;
+  static constexpr int resync_bit = 0;
+
+  static void thread_entry(void *self, void *, void *) {
+    auto *uart = static_cast<UartAsync *>(self);
+    while (true)
+      (void)uart->process(K_FOREVER);
+  }
+
+  static void uart_callback(const struct device *dev, struct uart_event *evt,
+                            void *user_data) {
+    auto *self = static_cast<UartAsync *>(user_data);
+    switch (evt->type) {
+    case UART_RX_RDY: {
+      const size_t end = static_cast<size_t>(evt->data.rx.buf - self->rx_ring_) +
+                         evt->data.rx.offset + evt->data.rx.len;
+      atomic_set(&self->hw_index_, static_cast<atomic_val_t>(end % RxSize));
+      k_sem_give(&self->rx_sem_);
+      break;
+    }
+    case UART_RX_BUF_REQUEST:
+      (void)uart_rx_buf_rsp(dev, self->rx_ring_ + self->next_half_ * half,
+                            half);
+      self->next_half_ ^= 1;
+      break;
+    case UART_RX_DISABLED: {
+      // 出错或被停止后从下一个半区重新开始接收
+      const size_t start = self->next_half_ * half;
+      self->next_half_ ^= 1;
+      atomic_set(&self->hw_index_, static_cast<atomic_val_t>(start));
+      atomic_set_bit(&self->flags_, resync_bit);
+      k_sem_give(&self->rx_sem_);
+      (void)uart_rx_enable(dev, self->rx_ring_ + start, half,
+                           CONFIG_RPL_ZEPHYR_UART_RX_TIMEOUT_US);
+      break;
+    }
+    case UART_TX_ABORTED:
+      ++self->tx_errors_;
+      [[fallthrough]];
+    case UART_TX_DONE: {
+      const unsigned int key = irq_lock();
+      self->in_flight_ = false;
+      if (!self->lent_)
+        self->start_tx_locked();
+      irq_unlock(key);
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  /// @brief 发出正在填充的缓冲区并切换到另一个（调用方已关中断）
+  void start_tx_locked() {
+    if (fill_len_ == 0)
+      return;
+    const uint8_t *buf = tx_buf_[fill_];
+    const size_t len = fill_len_;
+    fill_ ^= 1;
+    fill_len_ = 0;
+    in_flight_ = true;
+    if (uart_tx(dev_, buf, len, SYS_FOREVER_US) != 0) {
+      in_flight_ = false;
+      ++tx_errors_;
+    }
+  }
+
+  const struct device *dev_;
+  ParserType &parser_;
+
+  alignas(4) uint8_t rx_ring_[RxSize]{};
+  uint8_t next_half_ = 1;
+  atomic_t hw_index_ = ATOMIC_INIT(0);
+  atomic_t flags_ = ATOMIC_INIT(0);
+  struct k_sem rx_sem_;
+
+  alignas(4) uint8_t tx_buf_[2][TxSize]{};
+  uint8_t fill_ = 0;
+  size_t fill_len_ = 0;
+  bool lent_ = false;
+  bool in_flight_ = false;
+  uint32_t tx_errors_ = 0;
+
+  struct k_thread thread_;
+  K_KERNEL_STACK_MEMBER(stack_, CONFIG_RPL_ZEPHYR_UART_THREAD_STACK_SIZE);
+};
+
+} // namespace RPL::Zephyr
+
+#endif // RPL_ZEPHYR_UART_ASYNC_HPP
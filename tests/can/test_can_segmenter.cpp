@@ -0,0 +1,232 @@
+#include "RPL/Can/CanSegmenter.hpp"
+#include "RPL/Deserializer.hpp"
+#include "RPL/Packets/RoboMaster/RobotCustomData.hpp"
+#include "RPL/Packets/Sample/SampleA.hpp"
+#include "RPL/Parser.hpp"
+#include "RPL/Serializer.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef __linux__
+#include "RPL/Linux/SocketCanTransport.hpp"
+#endif
+
+struct CanFrame {
+  uint32_t id;
+  std::vector<uint8_t> data;
+};
+
+template <size_t Mtu>
+static std::vector<CanFrame> segment(uint32_t id, const std::vector<uint8_t> &frame) {
+  std::vector<CanFrame> out;
+  RPL::Can::CanSegmenter<Mtu>::segment(
+      frame.data(), frame.size(), [&](const uint8_t *p, size_t n) {
+        out.push_back({id, std::vector<uint8_t>(p, p + n)});
+        return true;
+      });
+  return out;
+}
+
+static std::vector<uint8_t> pattern(size_t n, uint8_t seed) {
+  std::vector<uint8_t> v(n);
+  for (size_t i = 0; i < n; ++i)
+    v[i] = static_cast<uint8_t>(seed + i * 7);
+  return v;
+}
+
+void test_segment_layout() {
+  std::cout << "Test 1: Segment layout and CAN FD padding..." << std::endl;
+
+  using Fd = RPL::Can::CanSegmenter<64>;
+  static_assert(Fd::count(0) == 1);
+  static_assert(Fd::count(62) == 1);
+  static_assert(Fd::count(63) == 2);
+  static_assert(Fd::count(125) == 2);
+  static_assert(Fd::count(126) == 3);
+  static_assert(RPL::Can::CanSegmenter<8>::count(24) == 4);
+
+  for (size_t len : {0, 1, 10, 62, 63, 64, 125, 126, 200}) {
+    const auto frames = segment<64>(0x100, pattern(len, 1));
+    assert(frames.size() == Fd::count(len));
+    for (size_t i = 0; i < frames.size(); ++i) {
+      const auto &f = frames[i];
+      assert(((f.data[0] & RPL::Can::seg_sof) != 0) == (i == 0));
+      assert(((f.data[0] & RPL::Can::seg_eof) != 0) == (i + 1 == frames.size()));
+      assert((f.data[0] & RPL::Can::seg_seq_mask) == i);
+      assert(RPL::Can::fd_padded_length(f.data.size()) == f.data.size());
+    }
+  }
+
+  // 经典 CAN：每段不超过 8 字节，不填充
+  const auto classic = segment<8>(0x200, pattern(24, 3));
+  assert(classic.size() == 4);
+  assert(classic.back().data.size() == size_t{2} + classic.back().data[1]);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_interleaved_reassembly() {
+  std::cout << "Test 2: Interleaved reassembly keyed by CAN ID..." << std::endl;
+
+  const auto a = pattern(200, 10);
+  const auto b = pattern(90, 50);
+  const auto c = pattern(20, 90);
+  auto fa = segment<64>(0x101, a);
+  auto fb = segment<64>(0x102, b);
+  auto fc = segment<64>(0x103, c);
+
+  // 三个发送者的分段交错到达
+  std::vector<CanFrame> bus;
+  for (size_t i = 0; i < 4; ++i) {
+    if (i < fa.size())
+      bus.push_back(fa[i]);
+    if (i < fb.size())
+      bus.push_back(fb[i]);
+    if (i < fc.size())
+      bus.push_back(fc[i]);
+  }
+
+  RPL::Can::CanReassembler<4, 256> reassembler;
+  std::vector<std::vector<uint8_t>> out;
+  for (const auto &f : bus)
+    reassembler.feed(f.id, f.data.data(), f.data.size(),
+                     [&](const uint8_t *p, size_t n) {
+                       out.emplace_back(p, p + n);
+                     });
+
+  assert(out.size() == 3);
+  assert(out[0] == c); // 单段帧最先完成
+  assert(out[1] == b);
+  assert(out[2] == a);
+  assert(reassembler.frames() == 3);
+  assert(reassembler.dropped() == 0);
+  assert(reassembler.in_progress() == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_loss_detection() {
+  std::cout << "Test 3: Lost segment drops the frame and resyncs..." << std::endl;
+
+  const auto a = pattern(150, 1);
+  auto fa = segment<64>(0x10, a);
+  assert(fa.size() == 3);
+
+  RPL::Can::CanReassembler<2, 256> reassembler;
+  size_t completed = 0;
+  auto sink = [&](const uint8_t *, size_t) { ++completed; };
+
+  // 丢失中间段
+  reassembler.feed(0x10, fa[0].data.data(), fa[0].data.size(), sink);
+  reassembler.feed(0x10, fa[2].data.data(), fa[2].data.size(), sink);
+  assert(completed == 0);
+  assert(reassembler.dropped() == 1);
+
+  // 下一帧正常重组
+  for (const auto &f : fa)
+    reassembler.feed(f.id, f.data.data(), f.data.size(), sink);
+  assert(completed == 1);
+
+  // 上下文耗尽
+  auto f1 = segment<64>(0x21, a), f2 = segment<64>(0x22, a),
+       f3 = segment<64>(0x23, a);
+  reassembler.feed(0x21, f1[0].data.data(), f1[0].data.size(), sink);
+  reassembler.feed(0x22, f2[0].data.data(), f2[0].data.size(), sink);
+  reassembler.feed(0x23, f3[0].data.data(), f3[0].data.size(), sink);
+  assert(reassembler.dropped() == 2);
+  assert(reassembler.in_progress() == 2);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_parser_over_classic_can() {
+  std::cout << "Test 4: RPL frames through 8-byte CAN into Parser..." << std::endl;
+
+  RPL::Serializer<SampleA, RobotCustomData> ser;
+  RPL::Deserializer<SampleA, RobotCustomData> des;
+  RPL::Parser<SampleA, RobotCustomData> parser{des};
+  RPL::Can::CanReassembler<2, 256> reassembler;
+
+  SampleA sample{7, -300, 1.5f, 2.5};
+  RobotCustomData custom{};
+  for (size_t i = 0; i < custom.data.size(); ++i)
+    custom.data[i] = static_cast<uint8_t>(i);
+
+  std::vector<uint8_t> fs(64), fr(256);
+  fs.resize(ser.serialize(fs.data(), fs.size(), sample).value());
+  fr.resize(ser.serialize(fr.data(), fr.size(), custom).value());
+  auto cs = segment<8>(0x301, fs);
+  auto cr = segment<8>(0x302, fr);
+
+  for (size_t i = 0; i < std::max(cs.size(), cr.size()); ++i) {
+    for (const auto *list : {&cr, &cs}) {
+      if (i < list->size()) {
+        const auto &f = (*list)[i];
+        reassembler.feed(f.id, f.data.data(), f.data.size(),
+                         [&](const uint8_t *p, size_t n) {
+                           (void)parser.push_data(p, n);
+                         });
+      }
+    }
+  }
+  assert(des.get<SampleA>().b == -300);
+  assert(des.get<RobotCustomData>().data[149] == 149);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+#ifdef __linux__
+void test_vcan() {
+  std::cout << "Test 5: SocketCAN FD on vcan0..." << std::endl;
+
+  using P = RPL::Parser<SampleA, RobotCustomData>;
+  RPL::Deserializer<SampleA, RobotCustomData> des_rx, des_tx;
+  P parser_rx{des_rx}, parser_tx{des_tx};
+  RPL::Linux::SocketCanTransport<P> tx{parser_tx}, rx{parser_rx};
+  if (!tx.open("vcan0") || !rx.open("vcan0")) {
+    std::cout << "  SKIP (vcan0 not available)" << std::endl;
+    return;
+  }
+
+  RPL::Serializer<SampleA, RobotCustomData> ser;
+  RobotCustomData custom{};
+  custom.data.fill(0x5A);
+  std::vector<uint8_t> frame(256);
+  frame.resize(ser.serialize(frame.data(), frame.size(), custom).value());
+
+  // 多个 RPL 帧合并为一次 sendmmsg
+  for (int i = 0; i < 5; ++i) {
+    auto queued = tx.queue(0x7A0 + i, frame.data(), frame.size());
+    assert(queued.has_value());
+  }
+  assert(tx.queued() == 5 * RPL::Can::CanSegmenter<64>::count(frame.size()));
+  auto flushed = tx.flush();
+  assert(flushed.has_value());
+
+  size_t received = 0;
+  while (rx.reassembler().frames() < 5) {
+    auto r = rx.receive(true);
+    assert(r.has_value());
+    received += *r;
+  }
+  assert(received == 5 * RPL::Can::CanSegmenter<64>::count(frame.size()));
+  assert(des_rx.get<RobotCustomData>().data[100] == 0x5A);
+
+  std::cout << "  PASS" << std::endl;
+}
+#endif
+
+int main() {
+  std::cout << "=== RPL CAN Segmentation Tests ===" << std::endl;
+  test_segment_layout();
+  test_interleaved_reassembly();
+  test_loss_detection();
+  test_parser_over_classic_can();
+#ifdef __linux__
+  test_vcan();
+#endif
+  std::cout << "\nAll CAN segmentation tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include <RPL/Deserializer.hpp>
+#include <RPL/Meta/BitView.hpp>
+#include <RPL/Packets/VT03RemotePacket.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+// VT03RemotePacket BitLayout 字段索引
+static constexpr size_t kRightStickX = 0;
+static constexpr size_t kSwitchState = 4;
+static constexpr size_t kWheel = 8;
+static constexpr size_t kTrigger = 9;
+static constexpr size_t kMouseX = 11;
+static constexpr size_t kMouseZ = 13;
+static constexpr size_t kKeyW = 21;
+static constexpr size_t kKeyB = 36;
+
+static VT03RemotePacket make_remote() {
+  VT03RemotePacket pkt{};
+  pkt.right_stick_x = 1684;
+  pkt.right_stick_y = 364;
+  pkt.left_stick_y = 1024;
+  pkt.left_stick_x = 1500;
+  pkt.switch_state = 2;
+  pkt.wheel = 777;
+  pkt.trigger = 1;
+  pkt.mouse_x = -120;
+  pkt.mouse_y = 300;
+  pkt.mouse_z = -1;
+  pkt.mouse_right = 1;
+  pkt.key_w = 1;
+  pkt.key_b = 1;
+  return pkt;
+}
+
+void test_view_matches_full_decode() {
+  std::cout << "Test 1: BitView fields match full decode..." << std::endl;
+
+  const auto pkt = make_remote();
+  std::array<uint8_t, 17> wire{};
+  RPL::serialize_bitstream<VT03RemotePacket>(wire, pkt);
+
+  RPL::BitView<VT03RemotePacket> view{wire};
+  static_assert(RPL::BitView<VT03RemotePacket>::field_count == 37);
+
+  assert(view.get<kRightStickX>() == 1684);
+  assert(view.get<kSwitchState>() == 2);
+  assert(view.get<kWheel>() == 777);
+  assert(view.get<kTrigger>() == 1);
+  assert(view.get<kMouseX>() == -120);
+  assert(view.get<kMouseZ>() == -1);
+  assert(view.get<kKeyW>() == 1);
+  assert(view.get<kKeyB>() == 1);
+  assert(view.get<kKeyB - 1>() == 0);
+
+  const auto decoded = view.decode();
+  assert(decoded.left_stick_x == 1500);
+  assert(decoded.mouse_y == 300);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_bit_ref_in_place_write() {
+  std::cout << "Test 2: BitRef in-place field writes..." << std::endl;
+
+  const auto pkt = make_remote();
+  std::array<uint8_t, 17> expected{};
+  RPL::serialize_bitstream<VT03RemotePacket>(expected, pkt);
+
+  // 从全 1 字节开始逐字段写入，验证 set 会清除旧位
+  std::array<uint8_t, 17> wire;
+  wire.fill(0xFF);
+  RPL::BitRef<VT03RemotePacket> ref{wire};
+  ref.encode(pkt);
+  assert(wire == expected);
+
+  ref.set<kTrigger>(0);
+  ref.set<kWheel>(5);
+  ref.set<kMouseX>(42);
+  assert(ref.get<kTrigger>() == 0);
+  assert(ref.get<kWheel>() == 5);
+  assert(ref.get<kMouseX>() == 42);
+  // 相邻字段未被破坏
+  assert(ref.get<kRightStickX>() == 1684);
+  assert(ref.get<kSwitchState>() == 2);
+  assert(ref.get<kKeyW>() == 1);
+
+  auto modified = pkt;
+  modified.trigger = 0;
+  modified.wheel = 5;
+  modified.mouse_x = 42;
+  std::array<uint8_t, 17> expected_modified{};
+  RPL::serialize_bitstream<VT03RemotePacket>(expected_modified, modified);
+  assert(wire == expected_modified);
+
+  // 超出位宽的值被截断
+  ref.set<kSwitchState>(0xFF);
+  assert(ref.get<kSwitchState>() == 3);
+  assert(ref.get<kSwitchState + 1>() == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+static int g_view_hook_calls = 0;
+static uint16_t g_view_hook_mode = 0;
+
+struct ViewHookPacket {
+  uint16_t speed : 12;
+  uint16_t mode : 4;
+  uint8_t flags;
+};
+
+template <>
+struct RPL::Meta::PacketTraits<ViewHookPacket>
+    : PacketTraitsBase<PacketTraits<ViewHookPacket>> {
+  static constexpr uint16_t cmd = 0x0230;
+  static constexpr size_t size = 3;
+  using BitLayout =
+      std::tuple<Field<uint16_t, 12>, Field<uint16_t, 4>, Field<uint8_t, 8>>;
+
+  static void after_parse(RPL::BitView<ViewHookPacket> view) {
+    ++g_view_hook_calls;
+    g_view_hook_mode = view.get<1>();
+  }
+};
+
+void test_after_parse_view_hook() {
+  std::cout << "Test 3: after_parse with BitView..." << std::endl;
+
+  RPL::Deserializer<ViewHookPacket> deserializer;
+  RPL::Parser<ViewHookPacket> parser{deserializer};
+  RPL::Serializer<ViewHookPacket> serializer;
+
+  ViewHookPacket pkt{};
+  pkt.speed = 0xABC;
+  pkt.mode = 9;
+  pkt.flags = 0x5A;
+
+  std::array<uint8_t, 64> buf{};
+  auto len = serializer.serialize(buf.data(), buf.size(), pkt);
+  assert(len.has_value());
+
+  // 分两次推送，跨越多次调用
+  auto r1 = parser.push_data(buf.data(), 4);
+  assert(r1.has_value());
+  assert(g_view_hook_calls == 0);
+  auto r2 = parser.push_data(buf.data() + 4, *len - 4);
+  assert(r2.has_value());
+  assert(g_view_hook_calls == 1);
+  assert(g_view_hook_mode == 9);
+
+  // 默认 skip_memory_pool = false，数据仍写入内存池
+  assert(deserializer.get<ViewHookPacket>().speed == 0xABC);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_deserializer_field_access() {
+  std::cout << "Test 4: Deserializer get_field / view..." << std::endl;
+
+  RPL::Deserializer<VT03RemotePacket> deserializer;
+  RPL::Parser<VT03RemotePacket> parser{deserializer};
+  RPL::Serializer<VT03RemotePacket> serializer;
+
+  const auto pkt = make_remote();
+  std::array<uint8_t, 64> buf{};
+  auto len = serializer.serialize(buf.data(), buf.size(), pkt);
+  assert(len.has_value());
+  auto parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+
+  assert((deserializer.get_field<VT03RemotePacket, kTrigger>() == 1));
+  assert((deserializer.get_field<VT03RemotePacket, kMouseX>() == -120));
+  assert((deserializer.get_field<VT03RemotePacket, kKeyB>() == 1));
+
+  auto view = deserializer.view<VT03RemotePacket>();
+  assert(view.get<kWheel>() == 777);
+  assert(view.decode().right_stick_y == 364);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL BitView Tests ===" << std::endl;
+
+  test_view_matches_full_decode();
+  test_bit_ref_in_place_write();
+  test_after_parse_view_hook();
+  test_deserializer_field_access();
+
+  std::cout << "\nAll BitView tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,208 @@
+#include <RPL/Containers/DmaRingBuffer.hpp>
+#include <RPL/Deserializer.hpp>
+#include <RPL/FrameRelay.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Packets/Sample/SampleB.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// 与 SampleA 负载相同、走 USB 帧头的数据包
+struct UsbSampleA : SampleA {};
+
+namespace RPL::Meta {
+template <>
+struct PacketTraits<UsbSampleA> : PacketTraitsBase<PacketTraits<UsbSampleA>> {
+  using Protocol = USBBaseProto;
+  static constexpr uint16_t cmd = 0x0102;
+  static constexpr size_t size = sizeof(SampleA);
+};
+} // namespace RPL::Meta
+
+// 收集输出帧的输出端
+struct Collector {
+  std::vector<std::vector<uint8_t>> frames;
+  size_t max_parts = 0;
+  bool accept = true;
+
+  bool operator()(const RPL::FrameParts &parts) {
+    std::vector<uint8_t> frame(parts.size());
+    const size_t copied = parts.copy_to(frame.data(), frame.size());
+    assert(copied == frame.size());
+    frames.push_back(std::move(frame));
+    max_parts = std::max(max_parts, parts.count);
+    return accept;
+  }
+};
+
+template <typename... Ps>
+static std::vector<uint8_t> serialize(const Ps &...packets) {
+  RPL::Serializer<Ps...> ser;
+  std::vector<uint8_t> out(256);
+  out.resize(ser.serialize(out.data(), out.size(), packets...).value());
+  return out;
+}
+
+void test_pass_through() {
+  std::cout << "Test 1: Pass-through keeps the original bytes..." << std::endl;
+
+  RPL::Deserializer<SampleA, SampleB> des;
+  RPL::Parser<SampleA, SampleB> parser{des};
+  RPL::FrameRelay relay{Collector{}};
+  const bool routed = relay.forward(RPL::Meta::PacketTraits<SampleA>::cmd);
+  assert(routed);
+  relay.attach(parser);
+
+  const SampleA a{9, -7, 3.5f, 1.0};
+  const SampleB b{11, 2.0};
+  const auto frame_a = serialize(a);
+  const auto stream = serialize(a, b);
+  auto parsed = parser.push_data(stream.data(), stream.size());
+  assert(parsed.has_value());
+
+  // 只转发 SampleA，字节与原始帧完全相同
+  assert(relay.sink().frames.size() == 1);
+  assert(relay.sink().frames[0] == frame_a);
+  assert(relay.forwarded() == 1 && relay.unrouted() == 1);
+  // Deserializer 照常更新
+  assert(des.get<SampleB>().x == 11);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_rewrap_to_usb() {
+  std::cout << "Test 2: Referee frames re-wrapped into USB frames..."
+            << std::endl;
+
+  RPL::Deserializer<SampleA> des;
+  RPL::Parser<SampleA> parser{des};
+  RPL::FrameRelay relay{Collector{}};
+  const bool routed = relay.rewrap<RPL::Meta::USBBaseProto>(relay.any_cmd);
+  assert(routed);
+  relay.attach(parser);
+
+  const SampleA a{42, 1234, -0.5f, 8.25};
+  const auto frame = serialize(a);
+  auto parsed = parser.push_data(frame.data(), frame.size());
+  assert(parsed.has_value());
+  assert(relay.sink().frames.size() == 1);
+  // 新帧头 + 负载视图（USB 帧无帧尾）
+  assert(relay.sink().max_parts == 2);
+
+  const auto &usb = relay.sink().frames[0];
+  assert(usb.size() == RPL::Meta::USBBaseProto::header_size + sizeof(SampleA));
+  assert(usb == serialize(UsbSampleA{a}));
+
+  RPL::Deserializer<UsbSampleA> usb_des;
+  RPL::Parser<UsbSampleA> usb_parser{usb_des};
+  parsed = usb_parser.push_data(usb.data(), usb.size());
+  assert(parsed.has_value());
+  assert(usb_des.get<UsbSampleA>().a == 42);
+  assert(usb_des.get<UsbSampleA>().b == 1234);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_rewrap_wrapped_payload() {
+  std::cout << "Test 3: Re-wrap across the ring boundary with cmd remap..."
+            << std::endl;
+
+  // USB 帧在 DMA 环形缓冲区上跨越末尾，转成带 CRC 的裁判系统帧
+  using Ring = RPL::Containers::DmaRingBuffer<64>;
+  uint8_t ring[64]{};
+  RPL::Deserializer<UsbSampleA> des;
+  RPL::Parser<Ring, UsbSampleA> parser{des, ring};
+  RPL::FrameRelay relay{Collector{}};
+  const bool routed = relay.rewrap<RPL::Meta::DefaultProtocol>(
+      RPL::Meta::PacketTraits<UsbSampleA>::cmd,
+      RPL::Meta::PacketTraits<SampleA>::cmd);
+  assert(routed);
+  relay.attach(parser);
+
+  size_t hw = 0;
+  for (uint8_t n = 0; n < 8; ++n) {
+    const auto frame =
+        serialize(UsbSampleA{{n, static_cast<int16_t>(n * 3), 0.0f, 0.0}});
+    for (uint8_t byte : frame) {
+      ring[hw] = byte;
+      hw = (hw + 1) % sizeof(ring);
+    }
+    auto parsed = parser.update_write_index(hw);
+    assert(parsed.has_value());
+  }
+  assert(relay.forwarded() == 8);
+
+  RPL::Deserializer<SampleA> out_des;
+  RPL::Parser<SampleA> out_parser{out_des};
+  for (size_t i = 0; i < relay.sink().frames.size(); ++i) {
+    const auto &f = relay.sink().frames[i];
+    // 输入无序列号，使用转发器自己的递增序列号
+    assert(f[RPL::Meta::DefaultProtocol::seq_offset] == i);
+    auto parsed = out_parser.push_data(f.data(), f.size());
+    assert(parsed.has_value());
+    assert(out_des.get<SampleA>().a == i);
+    assert(out_des.get<SampleA>().b == static_cast<int16_t>(i * 3));
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_filter_and_rejects() {
+  std::cout << "Test 4: Filter, exact routes over any_cmd, sink rejects..."
+            << std::endl;
+
+  RPL::Deserializer<SampleA, SampleB> des;
+  RPL::Parser<SampleA, SampleB> parser{des};
+  RPL::FrameRelay<Collector, 2> relay{Collector{}};
+  bool routed = relay.forward_all();
+  assert(routed);
+  routed = relay.rewrap<RPL::Meta::USBBaseProto>(
+      RPL::Meta::PacketTraits<SampleB>::cmd);
+  assert(routed);
+  routed = relay.forward(0x0301);
+  assert(!routed); // 路由表已满
+  relay.attach(parser);
+
+  // 只放行 a 为偶数的 SampleA
+  relay.set_filter([](void *, const RPL::RawFrame &frame) {
+    if (frame.cmd != RPL::Meta::PacketTraits<SampleA>::cmd)
+      return true;
+    return frame.payload_s1[0] % 2 == 0;
+  });
+
+  for (uint8_t n = 0; n < 4; ++n) {
+    const auto stream = serialize(SampleA{n, 0, 0.0f, 0.0}, SampleB{n, 0.0});
+    auto parsed = parser.push_data(stream.data(), stream.size());
+    assert(parsed.has_value());
+  }
+  assert(relay.filtered() == 2);
+  assert(relay.forwarded() == 6);
+  // SampleB 走精确路由（USB 帧头），SampleA 走 any_cmd（原样）
+  size_t usb_frames = 0;
+  for (const auto &f : relay.sink().frames)
+    usb_frames += f.size() == RPL::Meta::USBBaseProto::header_size +
+                                  sizeof(SampleB);
+  assert(usb_frames == 4);
+
+  relay.sink().accept = false;
+  const auto stream = serialize(SampleB{99, 0.0});
+  auto parsed = parser.push_data(stream.data(), stream.size());
+  assert(parsed.has_value());
+  assert(relay.rejected() == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Frame Relay Tests ===" << std::endl;
+  test_pass_through();
+  test_rewrap_to_usb();
+  test_rewrap_wrapped_payload();
+  test_filter_and_rejects();
+  std::cout << "\nAll frame relay tests passed!" << std::endl;
+  return 0;
+}
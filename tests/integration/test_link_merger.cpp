@@ -0,0 +1,244 @@
+#include <RPL/Deserializer.hpp>
+#include <RPL/LinkMerger.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Packets/Sample/SampleB.hpp>
+#include <RPL/Packets/Sample/USBSamples.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// 手动推进的时钟
+struct FakeTick {
+  using tick_type = uint32_t;
+  static inline uint32_t value = 0;
+  static tick_type now() { return value; }
+};
+
+using Merger = RPL::LinkMerger<FakeTick>;
+
+// 统计真正被分发的数据包
+static size_t g_dispatched = 0;
+
+static void count_packet(void *, uint16_t, std::span<const uint8_t>,
+                         std::span<const uint8_t>) {
+  ++g_dispatched;
+}
+
+template <typename ParserType>
+static void push(ParserType &parser, const std::vector<uint8_t> &frame) {
+  auto parsed = parser.push_data(frame.data(), frame.size());
+  assert(parsed.has_value());
+}
+
+void test_first_arrival_wins() {
+  std::cout << "Test 1: Duplicates dropped, first arrival kept..." << std::endl;
+
+  FakeTick::value = 0;
+  g_dispatched = 0;
+  RPL::Deserializer<SampleA, SampleB> des;
+  RPL::Parser<SampleA, SampleB> uart{des}, usb{des};
+  uart.set_packet_hook({nullptr, &count_packet});
+  usb.set_packet_hook({nullptr, &count_packet});
+  Merger merger{10};
+  merger.attach(0, uart);
+  merger.attach(1, usb);
+
+  RPL::Serializer<SampleA> ser;
+  for (uint8_t n = 0; n < 6; ++n) {
+    std::vector<uint8_t> frame(64);
+    frame.resize(
+        ser.serialize(frame.data(), frame.size(), SampleA{n, 0, 0.0f, 0.0})
+            .value());
+    // 偶数帧 UART 先到（领先 2 tick），奇数帧 USB 先到（领先 4 tick）
+    if (n % 2 == 0) {
+      push(uart, frame);
+      FakeTick::value += 2;
+      push(usb, frame);
+    } else {
+      push(usb, frame);
+      FakeTick::value += 4;
+      push(uart, frame);
+    }
+    assert(des.get<SampleA>().a == n);
+    FakeTick::value += 1;
+  }
+
+  assert(g_dispatched == 6);
+  assert(merger.stats(0).frames == 6 && merger.stats(1).frames == 6);
+  assert(merger.stats(0).first == 3 && merger.stats(0).duplicates == 3);
+  assert(merger.stats(1).first == 3 && merger.stats(1).duplicates == 3);
+  assert(merger.stats(0).average_lead() == 2.0);
+  assert(merger.stats(1).average_lead() == 4.0);
+
+  merger.settle();
+  assert(merger.stats(0).missed == 0 && merger.stats(1).missed == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_loss_is_covered() {
+  std::cout << "Test 2: Lost frames filled in by the other link..."
+            << std::endl;
+
+  FakeTick::value = 100;
+  g_dispatched = 0;
+  RPL::Deserializer<SampleB> des;
+  RPL::Parser<SampleB> a{des}, b{des};
+  a.set_packet_hook({nullptr, &count_packet});
+  b.set_packet_hook({nullptr, &count_packet});
+  Merger merger{5};
+  merger.attach(0, a);
+  merger.attach(1, b);
+
+  RPL::Serializer<SampleB> ser;
+  for (int n = 0; n < 10; ++n) {
+    std::vector<uint8_t> frame(64);
+    frame.resize(
+        ser.serialize(frame.data(), frame.size(), SampleB{n, 0.5}).value());
+    // 链路 0 丢失 n % 3 == 0 的帧，链路 1 丢失 n == 4
+    if (n % 3 != 0)
+      push(a, frame);
+    if (n != 4)
+      push(b, frame);
+    assert(des.get<SampleB>().x == n);
+    FakeTick::value += 1;
+  }
+  assert(g_dispatched == 10);
+
+  // 窗口过后退役，丢失计入未送达的链路
+  FakeTick::value += 10;
+  merger.expire();
+  assert(merger.stats(0).missed == 4);
+  assert(merger.stats(1).missed == 1);
+  assert(merger.stats(0).frames + merger.stats(1).frames == 15);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_sequence_distinguishes_repeats() {
+  std::cout << "Test 3: Same payload with new sequence is a new frame..."
+            << std::endl;
+
+  FakeTick::value = 0;
+  g_dispatched = 0;
+  RPL::Deserializer<SampleB> des;
+  RPL::Parser<SampleB> a{des}, b{des};
+  a.set_packet_hook({nullptr, &count_packet});
+  b.set_packet_hook({nullptr, &count_packet});
+  Merger merger{50};
+  merger.attach(0, a);
+  merger.attach(1, b);
+
+  // 内容不变的周期性数据包：序列号递增，各自是新帧
+  RPL::Serializer<SampleB> ser;
+  std::vector<std::vector<uint8_t>> frames;
+  for (int n = 0; n < 3; ++n) {
+    std::vector<uint8_t> frame(64);
+    frame.resize(
+        ser.serialize(frame.data(), frame.size(), SampleB{7, 7.0}).value());
+    frames.push_back(frame);
+  }
+  for (const auto &f : frames)
+    push(a, f);
+  for (const auto &f : frames)
+    push(b, f);
+  assert(g_dispatched == 3);
+  assert(merger.stats(0).first == 3 && merger.stats(1).duplicates == 3);
+
+  // 同一链路重发完全相同的帧：视为新帧
+  push(a, frames[0]);
+  assert(g_dispatched == 4);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_window_and_overflow() {
+  std::cout << "Test 4: Late duplicates and history overflow..." << std::endl;
+
+  FakeTick::value = 0;
+  g_dispatched = 0;
+  RPL::Deserializer<SampleB> des;
+  RPL::Parser<SampleB> a{des}, b{des};
+  a.set_packet_hook({nullptr, &count_packet});
+  b.set_packet_hook({nullptr, &count_packet});
+  RPL::LinkMerger<FakeTick, 2, 4> merger{3};
+  merger.attach(0, a);
+  merger.attach(1, b);
+
+  RPL::Serializer<SampleB> ser;
+  std::vector<uint8_t> frame(64);
+  frame.resize(
+      ser.serialize(frame.data(), frame.size(), SampleB{1, 1.0}).value());
+  push(a, frame);
+  // 超过窗口才到达：记录已退役，链路 1 计丢失，迟到帧按新帧处理
+  FakeTick::value = 10;
+  push(b, frame);
+  assert(g_dispatched == 2);
+  assert(merger.stats(1).missed == 1 && merger.stats(1).first == 1);
+
+  // 窗口内超过 History 个帧：最早的记录被挤出
+  for (int n = 0; n < 6; ++n) {
+    frame.assign(64, 0);
+    frame.resize(
+        ser.serialize(frame.data(), frame.size(), SampleB{n + 10, 0.0})
+            .value());
+    push(a, frame);
+  }
+  assert(merger.overflows() == 3);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_repeats_without_sequence() {
+  std::cout << "Test 5: Repeated content without sequence pairs in order..."
+            << std::endl;
+
+  FakeTick::value = 0;
+  g_dispatched = 0;
+  RPL::Deserializer<SensorData> des;
+  RPL::Parser<SensorData> uart{des}, usb{des};
+  uart.set_packet_hook({nullptr, &count_packet});
+  usb.set_packet_hook({nullptr, &count_packet});
+  Merger merger{10};
+  merger.attach(0, uart);
+  merger.attach(1, usb);
+
+  // USBBaseProto 无序列号：两次发送的字节完全相同
+  RPL::Serializer<SensorData> ser;
+  std::vector<uint8_t> frame(64);
+  frame.resize(ser.serialize(frame.data(), frame.size(),
+                             SensorData{1.0f, 2.0f, 3.0f})
+                   .value());
+
+  push(uart, frame); // t=0
+  FakeTick::value = 2;
+  push(uart, frame); // t=2
+  FakeTick::value = 3;
+  push(usb, frame); // t=3，对应 t=0 的一份
+  FakeTick::value = 5;
+  push(usb, frame); // t=5，对应 t=2 的一份
+
+  assert(g_dispatched == 2);
+  assert(merger.stats(0).first == 2 && merger.stats(1).duplicates == 2);
+  assert(merger.stats(1).first == 0);
+  assert(merger.stats(0).average_lead() == 3.0);
+
+  merger.settle();
+  assert(merger.stats(0).missed == 0 && merger.stats(1).missed == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Link Merger Tests ===" << std::endl;
+  test_first_arrival_wins();
+  test_loss_is_covered();
+  test_sequence_distinguishes_repeats();
+  test_window_and_overflow();
+  test_repeats_without_sequence();
+  std::cout << "\nAll link merger tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,280 @@
+#include <RPL/Deserializer.hpp>
+#include <RPL/OfflineParser.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Packets/Sample/SampleB.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// 走 USB 帧头的数据包（与裁判系统帧共享起始字节 0xA5）
+struct UsbPing {
+  uint32_t v;
+};
+
+namespace RPL::Meta {
+template <>
+struct PacketTraits<UsbPing> : PacketTraitsBase<PacketTraits<UsbPing>> {
+  using Protocol = USBBaseProto;
+  static constexpr uint16_t cmd = 0x0201;
+  static constexpr size_t size = sizeof(UsbPing);
+};
+} // namespace RPL::Meta
+
+// 与 USB 帧共享起始字节的裁判系统帧：seq 为 0x02 时帧头的前 5 字节
+// 恰好也是一个合法的 UsbBlob 帧头（长度 24，cmd 0x1002）
+struct RefereeBlob {
+  uint8_t data[24];
+};
+
+struct UsbBlob {
+  uint8_t data[24];
+};
+
+namespace RPL::Meta {
+template <>
+struct PacketTraits<RefereeBlob>
+    : PacketTraitsBase<PacketTraits<RefereeBlob>> {
+  static constexpr uint16_t cmd = 0x0305;
+  static constexpr size_t size = sizeof(RefereeBlob);
+};
+
+template <>
+struct PacketTraits<UsbBlob> : PacketTraitsBase<PacketTraits<UsbBlob>> {
+  using Protocol = USBBaseProto;
+  static constexpr uint16_t cmd = 0x1002;
+  static constexpr size_t size = sizeof(UsbBlob);
+};
+} // namespace RPL::Meta
+
+using Offline = RPL::OfflineParser<SampleA, SampleB, UsbPing>;
+
+struct RefFrame {
+  uint16_t cmd;
+  size_t size;
+  std::vector<uint8_t> payload;
+};
+
+// 顺序 Parser 的结果：帧列表与缓冲区中剩余的字节数
+struct Reference {
+  std::vector<RefFrame> frames;
+  size_t remaining = 0;
+};
+
+template <typename... Ts>
+static Reference parse_sequential(const std::vector<uint8_t> &capture) {
+  Reference ref;
+  RPL::Deserializer<Ts...> des;
+  RPL::Parser<Ts...> parser{des};
+  parser.set_frame_hook({&ref, [](void *ctx, const RPL::RawFrame &f) {
+                           RefFrame r{f.cmd, f.size(), {}};
+                           r.payload.assign(f.payload_s1.begin(),
+                                            f.payload_s1.end());
+                           r.payload.insert(r.payload.end(),
+                                            f.payload_s2.begin(),
+                                            f.payload_s2.end());
+                           static_cast<Reference *>(ctx)->frames.push_back(r);
+                           return true;
+                         }});
+  for (size_t off = 0; off < capture.size(); off += 16) {
+    const size_t n = std::min<size_t>(16, capture.size() - off);
+    auto parsed = parser.push_data(capture.data() + off, n);
+    assert(parsed.has_value());
+  }
+  ref.remaining = parser.available_data();
+  return ref;
+}
+
+// 合法帧、噪声、损坏帧与截断帧交错的录制数据，以截断帧结尾
+static std::vector<uint8_t> make_capture(uint32_t seed, size_t events) {
+  std::mt19937 rng(seed);
+  RPL::Serializer<SampleA, SampleB, UsbPing> ser;
+  std::vector<uint8_t> out;
+  auto frame = [&]() {
+    uint8_t buf[64];
+    size_t n = 0;
+    switch (rng() % 3) {
+    case 0:
+      n = ser.serialize(buf, sizeof(buf),
+                        SampleA{static_cast<uint8_t>(rng()),
+                                static_cast<int16_t>(rng()), 1.5f, 2.5})
+              .value();
+      break;
+    case 1:
+      n = ser.serialize(buf, sizeof(buf),
+                        SampleB{static_cast<int>(rng()), 0.25})
+              .value();
+      break;
+    default:
+      n = ser.serialize(buf, sizeof(buf), UsbPing{static_cast<uint32_t>(rng())}).value();
+      break;
+    }
+    return std::vector<uint8_t>(buf, buf + n);
+  };
+
+  for (size_t e = 0; e < events; ++e) {
+    const uint32_t kind = rng() % 10;
+    if (kind < 5) {
+      const auto f = frame();
+      out.insert(out.end(), f.begin(), f.end());
+    } else if (kind < 7) {
+      const size_t n = rng() % 24;
+      for (size_t i = 0; i < n; ++i)
+        out.push_back(rng() % 4 == 0 ? 0xA5 : static_cast<uint8_t>(rng()));
+    } else if (kind < 9) {
+      auto f = frame();
+      f[rng() % f.size()] ^= static_cast<uint8_t>(1 + rng() % 255);
+      out.insert(out.end(), f.begin(), f.end());
+    } else {
+      const auto f = frame();
+      out.insert(out.end(), f.begin(), f.begin() + 1 + rng() % (f.size() - 1));
+    }
+  }
+  const auto tail = frame();
+  out.insert(out.end(), tail.begin(), tail.end() - 3);
+  return out;
+}
+
+static void check_matches(const std::vector<uint8_t> &capture,
+                          const Reference &ref,
+                          const RPL::OfflineSegmentation &seg) {
+  assert(seg.frames.size() == ref.frames.size());
+  for (size_t i = 0; i < ref.frames.size(); ++i) {
+    const auto &f = seg.frames[i];
+    assert(f.cmd == ref.frames[i].cmd);
+    assert(f.size == ref.frames[i].size);
+    const auto payload = f.payload(capture);
+    assert(payload.size() == ref.frames[i].payload.size());
+    assert(std::memcmp(payload.data(), ref.frames[i].payload.data(),
+                       payload.size()) == 0);
+  }
+  assert(capture.size() - seg.consumed == ref.remaining);
+}
+
+void test_matches_sequential_parser() {
+  std::cout << "Test 1: Segmentation equals the sequential Parser..."
+            << std::endl;
+
+  const auto capture = make_capture(1234, 4000);
+  const auto ref = parse_sequential<SampleA, SampleB, UsbPing>(capture);
+  assert(ref.frames.size() > 1000);
+  assert(ref.remaining > 0);
+
+  // 不同的线程数与分块大小（含远小于一帧的分块）结果相同
+  const size_t configs[][2] = {{1, 1 << 20}, {4, 7}, {3, 64}, {8, 1000}};
+  for (const auto &cfg : configs) {
+    const Offline offline{cfg[0], cfg[1]};
+    check_matches(capture, ref, offline.segment(capture));
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_random_captures() {
+  std::cout << "Test 2: Randomized captures and chunk sizes..." << std::endl;
+
+  std::mt19937 rng(99);
+  for (int round = 0; round < 20; ++round) {
+    const auto capture = make_capture(rng(), 50 + rng() % 400);
+    const auto ref = parse_sequential<SampleA, SampleB, UsbPing>(capture);
+    const Offline offline{1 + rng() % 6, 1 + rng() % 300};
+    check_matches(capture, ref, offline.segment(capture));
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_parallel_decode() {
+  std::cout << "Test 3: Parallel decode dispatches by protocol and cmd..."
+            << std::endl;
+
+  const auto capture = make_capture(777, 2000);
+  const Offline offline{4, 256};
+  const auto seg = offline.segment(capture);
+  const auto ref = parse_sequential<SampleA, SampleB, UsbPing>(capture);
+
+  // 每帧恰好解码一次，类型与顺序 Parser 的命令码一致
+  std::vector<int> kind(seg.frames.size(), -1);
+  std::vector<int64_t> value(seg.frames.size(), 0);
+  offline.decode(capture, seg.frames, [&](size_t i, const auto &packet) {
+    using T = std::decay_t<decltype(packet)>;
+    assert(kind[i] == -1);
+    if constexpr (std::is_same_v<T, SampleA>) {
+      kind[i] = 0;
+      value[i] = packet.a;
+    } else if constexpr (std::is_same_v<T, SampleB>) {
+      kind[i] = 1;
+      value[i] = packet.x;
+    } else {
+      kind[i] = 2;
+      value[i] = packet.v;
+    }
+  });
+
+  for (size_t i = 0; i < seg.frames.size(); ++i) {
+    const auto &payload = ref.frames[i].payload;
+    if (ref.frames[i].cmd == RPL::Meta::PacketTraits<UsbPing>::cmd) {
+      uint32_t v;
+      std::memcpy(&v, payload.data(), sizeof(v));
+      assert(kind[i] == 2 && value[i] == v);
+    } else if (ref.frames[i].cmd == RPL::Meta::PacketTraits<SampleA>::cmd) {
+      assert(kind[i] == 0 && value[i] == payload[0]);
+    } else {
+      int x;
+      std::memcpy(&x, payload.data(), sizeof(x));
+      assert(kind[i] == 1 && value[i] == x);
+    }
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_shared_start_byte_prefix() {
+  std::cout << "Test 4: USB frame inside a referee frame's prefix..."
+            << std::endl;
+
+  RefereeBlob blob{};
+  for (uint8_t i = 0; i < sizeof(blob.data); ++i)
+    blob.data[i] = static_cast<uint8_t>(0x40 + i);
+  const auto frame = RPL::Serializer<RefereeBlob>::make_frame(blob, 0x02);
+  assert(frame[3] == 0x02 && frame[4] == 0x10);
+  constexpr size_t usb_size = 5 + sizeof(UsbBlob);
+  static_assert(usb_size < frame.size());
+
+  // 完整帧；CRC16 损坏的帧（只剩 USB 解释）；完整帧；
+  // 以超过 USB 帧长度的截断裁判系统帧结尾
+  std::vector<uint8_t> capture(frame.begin(), frame.end());
+  auto corrupted = frame;
+  corrupted.back() ^= 0xFF;
+  capture.insert(capture.end(), corrupted.begin(), corrupted.end());
+  capture.insert(capture.end(), frame.begin(), frame.end());
+  capture.insert(capture.end(), frame.begin(), frame.begin() + usb_size + 1);
+
+  const auto ref = parse_sequential<RefereeBlob, UsbBlob>(capture);
+  assert(ref.frames.size() == 3);
+  assert(ref.frames[0].cmd == 0x0305);
+  assert(ref.frames[1].cmd == 0x1002 && ref.frames[1].size == usb_size);
+  assert(ref.frames[2].cmd == 0x0305);
+  assert(ref.remaining == usb_size + 1);
+
+  const size_t configs[][2] = {{1, 1 << 20}, {2, 1}, {3, 7}, {4, 33}};
+  for (const auto &cfg : configs) {
+    const RPL::OfflineParser<RefereeBlob, UsbBlob> offline{cfg[0], cfg[1]};
+    check_matches(capture, ref, offline.segment(capture));
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Offline Parser Tests ===" << std::endl;
+  test_matches_sequential_parser();
+  test_random_captures();
+  test_parallel_decode();
+  test_shared_start_byte_prefix();
+  std::cout << "\nAll offline parser tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,181 @@
+#include <RPL/Deserializer.hpp>
+#include <RPL/FrameHandle.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+using InteractionTraits = RPL::Meta::PacketTraits<RobotInteractionData>;
+
+static RobotInteractionData make_interaction(uint16_t data_cmd_id,
+                                             uint8_t fill) {
+  RobotInteractionData pkt{};
+  pkt.data_cmd_id = data_cmd_id;
+  pkt.sender_id = 1;
+  pkt.receiver_id = 0x0101;
+  pkt.user_data.fill(fill);
+  return pkt;
+}
+
+static uint16_t read_length_field(const uint8_t *frame) {
+  return static_cast<uint16_t>(frame[1] | (frame[2] << 8));
+}
+
+void test_serialize_used_bytes_only() {
+  std::cout << "Test 1: Variable-length serialization..." << std::endl;
+
+  static_assert(RPL::Meta::HasVariableLength<RobotInteractionData>);
+  static_assert(!RPL::Meta::HasVariableLength<SampleA>);
+
+  using Ser = RPL::Serializer<RobotInteractionData, SampleA>;
+  Ser serializer;
+
+  // 0x0101 绘制一个图形：6 字节子头 + 15 字节
+  const auto figure = make_interaction(0x0101, 0x11);
+  assert(Ser::frame_size(figure) == 7 + 21 + 2);
+  assert(Ser::frame_size<RobotInteractionData>() == 7 + 118 + 2);
+
+  std::array<uint8_t, 256> buf{};
+  auto len = serializer.serialize(buf.data(), buf.size(), figure);
+  assert(len.has_value());
+  assert(*len == 30);
+  assert(read_length_field(buf.data()) == 21);
+  assert(RPL::ProtocolCRC8::calc(buf.data(), 4) == buf[4]);
+  const uint16_t crc = RPL::ProtocolCRC16::calc(buf.data(), *len - 2);
+  assert(buf[*len - 2] == (crc & 0xFF));
+  assert(buf[*len - 1] == (crc >> 8));
+
+  // 未知子内容按最大长度发送
+  const auto custom = make_interaction(0x0201, 0x22);
+  assert(Ser::frame_size(custom) == Ser::frame_size<RobotInteractionData>());
+
+  // 混合定长与变长包时按实际长度检查缓冲区
+  const SampleA sample{1, 2, 3.0f, 4.0};
+  const size_t needed = Ser::frame_size(figure) + Ser::frame_size(sample);
+  auto too_small = serializer.serialize(buf.data(), needed - 1, figure, sample);
+  assert(!too_small);
+  auto both = serializer.serialize(buf.data(), needed, figure, sample);
+  assert(both.has_value() && *both == needed);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_round_trip_records_length() {
+  std::cout << "Test 2: Parser/Deserializer record received length..."
+            << std::endl;
+
+  RPL::Deserializer<RobotInteractionData, SampleA> deserializer;
+  RPL::Parser<RobotInteractionData, SampleA> parser{deserializer};
+  RPL::Serializer<RobotInteractionData, SampleA> serializer;
+
+  assert(deserializer.received_size<RobotInteractionData>() == 0);
+
+  // 先收一个满长度包，再收一个短包：短包之后的槽位字节必须为 0
+  std::array<uint8_t, 256> buf{};
+  const auto full = make_interaction(0x0201, 0xEE);
+  auto len = serializer.serialize(buf.data(), buf.size(), full);
+  assert(len.has_value());
+  auto parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+  assert(deserializer.received_size<RobotInteractionData>() ==
+         InteractionTraits::size);
+
+  const auto layer_delete = make_interaction(0x0100, 0x5A);
+  len = serializer.serialize(buf.data(), buf.size(), layer_delete);
+  assert(len.has_value());
+  assert(*len == 7 + 8 + 2);
+  parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+
+  size_t received = 0;
+  const auto got = deserializer.get<RobotInteractionData>(received);
+  assert(received == 8);
+  assert(deserializer.received_size<RobotInteractionData>() == 8);
+  assert(got.data_cmd_id == 0x0100);
+  assert(got.receiver_id == 0x0101);
+  assert(got.user_data[0] == 0x5A && got.user_data[1] == 0x5A);
+  for (size_t i = 2; i < got.user_data.size(); ++i)
+    assert(got.user_data[i] == 0);
+
+  // 定长包的接收长度等于 PacketTraits::size
+  const SampleA sample{1, 2, 3.0f, 4.0};
+  len = serializer.serialize(buf.data(), buf.size(), sample);
+  assert(len.has_value());
+  parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+  assert(deserializer.received_size<SampleA>() == sizeof(SampleA));
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_oversized_payload_truncated() {
+  std::cout << "Test 3: Oversized payload does not overrun slot..."
+            << std::endl;
+
+  RPL::Deserializer<SampleA, RobotInteractionData> deserializer;
+  std::array<uint8_t, 64> payload{};
+  payload.fill(0x77);
+
+  // 长度超过 SampleA 的载荷被截断，不会写入相邻槽位
+  deserializer.write(RPL::Meta::PacketTraits<SampleA>::cmd, payload.data(),
+                     payload.size());
+  assert(deserializer.received_size<SampleA>() == sizeof(SampleA));
+  assert(deserializer.received_size<RobotInteractionData>() == 0);
+  const auto neighbour = deserializer.get<RobotInteractionData>();
+  assert(neighbour.data_cmd_id == 0);
+  assert(neighbour.user_data[0] == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_frame_handle_variable_length() {
+  std::cout << "Test 4: FrameHandle with variable-length packet..."
+            << std::endl;
+
+  auto pkt = make_interaction(0x0101, 0x10);
+  RPL::FrameHandle<RobotInteractionData> handle{pkt, 3};
+
+  auto check = [&](uint8_t seq) {
+    std::array<uint8_t, 256> expected{};
+    RPL::Serializer<RobotInteractionData> serializer;
+    // 序列化器从 0 开始计数，推进到目标序列号
+    for (uint8_t i = 0; i < seq; ++i)
+      (void)serializer.serialize(expected.data(), expected.size(), pkt);
+    auto len = serializer.serialize(expected.data(), expected.size(), pkt);
+    assert(len.has_value());
+    assert(*len == handle.size());
+    assert(std::memcmp(expected.data(), handle.data(), *len) == 0);
+  };
+  check(3);
+
+  pkt.user_data[4] = 0x99;
+  handle.update(pkt);
+  check(3);
+
+  handle.advance_seq();
+  check(4);
+
+  // 子内容变化导致负载长度变化时整帧重建
+  pkt.data_cmd_id = 0x0110;
+  handle.update(pkt);
+  assert(handle.size() == 7 + 6 + 45 + 2);
+  check(4);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Variable-Length Packet Tests ===" << std::endl;
+
+  test_serialize_used_bytes_only();
+  test_round_trip_records_length();
+  test_oversized_payload_truncated();
+  test_frame_handle_variable_length();
+
+  std::cout << "\nAll variable-length tests passed!" << std::endl;
+  return 0;
+}
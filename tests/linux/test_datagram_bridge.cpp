@@ -0,0 +1,202 @@
+#include "RPL/Deserializer.hpp"
+#include "RPL/Linux/DatagramBridge.hpp"
+#include "RPL/Packets/Sample/SampleA.hpp"
+#include "RPL/Packets/Sample/SampleB.hpp"
+#include "RPL/Parser.hpp"
+#include "RPL/Serializer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using PubParser = RPL::Parser<SampleA, SampleB>;
+using SubParser = RPL::Parser<SampleA>;
+
+static std::string socket_path(const char *name) {
+  return "/tmp/rpl_" + std::to_string(::getpid()) + "_" + name;
+}
+
+static std::vector<uint8_t> make_stream(uint8_t first, size_t count) {
+  RPL::Serializer<SampleA, SampleB> ser;
+  std::vector<uint8_t> stream;
+  uint8_t buf[64];
+  for (size_t i = 0; i < count; ++i) {
+    SampleA a{static_cast<uint8_t>(first + i), static_cast<int16_t>(i), 1.5f,
+              2.5};
+    SampleB b{static_cast<int>(i), 3.0};
+    size_t n = ser.serialize(buf, sizeof(buf), a, b).value();
+    stream.insert(stream.end(), buf, buf + n);
+  }
+  return stream;
+}
+
+// 分块推送（模拟串口每次 read 的数据），每块一次解析过程
+template <typename Pub>
+static void push_all(Pub &pub, PubParser &parser,
+                     const std::vector<uint8_t> &stream) {
+  for (size_t off = 0; off < stream.size(); off += size_t{32}) {
+    const size_t n = std::min(size_t{32}, stream.size() - off);
+    auto pushed = pub.push(parser, stream.data() + off, n);
+    assert(pushed.has_value());
+  }
+}
+
+template <typename Sub> static size_t drain(Sub &sub, uint64_t expected) {
+  size_t calls = 0;
+  while (sub.datagrams() < expected) {
+    auto r = sub.receive(true);
+    assert(r.has_value());
+    ++calls;
+  }
+  return calls;
+}
+
+void test_unix_fanout() {
+  std::cout << "Test 1: Unix datagram fan-out to two subscribers..."
+            << std::endl;
+
+  RPL::Deserializer<SampleA, SampleB> pub_des;
+  PubParser pub_parser{pub_des};
+  RPL::Deserializer<SampleA> des1, des2;
+  SubParser parser1{des1}, parser2{des2};
+
+  const auto path1 = socket_path("sub1"), path2 = socket_path("sub2");
+  RPL::Linux::DatagramSubscriber<SubParser> sub1{parser1}, sub2{parser2};
+  auto opened = sub1.open_unix(path1.c_str());
+  assert(opened.has_value());
+  opened = sub2.open_unix(path2.c_str());
+  assert(opened.has_value());
+
+  RPL::Linux::DatagramPublisher<> pub;
+  opened = pub.open_unix();
+  assert(opened.has_value());
+  opened = pub.add_unix_peer(path1.c_str());
+  assert(opened.has_value());
+  opened = pub.add_unix_peer(path2.c_str());
+  assert(opened.has_value());
+  pub.attach(pub_parser);
+
+  // 半帧到达时不转发，下一次解析过程补齐后一起发出
+  const auto stream = make_stream(10, 3);
+  const size_t half = 7;
+  auto pushed = pub.push(pub_parser, stream.data(), half);
+  assert(pushed.has_value());
+  assert(pub.sent() == 0);
+  push_all(pub, pub_parser,
+           std::vector<uint8_t>(stream.begin() + half, stream.end()));
+  assert(pub.queued() == 0);
+  assert(pub.sent() == 2 * 6);
+
+  drain(sub1, 6);
+  drain(sub2, 6);
+  // 订阅者只注册了 SampleA，SampleB 帧由其 Parser 跳过
+  assert(des1.get<SampleA>().a == 12);
+  assert(des2.get<SampleA>().a == 12);
+  assert(des2.get<SampleA>().c == 1.5f);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_udp_batching() {
+  std::cout << "Test 2: UDP loopback with sendmmsg batching..." << std::endl;
+
+  RPL::Deserializer<SampleA, SampleB> pub_des;
+  PubParser pub_parser{pub_des};
+  RPL::Deserializer<SampleA> sub_des;
+  SubParser sub_parser{sub_des};
+
+  RPL::Linux::DatagramSubscriber<SubParser, 16> sub{sub_parser};
+  uint16_t port = 0;
+  for (uint16_t p = 39170; p < 39190 && port == 0; ++p) {
+    if (sub.open_udp("127.0.0.1", p))
+      port = p;
+  }
+  assert(port != 0);
+
+  // 20 个 SampleA + 20 个 SampleB，批次大小 2：每次解析过程中批次满时自动 flush
+  RPL::Linux::DatagramPublisher<2> pub;
+  auto opened = pub.open_udp("127.0.0.1", port);
+  assert(opened.has_value());
+  pub.attach(pub_parser);
+  push_all(pub, pub_parser, make_stream(100, 20));
+  assert(pub.sent() == 40);
+  assert(pub.dropped() == 0);
+
+  drain(sub, 40);
+  assert(sub.truncated() == 0);
+  assert(sub_des.get<SampleA>().a == 119);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_multicast() {
+  std::cout << "Test 3: UDP multicast on loopback..." << std::endl;
+
+  RPL::Deserializer<SampleA> sub_des;
+  SubParser sub_parser{sub_des};
+  RPL::Linux::DatagramSubscriber<SubParser> sub{sub_parser};
+  RPL::Linux::DatagramPublisher<> pub;
+  if (!sub.open_udp("239.255.42.1", 39201, "127.0.0.1") ||
+      !pub.open_udp("239.255.42.1", 39201, "127.0.0.1")) {
+    std::cout << "  SKIP (multicast not available)" << std::endl;
+    return;
+  }
+
+  RPL::Deserializer<SampleA, SampleB> pub_des;
+  PubParser pub_parser{pub_des};
+  pub.attach(pub_parser);
+  const auto stream = make_stream(50, 1);
+  if (!pub.push(pub_parser, stream.data(), stream.size()) || pub.sent() != 2) {
+    std::cout << "  SKIP (multicast not routable)" << std::endl;
+    return;
+  }
+  drain(sub, 2);
+  assert(sub_des.get<SampleA>().a == 50);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_absent_subscriber() {
+  std::cout << "Test 4: Absent subscriber does not stall the publisher..."
+            << std::endl;
+
+  RPL::Deserializer<SampleA, SampleB> pub_des;
+  PubParser pub_parser{pub_des};
+  const auto path = socket_path("live");
+  RPL::Deserializer<SampleA> sub_des;
+  SubParser sub_parser{sub_des};
+  RPL::Linux::DatagramSubscriber<SubParser> sub{sub_parser};
+  auto opened = sub.open_unix(path.c_str());
+  assert(opened.has_value());
+
+  RPL::Linux::DatagramPublisher<> pub;
+  opened = pub.open_unix();
+  assert(opened.has_value());
+  opened = pub.add_unix_peer(socket_path("gone").c_str());
+  assert(opened.has_value());
+  opened = pub.add_unix_peer(path.c_str());
+  assert(opened.has_value());
+  pub.attach(pub_parser);
+
+  push_all(pub, pub_parser, make_stream(70, 2));
+  assert(pub.dropped() == 4);
+  assert(pub.sent() == 4);
+  assert(pub_des.get<SampleA>().a == 71);
+
+  drain(sub, 4);
+  assert(sub_des.get<SampleA>().a == 71);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Datagram Bridge Tests ===" << std::endl;
+  test_unix_fanout();
+  test_udp_batching();
+  test_multicast();
+  test_absent_subscriber();
+  std::cout << "\nAll datagram bridge tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,385 @@
+#include <RPL/Deserializer.hpp>
+#include <RPL/FrameRelay.hpp>
+#include <RPL/Linux/Gateway.hpp>
+#include <RPL/Packets/RoboMaster/InteractionFigure.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Packets/Sample/SampleB.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using Des = RPL::Deserializer<SampleA, SampleB>;
+using LinkParser = RPL::Parser<SampleA, SampleB>;
+
+struct Pipe {
+  int rd = -1;
+  int wr = -1;
+  Pipe() {
+    int fds[2];
+    const int rc = ::pipe(fds);
+    assert(rc == 0);
+    rd = fds[0];
+    wr = fds[1];
+  }
+  ~Pipe() {
+    ::close(rd);
+    if (wr >= 0)
+      ::close(wr);
+  }
+  void write_all(const std::vector<uint8_t> &data) const {
+    size_t done = 0;
+    while (done < data.size()) {
+      const ssize_t n = ::write(wr, data.data() + done, data.size() - done);
+      assert(n > 0);
+      done += static_cast<size_t>(n);
+    }
+  }
+};
+
+// 连续 count 个 SampleB，x 从 base 递增
+static std::vector<uint8_t> sample_b_stream(int base, int count) {
+  RPL::Serializer<SampleB> ser;
+  std::vector<uint8_t> out;
+  for (int i = 0; i < count; ++i) {
+    uint8_t frame[64];
+    const size_t n = ser.serialize(frame, sizeof(frame), SampleB{base + i, 0.0})
+                         .value();
+    out.insert(out.end(), frame, frame + n);
+  }
+  return out;
+}
+
+template <typename Pred> static bool wait_for(Pred pred) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+void test_local_links() {
+  std::cout << "Test 1: Per-link Deserializers on pinned workers..."
+            << std::endl;
+
+  constexpr size_t links = 4;
+  constexpr int frames = 300;
+  std::array<Pipe, links> pipes;
+  std::array<Des, links> des;
+  std::vector<std::unique_ptr<LinkParser>> parsers;
+  RPL::Linux::Gateway<> gw;
+  for (size_t i = 0; i < links; ++i) {
+    parsers.push_back(std::make_unique<LinkParser>(des[i]));
+    auto id = gw.add_link(pipes[i].rd, *parsers[i]);
+    assert(id && *id == i);
+  }
+  auto started = gw.start(2);
+  assert(started.has_value());
+  assert(gw.worker_count() == 2);
+  auto late = gw.add_link(pipes[0].rd, *parsers[0]);
+  assert(!late.has_value());
+
+  for (size_t i = 0; i < links; ++i)
+    pipes[i].write_all(sample_b_stream(static_cast<int>(i) * 1000, frames));
+  const bool done = wait_for([&] {
+    for (size_t i = 0; i < links; ++i)
+      if (gw.link_stats(i).frames != frames)
+        return false;
+    return true;
+  });
+  assert(done);
+  gw.stop();
+
+  for (size_t i = 0; i < links; ++i) {
+    assert(des[i].get<SampleB>().x == static_cast<int>(i) * 1000 + frames - 1);
+    assert(gw.link_stats(i).dropped == 0);
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_shared_publish_keeps_order() {
+  std::cout << "Test 2: Shared Deserializer keeps per-link order..."
+            << std::endl;
+
+  constexpr int frames = 2000;
+  Pipe burst, quiet;
+  Des shared;
+  LinkParser p0{shared}, p1{shared};
+  RPL::Linux::Gateway<4, 4096> gw;
+  gw.set_budget(1); // 突发链路每次 read() 后让出，便于被窃取
+  auto added = gw.add_link(burst.rd, p0, RPL::Linux::LinkMode::Shared);
+  assert(added.has_value());
+  added = gw.add_link(quiet.rd, p1, RPL::Linux::LinkMode::Shared);
+  assert(added.has_value());
+  auto started = gw.start(4, false);
+  assert(started.has_value());
+
+  std::thread writer([&] {
+    const auto stream = sample_b_stream(0, frames);
+    // 小块写入，制造多次就绪
+    for (size_t off = 0; off < stream.size(); off += 256)
+      burst.write_all({stream.begin() + static_cast<long>(off),
+                       stream.begin() + static_cast<long>(
+                                            std::min(off + 256, stream.size()))});
+    RPL::Serializer<SampleA> ser;
+    uint8_t frame[64];
+    const size_t n =
+        ser.serialize(frame, sizeof(frame), SampleA{7, 0, 0.0f, 0.0}).value();
+    quiet.write_all({frame, frame + n});
+  });
+
+  // 共享 Deserializer 中的值只能单调递增
+  size_t published = 0;
+  int last = -1;
+  bool done = wait_for([&] {
+    const size_t before = published;
+    published += gw.publish();
+    if (published != before) {
+      const int x = shared.get<SampleB>().x;
+      assert(x >= last);
+      last = x;
+    }
+    return published == frames + 1;
+  });
+  assert(done);
+  writer.join();
+
+  assert(shared.get<SampleB>().x == frames - 1);
+  assert(shared.get<SampleA>().a == 7);
+  assert(gw.link_stats(0).frames == frames);
+  assert(gw.link_stats(0).dropped == 0);
+
+  // 写端关闭后链路标记为不可读
+  ::close(burst.wr);
+  burst.wr = -1;
+  done = wait_for([&] { return !gw.link_stats(0).open; });
+  assert(done);
+  assert(gw.link_stats(1).open);
+  gw.stop();
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_queue_full_drops() {
+  std::cout << "Test 3: Full frame queue drops without blocking..."
+            << std::endl;
+
+  Pipe link;
+  Des shared;
+  LinkParser parser{shared};
+  RPL::Linux::Gateway<1, 8> gw;
+  auto added = gw.add_link(link.rd, parser, RPL::Linux::LinkMode::Shared);
+  assert(added.has_value());
+  auto started = gw.start(1, false);
+  assert(started.has_value());
+
+  link.write_all(sample_b_stream(0, 20));
+  bool done = wait_for([&] { return gw.link_stats(0).frames == 20; });
+  assert(done);
+  assert(gw.link_stats(0).dropped == 12);
+  size_t published = gw.publish();
+  assert(published == 8);
+  assert(shared.get<SampleB>().x == 7);
+
+  // 腾出空间后继续接收，序号不因丢弃出现空洞
+  link.write_all(sample_b_stream(100, 3));
+  done = wait_for([&] { return gw.link_stats(0).frames == 23; });
+  assert(done);
+  published = gw.publish();
+  assert(published == 3);
+  assert(shared.get<SampleB>().x == 102);
+  gw.stop();
+
+  std::cout << "  PASS" << std::endl;
+}
+
+struct FairnessProbe {
+  const Pipe *quiet = nullptr;
+  RPL::Linux::Gateway<> *gw = nullptr;
+  uint64_t busy_bytes = 0; ///< 安静链路出帧时忙碌链路已读取的字节数
+};
+
+void test_busy_link_does_not_starve() {
+  std::cout << "Test 4: A busy link does not starve its neighbours..."
+            << std::endl;
+
+  // 忙碌链路：一帧 SampleA 之后是远超一轮 read() 的填充数据
+  std::vector<uint8_t> stream(60 * 1024, 0);
+  RPL::Serializer<SampleA> ser;
+  (void)ser.serialize(stream.data(), stream.size(), SampleA{1, 0, 0.0f, 0.0})
+      .value();
+
+  Pipe busy, quiet;
+  Des des;
+  LinkParser p0{des}, p1{des};
+  FairnessProbe probe;
+  probe.quiet = &quiet;
+  RPL::Linux::Gateway<> gw;
+  probe.gw = &gw;
+  gw.set_budget(1);
+
+  // 忙碌链路的第一帧在工作线程中让安静链路变为就绪
+  p0.set_packet_hook(
+      {&probe, [](void *ctx, uint16_t, std::span<const uint8_t>,
+                  std::span<const uint8_t>) {
+         static_cast<FairnessProbe *>(ctx)->quiet->write_all(
+             sample_b_stream(5, 1));
+       }});
+  p1.set_packet_hook(
+      {&probe, [](void *ctx, uint16_t, std::span<const uint8_t>,
+                  std::span<const uint8_t>) {
+         auto &p = *static_cast<FairnessProbe *>(ctx);
+         p.busy_bytes = p.gw->link_stats(0).bytes;
+       }});
+  auto added = gw.add_link(busy.rd, p0);
+  assert(added.has_value());
+  added = gw.add_link(quiet.rd, p1);
+  assert(added.has_value());
+  busy.write_all(stream);
+  auto started = gw.start(1, false);
+  assert(started.has_value());
+
+  bool done = wait_for([&] { return gw.link_stats(1).frames == 1; });
+  assert(done);
+  done = wait_for([&] { return gw.link_stats(0).bytes == stream.size(); });
+  assert(done);
+  gw.stop();
+
+  // 安静链路排在忙碌链路的下一轮，而不是等它读完
+  assert(probe.busy_bytes > 0);
+  assert(probe.busy_bytes < stream.size());
+  assert(des.get<SampleB>().x == 5);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_shared_sub_packets() {
+  std::cout << "Test 5: Shared links dispatch sub-packets in publish()..."
+            << std::endl;
+
+  using SubDes = RPL::Deserializer<RobotInteractionData, InteractionFigure>;
+  using SubParser = RPL::Parser<RobotInteractionData, InteractionFigure>;
+  Pipe link;
+  SubDes shared;
+  SubParser parser{shared};
+  int hook_calls = 0;
+  std::thread::id hook_thread;
+  struct HookState {
+    int *calls;
+    std::thread::id *thread;
+  } state{&hook_calls, &hook_thread};
+  parser.set_packet_hook(
+      {&state, [](void *ctx, uint16_t, std::span<const uint8_t>,
+                  std::span<const uint8_t>) {
+         auto &st = *static_cast<HookState *>(ctx);
+         ++*st.calls;
+         *st.thread = std::this_thread::get_id();
+       }});
+  RPL::Linux::Gateway<1> gw;
+  auto added = gw.add_link(link.rd, parser, RPL::Linux::LinkMode::Shared);
+  assert(added.has_value());
+  auto started = gw.start(1, false);
+  assert(started.has_value());
+
+  InteractionFigure fig{};
+  fig.layer = 3;
+  fig.start_x = 960;
+  RPL::Serializer<RobotInteractionData> ser;
+  std::vector<uint8_t> frame(64);
+  frame.resize(
+      ser.serialize_sub(frame.data(), frame.size(), {0, 0x0003, 0x0103}, fig)
+          .value());
+  link.write_all(frame);
+  const bool done = wait_for([&] { return gw.link_stats(0).frames == 1; });
+  assert(done);
+  assert(hook_calls == 0);
+
+  // 子包与 PacketHook 都在 publish() 的线程中处理
+  const size_t published = gw.publish();
+  assert(published == 1);
+  assert(hook_calls == 1);
+  assert(hook_thread == std::this_thread::get_id());
+  assert(shared.get<InteractionFigure>().start_x == 960);
+  assert(shared.get<InteractionFigure>().layer == 3);
+  gw.stop();
+
+  std::cout << "  PASS" << std::endl;
+}
+
+// 只计数的转发输出端；在工作线程中调用
+struct CountingSink {
+  std::atomic<size_t> *frames;
+  bool operator()(const RPL::FrameParts &) {
+    frames->fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+};
+
+void test_existing_frame_hook_kept() {
+  std::cout << "Test 6: Relay attached before add_link keeps forwarding..."
+            << std::endl;
+
+  constexpr int frames = 50;
+  Pipe local_pipe, shared_pipe;
+  Des local_des, shared;
+  LinkParser local{local_des}, remote{shared};
+  std::atomic<size_t> local_relayed{0}, shared_relayed{0};
+  RPL::FrameRelay local_relay{CountingSink{&local_relayed}};
+  RPL::FrameRelay shared_relay{CountingSink{&shared_relayed}};
+  const bool local_routed = local_relay.forward_all();
+  const bool shared_routed = shared_relay.forward_all();
+  assert(local_routed && shared_routed);
+  local_relay.attach(local);
+  shared_relay.attach(remote);
+
+  RPL::Linux::Gateway<2> gw;
+  auto local_id = gw.add_link(local_pipe.rd, local);
+  auto shared_id =
+      gw.add_link(shared_pipe.rd, remote, RPL::Linux::LinkMode::Shared);
+  assert(local_id.has_value() && shared_id.has_value());
+  auto started = gw.start(1, false);
+  assert(started.has_value());
+
+  local_pipe.write_all(sample_b_stream(0, frames));
+  shared_pipe.write_all(sample_b_stream(100, frames));
+  const bool done = wait_for([&] {
+    return gw.link_stats(0).frames == frames &&
+           gw.link_stats(1).frames == frames;
+  });
+  assert(done);
+
+  // 两种模式下原有的转发回调都照常收到每一帧
+  assert(local_relayed.load() == frames);
+  assert(shared_relayed.load() == frames);
+  assert(local_des.get<SampleB>().x == frames - 1);
+  const size_t published = gw.publish();
+  assert(published == frames);
+  assert(shared.get<SampleB>().x == 100 + frames - 1);
+  gw.stop();
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Gateway Tests ===" << std::endl;
+  test_local_links();
+  test_shared_publish_keeps_order();
+  test_queue_full_drops();
+  test_busy_link_does_not_starve();
+  test_shared_sub_packets();
+  test_existing_frame_hook_kept();
+  std::cout << "\nAll gateway tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include "RPL/Deserializer.hpp"
+#include "RPL/Linux/ShmStorage.hpp"
+#include "RPL/Packets/Sample/SampleA.hpp"
+#include "RPL/Packets/Sample/SampleB.hpp"
+#include "RPL/Parser.hpp"
+#include "RPL/Serializer.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using RPL::Linux::ShmStorage;
+using ShmDes = RPL::Deserializer<ShmStorage, SampleA, SampleB>;
+using ShmParser = RPL::Parser<ShmStorage, SampleA, SampleB>;
+
+static std::string segment_name(const char *tag) {
+  return "/rpl_test_" + std::to_string(::getpid()) + "_" + tag;
+}
+
+template <typename Parser, typename... Ps>
+static void feed(Parser &parser, const Ps &...packets) {
+  RPL::Serializer<SampleA, SampleB> ser;
+  uint8_t buf[128];
+  const size_t n = ser.serialize(buf, sizeof(buf), packets...).value();
+  auto parsed = parser.push_data(buf, n);
+  assert(parsed.has_value());
+}
+
+void test_writer_and_reader() {
+  std::cout << "Test 1: Parser writes, reader attaches read-only..."
+            << std::endl;
+
+  const auto name = segment_name("basic");
+  ShmDes writer;
+  assert(!writer.storage().attached());
+  auto created = writer.storage().create(name.c_str());
+  assert(created.has_value());
+  assert(writer.storage().attached() && writer.storage().writable());
+  assert(writer.storage().header()->entry_count == 2);
+  ShmParser parser{writer};
+
+  ShmDes reader;
+  auto attached = reader.storage().attach(name.c_str());
+  assert(attached.has_value());
+  assert(!reader.storage().writable());
+  assert(reader.version<SampleA>() == 0);
+
+  feed(parser, SampleA{7, -3, 1.25f, 2.5}, SampleB{42, 0.5});
+  assert(reader.get<SampleA>().a == 7);
+  assert(reader.get<SampleA>().b == -3);
+  assert(reader.get<SampleB>().x == 42);
+  assert(reader.version<SampleA>() == 2);
+  assert(reader.received_size<SampleB>() == sizeof(SampleB));
+
+  // 解除映射后回到进程内私有状态
+  reader.storage().detach();
+  assert(reader.storage().writable());
+  assert(reader.get<SampleA>().a == 0);
+
+  ShmStorage::unlink(name.c_str());
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_validation() {
+  std::cout << "Test 2: Single writer and layout validation..." << std::endl;
+
+  const auto name = segment_name("validate");
+  ShmDes reader;
+  auto missing = reader.storage().attach(name.c_str());
+  assert(!missing && missing.error().code == RPL::ErrorCode::Again);
+
+  ShmDes writer;
+  auto created = writer.storage().create(name.c_str());
+  assert(created.has_value());
+
+  // 第二个写者被 flock 拒绝
+  ShmDes second;
+  auto r = second.storage().create(name.c_str());
+  assert(!r && r.error().code == RPL::ErrorCode::IoError);
+
+  // 数据包集合不同（顺序不同即布局不同）
+  RPL::Deserializer<ShmStorage, SampleB, SampleA> swapped;
+  auto mismatch = swapped.storage().attach(name.c_str());
+  assert(!mismatch &&
+         mismatch.error().code == RPL::ErrorCode::LayoutMismatch);
+  RPL::Deserializer<ShmStorage, SampleA> subset;
+  auto partial = subset.storage().attach(name.c_str());
+  assert(!partial);
+
+  // 写者退出后可由新写者接管
+  writer.storage().detach();
+  created = second.storage().create(name.c_str());
+  assert(created.has_value());
+  auto attached = reader.storage().attach(name.c_str());
+  assert(attached.has_value());
+
+  ShmStorage::unlink(name.c_str());
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_cross_process_seqlock() {
+  std::cout << "Test 3: Cross-process SeqLock over memfd..." << std::endl;
+
+  ShmDes writer;
+  auto created = writer.storage().create_memfd("rpl_test");
+  assert(created.has_value());
+  ShmParser parser{writer};
+  const int fd = writer.storage().fd();
+  assert(fd >= 0);
+
+  constexpr int updates = 20000;
+  const pid_t child = ::fork();
+  assert(child >= 0);
+  if (child == 0) {
+    // 读者进程：每次读到的包内部必须一致（b == -a, c == a）
+    ShmDes reader;
+    if (!reader.storage().attach_fd(fd))
+      ::_exit(2);
+    size_t reads = 0;
+    while (reader.version<SampleA>() < 2 * updates) {
+      const SampleA s = reader.get<SampleA>();
+      if (s.b != -static_cast<int16_t>(s.a) || s.c != static_cast<float>(s.a))
+        ::_exit(1);
+      ++reads;
+    }
+    ::_exit(reads > 0 ? 0 : 3);
+  }
+
+  for (int i = 1; i <= updates; ++i) {
+    const auto a = static_cast<uint8_t>(i);
+    feed(parser, SampleA{a, static_cast<int16_t>(-a), static_cast<float>(a),
+                         0.0});
+  }
+  int status = 0;
+  const pid_t reaped = ::waitpid(child, &status, 0);
+  assert(reaped == child);
+  assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Shared Memory Storage Tests ===" << std::endl;
+  test_writer_and_reader();
+  test_validation();
+  test_cross_process_seqlock();
+  std::cout << "\nAll shared memory storage tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Packets/Sample/SampleB.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <RPL/Utils/CrcBatch.hpp>
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Batch = RPL::CrcBatch<>;
+
+void test_calc_matches_scalar() {
+  std::cout << "Test 1: Batch CRC equals ProtocolCRC16::calc (backend "
+            << static_cast<int>(Batch::backend()) << ")..." << std::endl;
+
+  std::mt19937 rng(42);
+  for (int round = 0; round < 500; ++round) {
+    // 批大小 1..16，长度各不相同（含空消息与超过转置块的长消息）
+    const size_t n = 1 + rng() % Batch::max_batch;
+    std::vector<std::vector<uint8_t>> messages(n);
+    std::array<std::span<const uint8_t>, Batch::max_batch> spans{};
+    for (size_t i = 0; i < n; ++i) {
+      messages[i].resize(rng() % (round % 4 == 0 ? 600 : 48));
+      for (auto &b : messages[i])
+        b = static_cast<uint8_t>(rng());
+      spans[i] = messages[i];
+    }
+
+    std::array<uint16_t, Batch::max_batch> crc{};
+    Batch::calc({spans.data(), n}, crc.data());
+    for (size_t i = 0; i < n; ++i)
+      assert(crc[i] == RPL::ProtocolCRC16::calc(messages[i].data(),
+                                                messages[i].size()));
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_verify_mask() {
+  std::cout << "Test 2: Verify reports one bit per frame..." << std::endl;
+
+  RPL::Serializer<SampleA, SampleB> ser;
+  std::vector<std::vector<uint8_t>> frames;
+  for (int i = 0; i < 16; ++i) {
+    std::vector<uint8_t> f(64);
+    const size_t len =
+        i % 2 ? ser.serialize(f.data(), f.size(), SampleB{i, 0.5}).value()
+              : ser.serialize(f.data(), f.size(),
+                              SampleA{static_cast<uint8_t>(i), 1, 2.0f, 3.0})
+                    .value();
+    f.resize(len);
+    frames.push_back(f);
+  }
+  // 损坏负载、帧尾，以及不足 2 字节的帧
+  frames[3][9] ^= 0x40;
+  frames[8].back() ^= 0x01;
+  frames[13].resize(1);
+
+  std::array<std::span<const uint8_t>, Batch::max_batch> spans{};
+  for (size_t i = 0; i < frames.size(); ++i)
+    spans[i] = frames[i];
+  const uint16_t expected = 0xFFFF & ~((1u << 3) | (1u << 8) | (1u << 13));
+  assert(Batch::verify(spans) == expected);
+
+  // 部分批次：只报告前 n 位
+  assert(Batch::verify({spans.data(), 4}) == (expected & 0x000F));
+  assert(Batch::verify({spans.data(), 1}) == 1);
+  assert(Batch::verify({}) == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_probe_defers_tail() {
+  std::cout << "Test 3: probe<false> defers the CRC16 tail..." << std::endl;
+
+  using ParserType = RPL::Parser<SampleA, SampleB>;
+  std::vector<uint8_t> frame(64);
+  frame.resize(RPL::Serializer<SampleB>{}
+                   .serialize(frame.data(), frame.size(), SampleB{7, 1.0})
+                   .value());
+
+  auto full = ParserType::probe(frame);
+  auto deferred = ParserType::probe<false>(frame);
+  assert(full.status == RPL::FrameProbe::Status::Frame && !full.tail_pending);
+  assert(deferred.status == RPL::FrameProbe::Status::Frame &&
+         deferred.tail_pending);
+  assert(deferred.size == full.size && deferred.cmd == full.cmd);
+
+  // 帧尾损坏：只有完整判定拒绝，批量校验同样拒绝
+  frame.back() ^= 0xFF;
+  assert(ParserType::probe(frame).status == RPL::FrameProbe::Status::Invalid);
+  assert(ParserType::probe<false>(frame).status ==
+         RPL::FrameProbe::Status::Frame);
+  const std::span<const uint8_t> one[] = {frame};
+  assert(Batch::verify(one) == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL CRC Batch Tests ===" << std::endl;
+  test_calc_matches_scalar();
+  test_verify_mask();
+  test_probe_defers_tail();
+  std::cout << "\nAll CRC batch tests passed!" << std::endl;
+  return 0;
+}
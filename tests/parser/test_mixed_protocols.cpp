@@ -1,5 +1,7 @@
 #include <RPL/Packets/RoboMaster/CustomControllerData.hpp>
 #include <RPL/Packets/VT03RemotePacket.hpp>
+#include <RPL/Packets/Sample/USBSamples.hpp>
+#include <RPL/Packets/USBAck.hpp>
 #include <RPL/Serializer.hpp>
 #include <RPL/Parser.hpp>
 #include <RPL/Deserializer.hpp>
@@ -12,6 +14,31 @@
 using namespace RPL;
 using namespace RPL;
 
+// 裁判系统帧：24 字节负载、seq 0x02 时帧头字节 3-4 为 02 10，
+// 按 USB 帧头读取恰为长度 24、命令码 0x1002
+struct RefereeBlob {
+    uint8_t data[24];
+};
+
+struct UsbBlob {
+    uint8_t data[24];
+};
+
+namespace RPL::Meta {
+template <>
+struct PacketTraits<RefereeBlob> : PacketTraitsBase<PacketTraits<RefereeBlob>> {
+    static constexpr uint16_t cmd = 0x0305;
+    static constexpr size_t size = sizeof(RefereeBlob);
+};
+
+template <>
+struct PacketTraits<UsbBlob> : PacketTraitsBase<PacketTraits<UsbBlob>> {
+    static constexpr uint16_t cmd = 0x1002;
+    static constexpr size_t size = sizeof(UsbBlob);
+    using Protocol = USBBaseProto;
+};
+} // namespace RPL::Meta
+
 void test_mixed_protocol_parsing() {
     std::cout << "Test: Mixed Protocol Parsing..." << std::endl;
 
@@ -102,10 +129,102 @@ void test_corrupted_mixed_stream() {
     std::cout << "✓ Corrupted Mixed Stream passed" << std::endl;
 }
 
+void test_shared_start_byte() {
+    std::cout << "Test: Shared Start Byte (Referee 0xA5 + USB 0xA5)..." << std::endl;
+
+    using Ser = Serializer<CustomControllerData, SensorData, USBAck>;
+    using P = Parser<CustomControllerData, SensorData, USBAck>;
+
+    Ser serializer;
+    CustomControllerData rm_packet;
+    std::memset(rm_packet.data.data(), 0x33, sizeof(rm_packet.data));
+    SensorData sensor{1.5f, -2.0f, 9.8f};
+    USBAck ack{7, 1};
+
+    std::vector<uint8_t> stream(256);
+    size_t size = serializer.serialize(stream.data(), stream.size(),
+        sensor, rm_packet, ack, sensor).value();
+    stream.resize(size);
+    // 帧间噪声
+    stream.insert(stream.begin() + 5, {0xA5, 0x01});
+
+    // 一次输入
+    {
+        Deserializer<CustomControllerData, SensorData, USBAck> deserializer;
+        P parser{deserializer};
+        auto result = parser.push_data(stream.data(), stream.size());
+        assert(result.has_value());
+        assert(deserializer.get<CustomControllerData>().data[0] == 0x33);
+        assert(deserializer.get<SensorData>().accel_z == 9.8f);
+    }
+
+    // 逐字节输入
+    {
+        Deserializer<CustomControllerData, SensorData, USBAck> deserializer;
+        P parser{deserializer};
+        size_t acks = 0;
+        parser.set_packet_hook(PacketHook{&acks,
+            [](void *ctx, uint16_t cmd, std::span<const uint8_t>,
+               std::span<const uint8_t>) {
+                if (cmd == Meta::PacketTraits<USBAck>::cmd)
+                    ++*static_cast<size_t *>(ctx);
+            }});
+        for (uint8_t b : stream) {
+            const auto r = parser.push_data(&b, 1);
+            assert(r.has_value());
+        }
+        assert(deserializer.get<CustomControllerData>().data[29] == 0x33);
+        assert(deserializer.get<SensorData>().accel_x == 1.5f);
+        assert(acks == 1);
+    }
+
+    std::cout << "✓ Shared Start Byte passed" << std::endl;
+}
+
+void test_shared_start_byte_partial_frame() {
+    std::cout << "Test: Shared Start Byte, USB length covers a partial referee frame..." << std::endl;
+
+    RefereeBlob blob{};
+    for (uint8_t i = 0; i < sizeof(blob.data); ++i)
+        blob.data[i] = static_cast<uint8_t>(0x40 + i);
+    const auto frame = Serializer<RefereeBlob>::make_frame(blob, 0x02);
+    // 前 29 字节即是一个完整的 USB cmd 0x1002 帧
+    assert(frame[1] == 24 && frame[2] == 0 && frame[3] == 0x02 && frame[4] == 0x10);
+
+    auto run = [&](size_t chunk) {
+        Deserializer<RefereeBlob, UsbBlob> deserializer;
+        Parser<RefereeBlob, UsbBlob> parser{deserializer};
+        std::vector<uint16_t> cmds;
+        parser.set_packet_hook(PacketHook{&cmds,
+            [](void *ctx, uint16_t cmd, std::span<const uint8_t>,
+               std::span<const uint8_t>) {
+                static_cast<std::vector<uint16_t> *>(ctx)->push_back(cmd);
+            }});
+        for (size_t off = 0; off < frame.size(); off += chunk) {
+            const size_t n = std::min(chunk, frame.size() - off);
+            const auto r = parser.push_data(frame.data() + off, n);
+            assert(r.has_value());
+        }
+        assert(cmds.size() == 1);
+        assert(cmds[0] == Meta::PacketTraits<RefereeBlob>::cmd);
+        assert(deserializer.get<RefereeBlob>().data[23] == 0x40 + 23);
+        assert(parser.available_data() == 0);
+    };
+
+    // 结果与分块方式无关
+    run(frame.size());
+    run(1);
+    run(5);
+
+    std::cout << "✓ Shared Start Byte Partial Frame passed" << std::endl;
+}
+
 int main() {
     try {
         test_mixed_protocol_parsing();
         test_corrupted_mixed_stream();
+        test_shared_start_byte();
+        test_shared_start_byte_partial_frame();
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Test failed: " << e.what() << std::endl;
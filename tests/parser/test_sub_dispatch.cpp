@@ -0,0 +1,179 @@
+#include <RPL/Deserializer.hpp>
+#include <RPL/Packets/RoboMaster/EventData.hpp>
+#include <RPL/Packets/RoboMaster/InteractionFigure.hpp>
+#include <RPL/Packets/RoboMaster/InteractionLayerDelete.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+// 自定义机器人间通信子包（data_cmd_id 0x0200）
+#pragma pack(push, 1)
+struct TeamChat {
+  uint8_t code;
+  uint16_t value;
+};
+#pragma pack(pop)
+
+static int g_chat_hook_calls = 0;
+static uint16_t g_chat_value = 0;
+
+template <>
+struct RPL::Meta::PacketTraits<TeamChat>
+    : PacketTraitsBase<PacketTraits<TeamChat>> {
+  using Parent = RobotInteractionData;
+  static constexpr uint16_t cmd = 0x0200;
+  static constexpr size_t size = sizeof(TeamChat);
+
+  static void after_parse(const TeamChat &chat) {
+    ++g_chat_hook_calls;
+    g_chat_value = chat.value;
+  }
+};
+
+
+static InteractionFigure make_figure() {
+  InteractionFigure fig{};
+  fig.figure_name = {'a', 'b', 'c'};
+  fig.operate_type = 1;
+  fig.figure_type = 2;
+  fig.layer = 3;
+  fig.color = 4;
+  fig.width = 5;
+  fig.start_x = 960;
+  fig.start_y = 540;
+  fig.details_c = 100;
+  return fig;
+}
+
+void test_serialize_sub_frame() {
+  std::cout << "Test 1: serialize_sub fills sub header..." << std::endl;
+
+  RPL::Serializer<RobotInteractionData> serializer;
+  const auto fig = make_figure();
+
+  using Ser = RPL::Serializer<RobotInteractionData>;
+  static_assert(Ser::sub_frame_size<InteractionFigure>() == 7 + 6 + 15 + 2);
+  static_assert(RPL::Meta::packet_key<InteractionFigure>() == 0x03010101);
+  static_assert(RPL::Meta::packet_key<EventData>() == 0x0101);
+
+  std::array<uint8_t, 64> buf{};
+  auto len = serializer.serialize_sub(buf.data(), buf.size(),
+                                      {0xFFFF, 0x0003, 0x0103}, fig);
+  assert(len.has_value());
+  assert(*len == Ser::sub_frame_size<InteractionFigure>());
+  // 长度字段、父命令码、子头
+  assert((buf[1] | (buf[2] << 8)) == 21);
+  assert((buf[5] | (buf[6] << 8)) == 0x0301);
+  assert((buf[7] | (buf[8] << 8)) == 0x0101); // data_cmd_id 被覆盖
+  assert((buf[9] | (buf[10] << 8)) == 0x0003);
+  assert((buf[11] | (buf[12] << 8)) == 0x0103);
+  assert(serializer.get_sequence() == 1);
+
+  // 缓冲区不足
+  auto too_small = serializer.serialize_sub(buf.data(), *len - 1,
+                                            {0, 0x0003, 0x0103}, fig);
+  assert(!too_small);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_sub_dispatch_typed_slots() {
+  std::cout << "Test 2: Parser dispatches sub-packets to typed slots..."
+            << std::endl;
+
+  RPL::Deserializer<RobotInteractionData, EventData, InteractionFigure,
+                    InteractionLayerDelete, TeamChat>
+      deserializer;
+  RPL::Parser<RobotInteractionData, EventData, InteractionFigure,
+              InteractionLayerDelete, TeamChat>
+      parser{deserializer};
+  RPL::Serializer<RobotInteractionData, EventData> serializer;
+
+  std::array<uint8_t, 256> buf{};
+  const auto fig = make_figure();
+  auto len = serializer.serialize_sub(buf.data(), buf.size(),
+                                      {0, 0x0003, 0x0103}, fig);
+  assert(len.has_value());
+
+  // 逐字节推送，覆盖分片路径
+  for (size_t i = 0; i < *len; ++i) {
+    auto parsed = parser.push_data(buf.data() + i, 1);
+    assert(parsed.has_value());
+  }
+
+  const auto got = deserializer.get<InteractionFigure>();
+  assert(got.figure_name == fig.figure_name);
+  assert(got.operate_type == 1 && got.figure_type == 2);
+  assert(got.start_x == 960 && got.start_y == 540);
+  assert(deserializer.received_size<InteractionFigure>() == 15);
+
+  // 父包槽位同样更新
+  const auto parent = deserializer.get<RobotInteractionData>();
+  assert(parent.data_cmd_id == 0x0101);
+  assert(parent.receiver_id == 0x0103);
+
+  // 同为 0x0101 的顶层 EventData 不受子包影响
+  assert(deserializer.received_size<EventData>() == 0);
+  EventData event{};
+  event.dart_hit_time = 123;
+  len = serializer.serialize(buf.data(), buf.size(), event);
+  assert(len.has_value());
+  auto parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+  assert(deserializer.get<EventData>().dart_hit_time == 123);
+  assert(deserializer.get<InteractionFigure>().start_x == 960);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_sub_after_parse_and_unknown() {
+  std::cout << "Test 3: Sub-packet after_parse and unknown sub cmd..."
+            << std::endl;
+
+  RPL::Deserializer<RobotInteractionData, EventData, InteractionFigure,
+                    InteractionLayerDelete, TeamChat>
+      deserializer;
+  RPL::Parser<RobotInteractionData, EventData, InteractionFigure,
+              InteractionLayerDelete, TeamChat>
+      parser{deserializer};
+  RPL::Serializer<RobotInteractionData> serializer;
+
+  std::array<uint8_t, 256> buf{};
+  auto len = serializer.serialize_sub(buf.data(), buf.size(), {0, 1, 2},
+                                      TeamChat{7, 0xBEEF});
+  assert(len.has_value());
+  auto parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+  assert(g_chat_hook_calls == 1);
+  assert(g_chat_value == 0xBEEF);
+  assert(deserializer.get<TeamChat>().code == 7);
+
+  // 未注册的子命令：只更新父包
+  RobotInteractionData raw{};
+  raw.data_cmd_id = 0x0233;
+  raw.user_data[0] = 0x42;
+  len = serializer.serialize(buf.data(), buf.size(), raw);
+  assert(len.has_value());
+  parsed = parser.push_data(buf.data(), *len);
+  assert(parsed.has_value());
+  assert(g_chat_hook_calls == 1);
+  assert(deserializer.get<RobotInteractionData>().user_data[0] == 0x42);
+  assert(deserializer.get<TeamChat>().value == 0xBEEF);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL Sub-Packet Dispatch Tests ===" << std::endl;
+
+  test_serialize_sub_frame();
+  test_sub_dispatch_typed_slots();
+  test_sub_after_parse_and_unknown();
+
+  std::cout << "\nAll sub-packet dispatch tests passed!" << std::endl;
+  return 0;
+}
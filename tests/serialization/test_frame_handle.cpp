@@ -0,0 +1,207 @@
+#include <RPL/FrameHandle.hpp>
+#include <RPL/Packets/RoboMaster/InteractionFigure.hpp>
+#include <RPL/Packets/RoboMaster/RobotInteractionData.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Packets/Sample/USBSamples.hpp>
+#include <RPL/Packets/VT03RemotePacket.hpp>
+#include <RPL/Serializer.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+// 与 Serializer 的完整序列化结果逐字节比较
+template <typename T>
+static bool matches_serializer(const RPL::FrameHandle<T> &handle,
+                               const T &packet, uint8_t seq) {
+  const auto expected = RPL::Serializer<T>::make_frame(packet, seq);
+  return std::memcmp(handle.data(), expected.data(), expected.size()) == 0;
+}
+
+void test_crc_combine() {
+  std::cout << "Test 1: CRC combine matches full recompute..." << std::endl;
+
+  using Crc = RPL::ProtocolCRC16;
+  using Combine = RPL::CrcCombine<Crc>;
+  static_assert(Combine::reflected_poly == 0x8408);
+
+  std::array<uint8_t, 40> a{};
+  for (size_t i = 0; i < a.size(); ++i)
+    a[i] = static_cast<uint8_t>(i * 37 + 11);
+
+  for (size_t first = 0; first < a.size(); first += 3) {
+    for (size_t len = 1; first + len <= a.size(); len += 5) {
+      auto b = a;
+      uint16_t delta = 0;
+      for (size_t i = first; i < first + len; ++i) {
+        b[i] = static_cast<uint8_t>(b[i] ^ (i * 13 + 1));
+        delta = Combine::update_raw(delta, static_cast<uint8_t>(a[i] ^ b[i]));
+      }
+      delta = Combine::shift_zeros(delta, a.size() - first - len);
+      const uint16_t patched = Crc::calc(a.data(), a.size()) ^ delta;
+      assert(patched == Crc::calc(b.data(), b.size()));
+    }
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_update_packet() {
+  std::cout << "Test 2: FrameHandle update(const T&)..." << std::endl;
+
+  SampleA pkt{42, -1234, 3.14f, 2.718};
+  RPL::FrameHandle<SampleA> handle{pkt, 7};
+  assert(handle.size() == RPL::Serializer<SampleA>::frame_size<SampleA>());
+  assert(matches_serializer(handle, pkt, 7));
+
+  pkt.b = 555;
+  handle.update(pkt);
+  assert(matches_serializer(handle, pkt, 7));
+
+  pkt.a = 1;
+  pkt.d = -1.0;
+  handle.update(pkt);
+  assert(matches_serializer(handle, pkt, 7));
+
+  // 内容不变时帧保持不变
+  handle.update(pkt);
+  assert(matches_serializer(handle, pkt, 7));
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_update_range_and_seq() {
+  std::cout << "Test 3: FrameHandle byte range update and sequence..."
+            << std::endl;
+
+  SampleA pkt{1, 2, 3.0f, 4.0};
+  RPL::FrameHandle<SampleA> handle{pkt};
+
+  const float c = 9.5f;
+  std::array<uint8_t, sizeof(float)> raw{};
+  std::memcpy(raw.data(), &c, sizeof(c));
+  const bool updated = handle.update(offsetof(SampleA, c), raw);
+  assert(updated);
+  pkt.c = c;
+  assert(matches_serializer(handle, pkt, 0));
+
+  // 越界更新被拒绝
+  const bool accepted = handle.update(sizeof(SampleA) - 1, raw);
+  assert(!accepted);
+  assert(matches_serializer(handle, pkt, 0));
+
+  for (int i = 1; i <= 300; ++i) {
+    handle.advance_seq();
+    const auto seq = static_cast<uint8_t>(i);
+    assert(handle.seq() == seq);
+    assert(matches_serializer(handle, pkt, seq));
+  }
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_bitfield_set() {
+  std::cout << "Test 4: FrameHandle set<I> on BitLayout packet..."
+            << std::endl;
+
+  VT03RemotePacket pkt{};
+  pkt.right_stick_x = 1024;
+  pkt.wheel = 100;
+  RPL::FrameHandle<VT03RemotePacket> handle{pkt};
+  assert(matches_serializer(handle, pkt, 0));
+
+  handle.set<9>(1); // trigger
+  pkt.trigger = 1;
+  assert(matches_serializer(handle, pkt, 0));
+
+  handle.set<11>(-120); // mouse_x
+  pkt.mouse_x = -120;
+  assert(matches_serializer(handle, pkt, 0));
+  assert(handle.get<11>() == -120);
+  assert(handle.get<0>() == 1024);
+
+  pkt.key_w = 1;
+  handle.update(pkt);
+  assert(matches_serializer(handle, pkt, 0));
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_no_tail_protocol() {
+  std::cout << "Test 5: FrameHandle on protocol without CRC..." << std::endl;
+
+  MotorSpeedCmd cmd{};
+  RPL::FrameHandle<MotorSpeedCmd> handle{cmd};
+  assert(matches_serializer(handle, cmd, 0));
+
+  std::memset(&cmd, 0x3C, sizeof(cmd));
+  handle.update(cmd);
+  assert(matches_serializer(handle, cmd, 0));
+
+  std::cout << "  PASS" << std::endl;
+}
+
+// 子包没有独立帧：句柄持有 Parent 包，结果应与 serialize_sub 一致
+template <typename Sub>
+static bool matches_serialize_sub(
+    const RPL::FrameHandle<RobotInteractionData> &handle,
+    const RobotInteractionHeader &header, const Sub &sub) {
+  RPL::Serializer<RobotInteractionData> serializer;
+  std::array<uint8_t, 64> expected{};
+  // 序列化器从 0 开始计数，推进到句柄的序列号
+  for (uint8_t i = 0; i < handle.seq(); ++i)
+    (void)serializer.serialize_sub(expected.data(), expected.size(), header,
+                                   sub);
+  const auto len =
+      serializer.serialize_sub(expected.data(), expected.size(), header, sub);
+  return len && *len == handle.size() &&
+         std::memcmp(handle.data(), expected.data(), *len) == 0;
+}
+
+void test_sub_packet_via_parent() {
+  std::cout << "Test 6: FrameHandle of Parent carries a sub-packet..."
+            << std::endl;
+
+  InteractionFigure fig{};
+  fig.figure_name = {'h', 'u', 'd'};
+  fig.operate_type = 1;
+  fig.layer = 2;
+  fig.start_x = 960;
+  fig.start_y = 540;
+  const RobotInteractionHeader header{0, 0x0003, 0x0103};
+
+  RobotInteractionData pkt{};
+  pkt.data_cmd_id = RPL::Meta::PacketTraits<InteractionFigure>::cmd;
+  pkt.sender_id = header.sender_id;
+  pkt.receiver_id = header.receiver_id;
+  std::memcpy(pkt.user_data.data(), &fig, sizeof(fig));
+
+  RPL::FrameHandle<RobotInteractionData> handle{pkt, 5};
+  assert(handle.size() ==
+         RPL::Serializer<RobotInteractionData>::sub_frame_size<
+             InteractionFigure>());
+  assert(matches_serialize_sub(handle, header, fig));
+
+  // 周期性刷新图形坐标只修补变化的字节
+  fig.start_x = 100;
+  std::memcpy(pkt.user_data.data(), &fig, sizeof(fig));
+  handle.update(pkt);
+  handle.advance_seq();
+  assert(matches_serialize_sub(handle, header, fig));
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL FrameHandle Tests ===" << std::endl;
+
+  test_crc_combine();
+  test_update_packet();
+  test_update_range_and_seq();
+  test_bitfield_set();
+  test_no_tail_protocol();
+  test_sub_packet_via_parent();
+
+  std::cout << "\nAll FrameHandle tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,215 @@
+#include <RPL/RefereeUI.hpp>
+#include <RPL/Serializer.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+struct FakeTick {
+  using tick_type = uint32_t;
+  static inline uint32_t value = 0;
+  static tick_type now() { return value; }
+};
+
+using UI = RPL::RefereeUI<FakeTick, 16, 4>;
+using Ser = RPL::Serializer<RobotInteractionData>;
+
+static constexpr uint32_t kInterval = 34;
+
+static InteractionFigure make_figure(char id, uint32_t layer, uint32_t x) {
+  InteractionFigure fig{};
+  fig.figure_name = {'f', 'g', static_cast<uint8_t>(id)};
+  fig.figure_type = 1;
+  fig.layer = layer;
+  fig.color = 2;
+  fig.width = 3;
+  fig.start_x = x;
+  fig.start_y = 100;
+  return fig;
+}
+
+struct Frame {
+  std::array<uint8_t, 256> buf{};
+  size_t len = 0;
+
+  uint16_t data_cmd_id() const { return buf[7] | (buf[8] << 8); }
+  const uint8_t *sub() const { return buf.data() + 13; }
+  // 第 i 个图形的 operate_type / start_x / 名称
+  uint32_t op(size_t i) const {
+    return RPL::BitView<InteractionFigure>{
+        std::span<const uint8_t>(sub() + 15 * i, 15)}
+        .get<1>();
+  }
+  uint32_t start_x(size_t i) const {
+    return RPL::BitView<InteractionFigure>{
+        std::span<const uint8_t>(sub() + 15 * i, 15)}
+        .get<8>();
+  }
+  char name(size_t i) const { return static_cast<char>(sub()[15 * i + 2]); }
+};
+
+// 推进时间到下一个发送窗口并取出一帧
+static Frame next_frame(UI &ui, Ser &ser) {
+  FakeTick::value += kInterval;
+  Frame f;
+  auto r = ui.poll(ser, f.buf.data(), f.buf.size());
+  assert(r.has_value());
+  f.len = *r;
+  if (f.len > 0) {
+    const uint16_t crc = RPL::ProtocolCRC16::calc(f.buf.data(), f.len - 2);
+    assert(f.buf[f.len - 2] == (crc & 0xFF));
+    assert(f.buf[f.len - 1] == (crc >> 8));
+  }
+  return f;
+}
+
+void test_batch_selection() {
+  std::cout << "Test 1: Changed figures packed into smallest fitting batch..."
+            << std::endl;
+
+  UI ui{0x0003, 0x0103, kInterval};
+  Ser ser;
+
+  for (char c = 'a'; c < 'd'; ++c) {
+    const bool stored = ui.set_figure(make_figure(c, 1, 500));
+    assert(stored);
+  }
+  assert(ui.pending() == 3);
+
+  auto f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0103); // 3 个图形 -> 5 图形帧
+  assert(f.len == 7 + 6 + 75 + 2);
+  assert((f.buf[9] | (f.buf[10] << 8)) == 0x0003);
+  assert((f.buf[11] | (f.buf[12] << 8)) == 0x0103);
+  for (size_t i = 0; i < 3; ++i)
+    assert(f.op(i) == 1); // 增加
+  assert(f.op(3) == 0 && f.op(4) == 0); // 空操作填充
+
+  // 未变化的图形不再发送
+  assert(ui.pending() == 0);
+  ui.set_figure(make_figure('b', 1, 500));
+  f = next_frame(ui, ser);
+  assert(f.len == 0);
+
+  // 修改单个图形 -> 单图形帧、修改操作
+  ui.set_figure(make_figure('b', 1, 640));
+  f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0101);
+  assert(f.len == 7 + 6 + 15 + 2);
+  assert(f.op(0) == 2);
+  assert(f.name(0) == 'b');
+  assert(f.start_x(0) == 640);
+
+  // 9 个待发图形 -> 7 图形帧 + 2 图形帧
+  for (char c = 'a'; c < 'j'; ++c)
+    ui.set_figure(make_figure(c, 1, 700));
+  assert(ui.pending() == 9);
+  f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0104);
+  f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0102);
+  assert(f.op(0) == 1 && f.op(1) == 1); // h、i 首次增加
+  assert(ui.pending() == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_rate_limit() {
+  std::cout << "Test 2: Frames respect minimum interval..." << std::endl;
+
+  UI ui{1, 0x0101, kInterval};
+  Ser ser;
+  FakeTick::value = 1000;
+
+  ui.set_figure(make_figure('a', 0, 1));
+  std::array<uint8_t, 128> buf{};
+  auto r = ui.poll(ser, buf.data(), buf.size());
+  assert(r.has_value() && *r > 0);
+
+  ui.set_figure(make_figure('a', 0, 2));
+  FakeTick::value += kInterval - 1;
+  r = ui.poll(ser, buf.data(), buf.size());
+  assert(r.has_value() && *r == 0);
+  assert(ui.next_deadline() == 1000 + kInterval);
+
+  FakeTick::value += 1;
+  r = ui.poll(ser, buf.data(), buf.size());
+  assert(r.has_value() && *r > 0);
+
+  // 缓冲区不足时状态不变
+  ui.set_figure(make_figure('a', 0, 3));
+  FakeTick::value += kInterval;
+  r = ui.poll(ser, buf.data(), 10);
+  assert(!r.has_value());
+  assert(ui.pending() == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_strings_and_deletes() {
+  std::cout << "Test 3: Strings, removal, layer delete and invalidate..."
+            << std::endl;
+
+  UI ui{1, 0x0101, kInterval};
+  Ser ser;
+
+  InteractionString text{};
+  text.graphic_data = {'t', 'x', '0'};
+  std::memcpy(text.data.data(), "HELLO", 5);
+  const bool stored = ui.set_string(text);
+  assert(stored);
+  ui.set_figure(make_figure('a', 2, 10));
+  ui.set_figure(make_figure('b', 3, 10));
+
+  // 图形与字符交替发送
+  auto f1 = next_frame(ui, ser);
+  auto f2 = next_frame(ui, ser);
+  assert(f1.data_cmd_id() == 0x0102);
+  assert(f2.data_cmd_id() == 0x0110);
+  assert(f2.len == 7 + 6 + 45 + 2);
+  assert(f2.op(0) == 1);
+  assert(std::memcmp(f2.sub() + 15, "HELLO", 5) == 0);
+
+  // 移除已上屏图形 -> 删除操作
+  bool removed = ui.remove_figure({'f', 'g', 'a'});
+  assert(removed);
+  auto f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0101);
+  assert(f.op(0) == 3);
+  removed = ui.remove_figure({'f', 'g', 'a'});
+  assert(!removed);
+
+  // 删除图层优先发送，且图层中的图形不再重发
+  ui.set_figure(make_figure('b', 3, 99));
+  ui.delete_layer(3);
+  f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0100);
+  assert(f.sub()[0] == 1 && f.sub()[1] == 3);
+  assert(ui.pending() == 0);
+
+  // 客户端重连：全部以增加重发
+  ui.invalidate_all();
+  assert(ui.pending() == 1);
+  f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0110);
+  assert(f.op(0) == 1);
+
+  ui.clear();
+  f = next_frame(ui, ser);
+  assert(f.data_cmd_id() == 0x0100);
+  assert(f.sub()[0] == 2);
+  assert(ui.pending() == 0);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL RefereeUI Tests ===" << std::endl;
+
+  test_batch_selection();
+  test_rate_limit();
+  test_strings_and_deletes();
+
+  std::cout << "\nAll RefereeUI tests passed!" << std::endl;
+  return 0;
+}
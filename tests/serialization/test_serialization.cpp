@@ -2,6 +2,7 @@
 #include <RPL/Packets/Sample/SampleB.hpp>
 #include <RPL/Serializer.hpp>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -152,6 +153,64 @@ void test_sequence_number_handling() {
   std::cout << "✓ Sequence number handling passed" << std::endl;
 }
 
+// Test 6: Header template matches a from-scratch CRC computation
+void test_header_template_crc() {
+  std::cout << "Test 6: Header template CRC for every sequence..." << std::endl;
+
+  RPL::Serializer<SampleA> serializer;
+  SampleA packet{7, 321, 1.5f, -0.25};
+
+  constexpr size_t frame_size = RPL::Serializer<SampleA>::frame_size<SampleA>();
+  std::vector<uint8_t> buffer(frame_size);
+
+  for (int i = 0; i < 256; ++i) {
+    auto result = serializer.serialize(buffer.data(), buffer.size(), packet);
+    assert(result.has_value());
+    assert(buffer[3] == static_cast<uint8_t>(i));
+    assert(buffer[4] == RPL::ProtocolCRC8::calc(buffer.data(), 4));
+
+    const uint16_t crc16 =
+        RPL::ProtocolCRC16::calc(buffer.data(), frame_size - 2);
+    uint16_t wire_crc16;
+    std::memcpy(&wire_crc16, buffer.data() + frame_size - 2, 2);
+    assert(wire_crc16 == crc16);
+  }
+
+  std::cout << "✓ Header template CRC passed" << std::endl;
+}
+
+// Test 7: Compile-time prebuilt frames
+struct FixedCommand {
+  uint8_t mode;
+  uint8_t target;
+};
+
+template <>
+struct RPL::Meta::PacketTraits<FixedCommand>
+    : PacketTraitsBase<PacketTraits<FixedCommand>> {
+  static constexpr uint16_t cmd = 0x0210;
+  static constexpr size_t size = sizeof(FixedCommand);
+};
+
+void test_prebuilt_frame() {
+  std::cout << "Test 7: Compile-time prebuilt frame..." << std::endl;
+
+  using Ser = RPL::Serializer<FixedCommand, SampleA>;
+  static constexpr auto kStopFrame = Ser::make_frame(FixedCommand{3, 1});
+  static_assert(kStopFrame.size() == Ser::frame_size<FixedCommand>());
+  static_assert(kStopFrame[0] == 0xA5);
+  static_assert(kStopFrame[7] == 3 && kStopFrame[8] == 1);
+
+  Ser serializer;
+  std::vector<uint8_t> buffer(Ser::frame_size<FixedCommand>());
+  auto result =
+      serializer.serialize(buffer.data(), buffer.size(), FixedCommand{3, 1});
+  assert(result.has_value());
+  assert(arrays_equal(buffer.data(), kStopFrame.data(), kStopFrame.size()));
+
+  std::cout << "✓ Prebuilt frame passed" << std::endl;
+}
+
 int main() {
   std::cout << "=== RPL Serialization Tests ===" << std::endl;
 
@@ -161,6 +220,8 @@ int main() {
     test_frame_size_calculations();
     test_buffer_size_error_handling();
     test_sequence_number_handling();
+    test_header_template_crc();
+    test_prebuilt_frame();
 
     std::cout << "✓ All serialization tests passed!" << std::endl;
     return 0;
@@ -0,0 +1,244 @@
+#include <RPL/Packets/RoboMaster/CustomInfo.hpp>
+#include <RPL/Packets/RoboMaster/InteractionFigure.hpp>
+#include <RPL/Packets/RoboMaster/InteractionLayerDelete.hpp>
+#include <RPL/Serializer.hpp>
+#include <RPL/TxScheduler.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+struct FakeTick {
+  using tick_type = uint32_t;
+  static inline uint32_t value = 0;
+  static tick_type now() { return value; }
+};
+
+#pragma pack(push, 1)
+struct Telemetry {
+  uint16_t seq;
+  std::array<uint8_t, 30> data;
+};
+
+struct Setpoint {
+  int16_t value;
+};
+
+struct Event {
+  uint8_t id;
+};
+#pragma pack(pop)
+
+// 10Hz 限速，溢出丢弃最旧
+template <>
+struct RPL::Meta::PacketTraits<Telemetry>
+    : PacketTraitsBase<PacketTraits<Telemetry>> {
+  static constexpr uint16_t cmd = 0x0A01;
+  static constexpr size_t size = sizeof(Telemetry);
+  static constexpr uint32_t max_rate_hz = 10;
+  static constexpr uint8_t bandwidth_class = 1;
+  static constexpr TxPolicy tx_policy = TxPolicy::DropOldest;
+};
+
+// 只保留最新设定值
+template <>
+struct RPL::Meta::PacketTraits<Setpoint>
+    : PacketTraitsBase<PacketTraits<Setpoint>> {
+  static constexpr uint16_t cmd = 0x0A02;
+  static constexpr size_t size = sizeof(Setpoint);
+  static constexpr uint32_t max_rate_hz = 50;
+  static constexpr TxPolicy tx_policy = TxPolicy::Coalesce;
+};
+
+// 不限速，默认排队策略
+template <>
+struct RPL::Meta::PacketTraits<Event> : PacketTraitsBase<PacketTraits<Event>> {
+  static constexpr uint16_t cmd = 0x0A03;
+  static constexpr size_t size = sizeof(Event);
+  static constexpr uint8_t bandwidth_class = 1;
+};
+
+static uint16_t frame_cmd(const uint8_t *frame) {
+  return static_cast<uint16_t>(frame[5] | (frame[6] << 8));
+}
+
+void test_rate_limit() {
+  std::cout << "Test 1: Per-cmd rate limit and next deadline..." << std::endl;
+
+  FakeTick::value = 1000;
+  RPL::TxScheduler<FakeTick, Telemetry> tx;
+  RPL::Serializer<Telemetry> ser;
+  std::array<uint8_t, 256> buf{};
+
+  assert(!tx.next_deadline());
+  for (uint16_t i = 0; i < 3; ++i) {
+    auto queued = tx.submit(Telemetry{i, {}});
+    assert(queued);
+  }
+
+  // 突发量为 1：只发出一帧
+  auto r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == ser.frame_size<Telemetry>());
+  assert(tx.pending() == 2);
+  assert(tx.next_deadline() == 1100u);
+
+  FakeTick::value = 1099;
+  r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == 0);
+  assert(tx.next_deadline() == 1100u);
+
+  FakeTick::value = 1100;
+  r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == ser.frame_size<Telemetry>());
+  assert(buf[7] == 1); // FIFO 顺序
+
+  // 缓冲区放不下
+  FakeTick::value = 1200;
+  r = tx.poll(ser, buf.data(), 8);
+  assert(!r && r.error().code == RPL::ErrorCode::BufferOverflow);
+  assert(tx.pending() == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_policies() {
+  std::cout << "Test 2: Queue / Coalesce / DropOldest policies..." << std::endl;
+
+  FakeTick::value = 0;
+  using Config = RPL::TxSchedulerConfig<1000, 2>;
+  RPL::BasicTxScheduler<FakeTick, Config, Telemetry, Setpoint, Event> tx;
+  RPL::Serializer<Telemetry, Setpoint, Event> ser;
+  std::array<uint8_t, 256> buf{};
+
+  for (uint16_t i = 0; i < 3; ++i) {
+    auto queued = tx.submit(Telemetry{i, {}});
+    assert(queued);
+  }
+  assert(tx.pending<Telemetry>() == 2);
+  assert(tx.dropped() == 1);
+
+  for (int16_t v = 1; v <= 4; ++v) {
+    auto queued = tx.submit(Setpoint{v});
+    assert(queued);
+  }
+  assert(tx.pending<Setpoint>() == 1);
+  assert(tx.coalesced() == 3);
+
+  auto queued = tx.submit(Event{1});
+  assert(queued);
+  queued = tx.submit(Event{2});
+  assert(queued);
+  auto full = tx.submit(Event{3});
+  assert(!full && full.error().code == RPL::ErrorCode::BufferOverflow);
+
+  // Telemetry 与 Setpoint 各受限一帧，Event 不限速全部发出
+  auto r = tx.poll(ser, buf.data(), buf.size());
+  assert(r);
+  size_t offset = 0;
+  std::array<uint16_t, 8> cmds{};
+  size_t frames = 0;
+  int16_t setpoint = 0;
+  uint16_t telemetry_seq = 0xFFFF;
+  while (offset < *r) {
+    const uint16_t cmd = frame_cmd(buf.data() + offset);
+    const size_t len = ser.frame_size_by_cmd(cmd);
+    if (cmd == 0x0A02)
+      std::memcpy(&setpoint, buf.data() + offset + 7, 2);
+    if (cmd == 0x0A01)
+      std::memcpy(&telemetry_seq, buf.data() + offset + 7, 2);
+    cmds[frames++] = cmd;
+    offset += len;
+  }
+  assert(offset == *r);
+  assert(frames == 4);
+  assert(setpoint == 4);       // 合并后的最新值
+  assert(telemetry_seq == 1);  // 最旧的 0 被丢弃
+  assert(tx.pending() == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_class_limit() {
+  std::cout << "Test 3: Aggregate class byte budget..." << std::endl;
+
+  FakeTick::value = 0;
+  RPL::TxScheduler<FakeTick, Event, Telemetry> tx;
+  RPL::Serializer<Event, Telemetry> ser;
+  std::array<uint8_t, 256> buf{};
+
+  // 类别 1：每秒 100 字节，突发 20 字节；Event 帧 10 字节
+  tx.set_class_limit(1, 100, 20);
+  for (uint8_t i = 0; i < 4; ++i) {
+    auto queued = tx.submit(Event{i});
+    assert(queued);
+  }
+
+  auto r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == 20);
+  assert(tx.next_deadline() == 100u);
+
+  FakeTick::value = 100;
+  r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == 10);
+
+  // 超过突发量的大帧在桶满时仍可发送，并耗尽整个桶
+  FakeTick::value = 1000;
+  auto queued = tx.submit(Telemetry{7, {}});
+  assert(queued);
+  r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == ser.frame_size<Telemetry>());
+  assert(frame_cmd(buf.data()) == 0x0A01);
+  assert(tx.pending<Event>() == 1);
+  assert(tx.next_deadline() == 1100u);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_sub_packets_share_cmd_bucket() {
+  std::cout << "Test 4: Sub-packets share the parent cmd bucket..."
+            << std::endl;
+
+  FakeTick::value = 0;
+  RPL::TxScheduler<FakeTick, InteractionFigure, InteractionLayerDelete,
+                   CustomInfo>
+      tx;
+  RPL::Serializer<RobotInteractionData, CustomInfo> ser;
+  std::array<uint8_t, 256> buf{};
+
+  const RobotInteractionHeader header{0, 0x0003, 0x0103};
+  auto queued = tx.submit(header, InteractionFigure{});
+  assert(queued);
+  queued = tx.submit(header, InteractionLayerDelete{});
+  assert(queued);
+  queued = tx.submit(CustomInfo{});
+  assert(queued);
+
+  // 0x0301 限速 30Hz：两个子包同一时刻只能发出一个
+  auto r = tx.poll(ser, buf.data(), buf.size());
+  assert(r);
+  assert(*r == ser.sub_frame_size<InteractionFigure>() +
+                   ser.frame_size<CustomInfo>());
+  assert(frame_cmd(buf.data()) == 0x0301);
+  assert(buf[7] == 0x01 && buf[8] == 0x01); // data_cmd_id
+  assert(tx.pending() == 1);
+  assert(tx.next_deadline() == 34u); // ceil(1000 / 30)
+
+  FakeTick::value = 34;
+  r = tx.poll(ser, buf.data(), buf.size());
+  assert(r && *r == ser.sub_frame_size<InteractionLayerDelete>());
+  assert(buf[7] == 0x00 && buf[8] == 0x01);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+int main() {
+  std::cout << "=== RPL TxScheduler Tests ===" << std::endl;
+
+  test_rate_limit();
+  test_policies();
+  test_class_limit();
+  test_sub_packets_share_cmd_bucket();
+
+  std::cout << "\nAll TxScheduler tests passed!" << std::endl;
+  return 0;
+}
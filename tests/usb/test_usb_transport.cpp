@@ -1,8 +1,13 @@
+#include "RPL/Containers/PriorityTxQueue.hpp"
+#include "RPL/Containers/TxCoalescer.hpp"
 #include "RPL/Packets/Sample/USBSamples.hpp"
 #include "RPL/Packets/USBAck.hpp"
 #include "RPL/USBTransport.hpp"
+#include "RPL/Utils/ReliableAckManager.hpp"
+#include <array>
 #include <iostream>
 #include <cassert>
+#include <coroutine>
 #include <cstring>
 
 struct SysTickProvider {
@@ -224,6 +229,719 @@ void test_no_crc_on_wire() {
   std::cout << "  PASS" << std::endl;
 }
 
+// 发送通道：busy 时拒绝帧，否则记录帧的命令码
+static bool g_pipe_busy = false;
+static uint16_t g_sent_cmds[16];
+static size_t g_sent_count = 0;
+static bool busy_send(const uint8_t *buf, size_t) {
+  if (g_pipe_busy)
+    return false;
+  std::memcpy(&g_sent_cmds[g_sent_count++], buf + 3, 2);
+  return true;
+}
+
+void test_priority_tx_queue() {
+  std::cout << "Test 7: Priority TX queue drains urgent frames first..."
+            << std::endl;
+
+  using Queue = RPL::Containers::PriorityTxQueue<SysTickProvider, 4, 8, 32>;
+  using Transport = RPL::USBTransport<AckMgr, decltype(&busy_send), Queue,
+                                      USBAck, SensorData, MotorSpeedCmd>;
+  static_assert(Transport::has_tx_queue);
+  static_assert(!PacketList::has_tx_queue);
+
+  SysTickProvider::reset();
+  g_sent_count = 0;
+  Transport transport{busy_send};
+
+  // 通道空闲：立即发送
+  auto sent = transport.notify(SensorData{1.0f, 0.0f, 0.0f});
+  assert(sent);
+  assert(g_sent_count == 1);
+  assert(transport.tx_queue().empty());
+
+  // 通道繁忙：遥测堆积后再来一条控制指令
+  g_pipe_busy = true;
+  for (int i = 0; i < 3; ++i) {
+    sent = transport.notify(SensorData{float(i), 0.0f, 0.0f});
+    assert(sent);
+  }
+  MotorSpeedCmd motor{0, 1, 500};
+  sent = transport.notify(motor);
+  assert(sent);
+  assert(transport.tx_queue().size() == 4);
+  assert(transport.tx_queue().front_priority() == 0);
+  size_t drained = transport.drain_tx();
+  assert(drained == 0);
+
+  g_pipe_busy = false;
+  drained = transport.drain_tx();
+  assert(drained == 4);
+  assert(g_sent_cmds[1] == RPL::Meta::PacketTraits<MotorSpeedCmd>::cmd);
+  for (size_t i = 2; i < 5; ++i)
+    assert(g_sent_cmds[i] == RPL::Meta::PacketTraits<SensorData>::cmd);
+
+  // 每级的排队时延统计：控制指令等待不超过排在它之前的遥测
+  const auto &urgent = transport.tx_queue().stats(0);
+  const auto &bulk = transport.tx_queue().stats(3);
+  assert(urgent.frames == 1);
+  assert(bulk.frames == 4);
+  assert(urgent.max_wait < bulk.max_wait);
+
+  // 队列满
+  g_pipe_busy = true;
+  for (int i = 0; i < 8; ++i) {
+    sent = transport.notify(SensorData{});
+    assert(sent);
+  }
+  auto full = transport.notify(SensorData{});
+  assert(!full && full.error().code == RPL::ErrorCode::BufferOverflow);
+  g_pipe_busy = false;
+
+  std::cout << "  PASS" << std::endl;
+}
+
+struct ManualTick {
+  using tick_type = uint32_t;
+  static tick_type now() { return now_; }
+  static inline uint32_t now_ = 0;
+};
+
+// 记录每次传输的长度
+static size_t g_transfer_sizes[16];
+static size_t g_transfer_count = 0;
+static bool record_transfer(const uint8_t *, size_t len) {
+  if (g_pipe_busy)
+    return false;
+  g_transfer_sizes[g_transfer_count++] = len;
+  return true;
+}
+
+void test_tx_coalescer() {
+  std::cout << "Test 8: Coalescing frames into endpoint-sized transfers..."
+            << std::endl;
+
+  using Coalescer = RPL::Containers::TxCoalescer<ManualTick, 64>;
+  using Transport =
+      RPL::USBTransport<AckMgr, decltype(&record_transfer), Coalescer, USBAck,
+                        SensorData, MotorSpeedCmd>;
+  static_assert(Transport::has_tx_coalescer && !Transport::has_tx_queue);
+  constexpr size_t sensor_frame =
+      RPL::Serializer<SensorData>::frame_size<SensorData>();
+  constexpr size_t motor_frame =
+      RPL::Serializer<MotorSpeedCmd>::frame_size<MotorSpeedCmd>();
+
+  SysTickProvider::reset();
+  ManualTick::now_ = 0;
+  g_transfer_count = 0;
+  g_pipe_busy = false;
+  Transport transport{record_transfer};
+  transport.tx_coalescer().set_flush_deadline(500);
+
+  // 缓冲区放不下第 4 帧时发出前 3 帧
+  for (int i = 0; i < 4; ++i) {
+    auto sent = transport.notify(SensorData{float(i), 0.0f, 0.0f});
+    assert(sent);
+  }
+  assert(g_transfer_count == 1);
+  assert(g_transfer_sizes[0] == 3 * sensor_frame);
+  assert(transport.tx_coalescer().buffered() == sensor_frame);
+
+  // 期限未到不发送，期限到达后由 poll 发出
+  ManualTick::now_ = 499;
+  transport.poll();
+  assert(g_transfer_count == 1);
+  ManualTick::now_ = 500;
+  transport.poll();
+  assert(g_transfer_count == 2);
+  assert(g_transfer_sizes[1] == sensor_frame);
+
+  // Request 包立即冲刷（与之前缓存的帧同一次传输）
+  auto sent = transport.notify(SensorData{});
+  assert(sent);
+  MotorSpeedCmd motor{0, 1, 100};
+  (void)transport.request(motor, 1);
+  assert(g_transfer_count == 3);
+  assert(g_transfer_sizes[2] == sensor_frame + motor_frame);
+
+  // 通道繁忙：数据留在缓存中
+  g_pipe_busy = true;
+  for (int i = 0; i < 3; ++i) {
+    sent = transport.notify(SensorData{});
+    assert(sent);
+  }
+  auto busy = transport.notify(SensorData{});
+  assert(!busy && busy.error().code == RPL::ErrorCode::Again);
+  g_pipe_busy = false;
+  const bool flushed = transport.flush_tx();
+  assert(flushed);
+
+  const auto &c = transport.tx_coalescer();
+  assert(c.frames() == 9);
+  assert(c.transfers() == 4);
+  assert(c.saved() == 5);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+// 记录发出的请求 ID，不自动回复 Ack
+static uint8_t g_req_ids[16];
+static size_t g_req_count = 0;
+static void capture_send(const uint8_t *buf, size_t len) {
+  if (len >= 6)
+    g_req_ids[g_req_count++] = buf[5];
+}
+
+template <typename Transport>
+static void inject_ack(Transport &transport, uint8_t req_id, uint8_t status) {
+  RPL::Serializer<USBAck> ser;
+  uint8_t buf[RPL::Serializer<USBAck>::frame_size<USBAck>()];
+  auto r = ser.serialize(buf, sizeof(buf), USBAck{req_id, status});
+  assert(r.has_value());
+  (void)transport.receive(buf, *r);
+}
+
+// 最小协程类型：立即开始执行，结束时不挂起
+struct FireAndForget {
+  struct promise_type {
+    FireAndForget get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+template <typename Future>
+static FireAndForget await_ack(Future future, RPL::AckResult *out) {
+  *out = co_await future;
+}
+
+static uint8_t g_cb_status = 0;
+static bool g_cb_called = false;
+static void on_ack(void *ctx, uint8_t, RPL::AckResult result) {
+  *static_cast<bool *>(ctx) = true;
+  g_cb_called = true;
+  g_cb_status = result.value_or(0xEE);
+}
+
+void test_request_async() {
+  std::cout << "Test 9: Pipelined async requests..." << std::endl;
+
+  using Transport =
+      RPL::USBTransport<AckMgr, decltype(&capture_send), USBAck, SensorData,
+                        MotorSpeedCmd, LEDCmd>;
+  SysTickProvider::reset();
+  g_req_count = 0;
+  Transport transport{capture_send};
+
+  // 三个请求同时在途
+  MotorSpeedCmd m1{0, 1, 100};
+  MotorSpeedCmd m2{0, 2, 200};
+  LEDCmd led{0, 3, 50};
+  auto f1 = transport.request_async(m1);
+  auto f2 = transport.request_async(m2);
+  auto f3 = transport.request_async(led, 1000000);
+  assert(f1 && f2 && f3);
+  assert(g_req_count == 3);
+  assert(transport.ack_manager().pending_count() == 3);
+
+  // 协程等待 f2，回调等待 f3，轮询 f1
+  RPL::AckResult co_result = tl::unexpected(RPL::Error{RPL::ErrorCode::Again, ""});
+  await_ack(*f2, &co_result);
+  assert(!co_result && co_result.error().code == RPL::ErrorCode::Again);
+  bool cb_flag = false;
+  const bool registered = f3->then(on_ack, &cb_flag);
+  assert(registered);
+
+  // 乱序 Ack：resolve 直接唤醒等待者
+  inject_ack(transport, f2->req_id(), 7);
+  assert(co_result && *co_result == 7);
+  inject_ack(transport, f3->req_id(), 9);
+  assert(cb_flag && g_cb_status == 9);
+  assert(!f1->ready());
+  auto r1 = f1->get();
+  assert(!r1 && r1.error().code == RPL::ErrorCode::Again);
+  inject_ack(transport, f1->req_id(), 1);
+  assert(f1->ready());
+  r1 = f1->get();
+  assert(r1 && *r1 == 1);
+  assert(transport.ack_manager().pending_count() == 0);
+
+  // 已完成的请求：协程不挂起
+  auto f4 = transport.request_async(m1);
+  inject_ack(transport, f4->req_id(), 4);
+  RPL::AckResult done = tl::unexpected(RPL::Error{RPL::ErrorCode::Again, ""});
+  await_ack(*f4, &done);
+  assert(done && *done == 4);
+
+  // 超时由 poll 完成
+  transport.set_default_timeout(5);
+  auto f5 = transport.request_async(m1);
+  RPL::AckResult timed = tl::unexpected(RPL::Error{RPL::ErrorCode::Again, ""});
+  await_ack(*f5, &timed);
+  for (int i = 0; i < 10 && !f5->ready(); ++i)
+    transport.poll();
+  assert(!timed && timed.error().code == RPL::ErrorCode::Timeout);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+static uint8_t g_expired[8];
+static size_t g_expired_count = 0;
+static void record_expired(void *, uint8_t req_id, RPL::AckResult result) {
+  assert(!result && result.error().code == RPL::ErrorCode::Timeout);
+  g_expired[g_expired_count++] = req_id;
+}
+
+void test_ack_window() {
+  std::cout << "Test 10: Deadline-ordered Ack window..." << std::endl;
+
+  ManualTick::now_ = 1000;
+  RPL::AckManager<ManualTick, 4> mgr;
+  static_assert(sizeof(mgr) < sizeof(RPL::AckManager<ManualTick>) / 32);
+
+  // 超时各不相同，插入顺序与到期顺序不同
+  const uint8_t a = mgr.allocate(30);
+  const uint8_t b = mgr.allocate(10);
+  const uint8_t c = mgr.allocate(20);
+  assert(mgr.pending_count() == 3);
+  g_expired_count = 0;
+  for (uint8_t id : {a, b, c}) {
+    const bool registered = mgr.on_complete(id, record_expired, nullptr);
+    assert(registered);
+  }
+
+  ManualTick::now_ = 1009;
+  mgr.check_timeouts();
+  assert(g_expired_count == 0);
+
+  ManualTick::now_ = 1020;
+  mgr.check_timeouts();
+  assert(g_expired_count == 2);
+  assert(g_expired[0] == b && g_expired[1] == c);
+  assert(mgr.pending_count() == 1);
+  assert(mgr.is_pending(a));
+
+  // 窗口已满：try_allocate 失败，allocate 挤掉最早到期的请求
+  const uint8_t d = mgr.allocate(100);
+  const uint8_t e = mgr.allocate(100);
+  const uint8_t f = mgr.allocate(100);
+  assert(mgr.pending_count() == 4);
+  auto full = mgr.try_allocate();
+  assert(!full && full.error().code == RPL::ErrorCode::BufferOverflow);
+  const uint8_t g = mgr.allocate(100);
+  assert(g_expired_count == 3 && g_expired[2] == a);
+  assert(mgr.pending_count() == 4);
+
+  // 已完成但未取走的结果仍占用槽位
+  mgr.resolve(d, 5);
+  assert(mgr.pending_count() == 3);
+  full = mgr.try_allocate();
+  assert(!full);
+  auto acked = mgr.try_ack(d);
+  assert(acked && *acked == 5);
+  auto freed = mgr.try_allocate();
+  assert(freed);
+
+  for (uint8_t id : {e, f, g})
+    mgr.cancel(id);
+  assert(mgr.pending_count() == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+// 有损链路：按 g_drop_mask 的位丢弃请求帧，设备端经重放缓存执行并回 Ack
+static uint32_t g_drop_mask = 0;
+static size_t g_wire_frames = 0;
+static size_t g_executions = 0;
+static bool g_drop_acks = false;
+static bool g_device_busy = false;
+static RPL::AckReplayCache<8> g_device_cache;
+static uint8_t g_pending_acks[8][2];
+static size_t g_pending_ack_count = 0;
+
+static bool lossy_send(const uint8_t *buf, size_t len) {
+  const bool drop = (g_drop_mask >> g_wire_frames++) & 1U;
+  if (drop || len < 6)
+    return true;
+  const uint8_t req_id = buf[5];
+  uint8_t status = 0xFE; // 设备忙：NACK，不进入缓存
+  if (!g_device_busy)
+    status = g_device_cache.handle(req_id, [] {
+      ++g_executions;
+      return uint8_t{0};
+    });
+  if (!g_drop_acks) {
+    g_pending_acks[g_pending_ack_count][0] = req_id;
+    g_pending_acks[g_pending_ack_count][1] = status;
+    ++g_pending_ack_count;
+  }
+  return true;
+}
+
+template <typename Transport> static void deliver_acks(Transport &transport) {
+  const size_t n = g_pending_ack_count;
+  g_pending_ack_count = 0;
+  for (size_t i = 0; i < n; ++i)
+    inject_ack(transport, g_pending_acks[i][0], g_pending_acks[i][1]);
+}
+
+void test_reliable_delivery() {
+  std::cout << "Test 11: Reliable delivery with retransmission..." << std::endl;
+
+  using ReliableMgr = RPL::ReliableAckManager<ManualTick, 8>;
+  using Transport = RPL::USBTransport<ReliableMgr, decltype(&lossy_send),
+                                      USBAck, MotorSpeedCmd>;
+  ManualTick::now_ = 0;
+  g_wire_frames = 0;
+  g_executions = 0;
+  g_pending_ack_count = 0;
+  g_device_cache.clear();
+  Transport transport{lossy_send};
+  auto &mgr = transport.ack_manager();
+  mgr.set_rto(20, 2, 200);
+  MotorSpeedCmd cmd{0, 1, 100};
+
+  // 无丢包：采样 RTT = 10 -> SRTT 10，RTO = 10 + 4 * 5
+  auto f1 = transport.request_async(cmd, 500);
+  ManualTick::now_ = 10;
+  deliver_acks(transport);
+  auto r1 = f1->get();
+  assert(r1 && *r1 == 0);
+  assert(mgr.srtt() == 10);
+  assert(mgr.rto() == 30);
+
+  // 请求丢失：RTO 到期后重传，设备只执行一次
+  g_drop_mask = 1U << g_wire_frames;
+  auto f2 = transport.request_async(cmd, 500);
+  ManualTick::now_ = 39;
+  transport.poll();
+  assert(mgr.retransmissions() == 0);
+  ManualTick::now_ = 40;
+  transport.poll();
+  assert(mgr.retransmissions() == 1);
+  deliver_acks(transport);
+  auto r2 = f2->get();
+  assert(r2 && *r2 == 0);
+  assert(g_executions == 2);
+  assert(mgr.srtt() == 10); // Karn：重传过的请求不采样
+
+  // Ack 丢失：重传命中设备端缓存，重放 Ack 而不重复执行
+  g_drop_mask = 0;
+  g_drop_acks = true;
+  auto f3 = transport.request_async(cmd, 500);
+  g_drop_acks = false;
+  ManualTick::now_ = 70;
+  transport.poll();
+  deliver_acks(transport);
+  auto r3 = f3->get();
+  assert(r3 && *r3 == 0);
+  assert(g_executions == 3);
+  assert(g_device_cache.replays() == 1);
+
+  // NACK：立即重传
+  g_device_busy = true;
+  auto f4 = transport.request_async(cmd, 500);
+  g_device_busy = false;
+  deliver_acks(transport);
+  assert(!f4->ready());
+  assert(mgr.nacks() == 1);
+  transport.poll();
+  deliver_acks(transport);
+  auto r4 = f4->get();
+  assert(r4 && *r4 == 0);
+
+  // 持续丢包：重传次数用尽后以总超时结束，RTO 指数退避
+  mgr.set_max_retries(2);
+  g_drop_mask = 0xFFFFFFFFU;
+  const size_t before = mgr.retransmissions();
+  auto f5 = transport.request_async(cmd, 300);
+  for (uint32_t t = 70; t <= 400; ++t) {
+    ManualTick::now_ = t;
+    transport.poll();
+  }
+  assert(mgr.retransmissions() - before == 2);
+  assert(f5->ready());
+  auto r5 = f5->get();
+  assert(!r5 && r5.error().code == RPL::ErrorCode::Timeout);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_fragmented_ack() {
+  std::cout << "Test 12: Ack resolution with fragmented input..." << std::endl;
+
+  using Mgr = RPL::AckManager<ManualTick, 16>;
+  using Transport =
+      RPL::USBTransport<Mgr, decltype(&capture_send), USBAck, SensorData,
+                        MotorSpeedCmd>;
+  using Ser = RPL::Serializer<USBAck, SensorData, MotorSpeedCmd>;
+  ManualTick::now_ = 0;
+  g_req_count = 0;
+  Transport transport{capture_send};
+  MotorSpeedCmd cmd{0, 1, 100};
+  Ser ser;
+
+  // Ack 拆成两次传输
+  auto f1 = transport.request_async(cmd, 100);
+  uint8_t ack[Ser::frame_size<USBAck>()];
+  auto n = ser.serialize(ack, sizeof(ack), USBAck{f1->req_id(), 3});
+  assert(n.has_value());
+  (void)transport.receive(ack, 4);
+  assert(!f1->ready());
+  (void)transport.receive(ack + 4, *n - 4);
+  auto r1 = f1->get();
+  assert(r1 && *r1 == 3);
+
+  // Ack 跟在其他帧之后，处于同一次传输中
+  auto f2 = transport.request_async(cmd, 100);
+  uint8_t burst[Ser::frame_size<SensorData>() + Ser::frame_size<USBAck>()];
+  auto n1 = ser.serialize(burst, sizeof(burst), SensorData{1.0f, 2.0f, 3.0f});
+  assert(n1.has_value());
+  auto n2 = ser.serialize(burst + *n1, sizeof(burst) - *n1,
+                          USBAck{f2->req_id(), 5});
+  assert(n2.has_value());
+  (void)transport.receive(burst, *n1 + *n2);
+  auto r2 = f2->get();
+  assert(r2 && *r2 == 5);
+  assert(transport.deserializer().get<SensorData>().accel_x == 1.0f);
+
+  // 逐字节输入
+  auto f3 = transport.request_async(cmd, 100);
+  n = ser.serialize(ack, sizeof(ack), USBAck{f3->req_id(), 6});
+  for (size_t i = 0; i < *n; ++i)
+    (void)transport.receive(ack + i, 1);
+  auto r3 = f3->get();
+  assert(r3 && *r3 == 6);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+// 借出发送缓冲区的发送端：busy 时不借出，退回拷贝路径
+struct LendingSink {
+  std::array<uint8_t, 64> *ring = nullptr;
+  size_t *committed = nullptr;
+  size_t *copied = nullptr;
+  bool *busy = nullptr;
+
+  std::span<uint8_t> acquire_tx(size_t size) {
+    if (*busy || size > ring->size())
+      return {};
+    return std::span<uint8_t>(ring->data(), size);
+  }
+  void commit_tx(size_t n) { *committed += n; }
+  void operator()(const uint8_t *, size_t n) { *copied += n; }
+};
+
+void test_lending_sink() {
+  std::cout << "Test 13: Zero-copy send into lent TX buffer..." << std::endl;
+
+  using Mgr = RPL::AckManager<ManualTick, 16>;
+  using Transport =
+      RPL::USBTransport<Mgr, LendingSink, USBAck, SensorData, MotorSpeedCmd>;
+  using Ser = RPL::Serializer<USBAck, SensorData, MotorSpeedCmd>;
+  static_assert(Transport::lends_tx);
+
+  std::array<uint8_t, 64> ring{};
+  size_t committed = 0, copied = 0;
+  bool busy = false;
+  Transport transport{LendingSink{&ring, &committed, &copied, &busy}};
+
+  // 直接序列化到借出的内存
+  SensorData sensor{1.0f, 2.0f, 3.0f};
+  auto sent = transport.notify(sensor);
+  assert(sent.has_value());
+  assert(committed == Ser::frame_size<SensorData>());
+  assert(copied == 0);
+  uint8_t expected[Ser::frame_size<SensorData>()];
+  Ser ser;
+  auto n = ser.serialize(expected, sizeof(expected), sensor);
+  assert(n.has_value());
+  assert(std::memcmp(ring.data(), expected, *n) == 0);
+
+  // 无法借出时退回拷贝路径
+  busy = true;
+  sent = transport.notify(sensor);
+  assert(sent.has_value());
+  assert(committed == Ser::frame_size<SensorData>());
+  assert(copied == Ser::frame_size<SensorData>());
+
+  // 请求同样走借出路径，req_id 写在借出的帧中
+  busy = false;
+  MotorSpeedCmd cmd{0, 1, 100};
+  auto f = transport.request_async(cmd, 100);
+  assert(f.has_value());
+  assert(ring[5] == f->req_id());
+  inject_ack(transport, f->req_id(), 2);
+  auto acked = f->get();
+  assert(acked && *acked == 2);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+// HAL 风格的发送回调：返回状态码，0 表示成功
+static size_t g_hal_calls = 0;
+static int hal_send(const uint8_t *, size_t) {
+  ++g_hal_calls;
+  return 0;
+}
+
+void test_status_code_send() {
+  std::cout << "Test 14: Send callback returning a status code..."
+            << std::endl;
+
+  using Transport =
+      RPL::USBTransport<AckMgr, decltype(&hal_send), USBAck, SensorData>;
+  g_hal_calls = 0;
+  Transport transport{hal_send};
+
+  // 返回值不是 bool，不能把 0 解释为通道繁忙
+  auto sent = transport.notify(SensorData{1.0f, 2.0f, 3.0f});
+  assert(sent.has_value());
+  assert(g_hal_calls == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
+using QueuedTransport = RPL::USBTransport<
+    AckMgr, bool (*)(const uint8_t *, size_t),
+    RPL::Containers::PriorityTxQueue<SysTickProvider, 4, 8, 32>, USBAck,
+    SensorData, MotorSpeedCmd>;
+
+// 前 g_busy_polls 次发送报告繁忙，之后接受请求帧并立即回 Ack
+static QueuedTransport *g_queued_tp = nullptr;
+static int g_busy_polls = 0;
+static bool busy_then_ack(const uint8_t *buf, size_t) {
+  if (g_busy_polls > 0) {
+    --g_busy_polls;
+    return false;
+  }
+  inject_ack(*g_queued_tp, buf[5], 3);
+  return true;
+}
+
+void test_request_through_busy_queue() {
+  std::cout << "Test 15: Blocking request drains a busy TX queue..."
+            << std::endl;
+
+  SysTickProvider::reset();
+  QueuedTransport transport{busy_then_ack};
+  g_queued_tp = &transport;
+
+  // 请求帧先留在队列中，等待 Ack 期间继续排空队列
+  g_busy_polls = 5;
+  MotorSpeedCmd cmd{0, 1, 100};
+  auto result = transport.request(cmd, 1000);
+  assert(result.has_value() && *result == 3);
+  assert(g_busy_polls == 0);
+  assert(transport.tx_queue().empty());
+
+  g_queued_tp = nullptr;
+  std::cout << "  PASS" << std::endl;
+}
+
+void test_check_timeouts_by_age() {
+  std::cout << "Test 16: check_timeouts(timeout) expires by request age..."
+            << std::endl;
+
+  ManualTick::now_ = 0;
+  RPL::AckManager<ManualTick, 4> mgr;
+  const uint8_t old_req = mgr.allocate(100);
+  ManualTick::now_ = 8;
+  const uint8_t new_req = mgr.allocate(100);
+
+  // 自身超时尚未到期，但 old_req 分配已超过 5 tick
+  ManualTick::now_ = 10;
+  mgr.check_timeouts(5);
+  assert(!mgr.is_pending(old_req));
+  assert(mgr.is_pending(new_req));
+  const auto expired = mgr.try_ack(old_req);
+  assert(!expired && expired.error().code == RPL::ErrorCode::Timeout);
+
+  // 不改变默认超时：之后以 timeout 0 分配的请求仍按 100 tick 到期
+  const uint8_t later = mgr.allocate();
+  ManualTick::now_ = 50;
+  mgr.check_timeouts();
+  assert(mgr.is_pending(later));
+
+  std::cout << "  PASS" << std::endl;
+}
+
+using ReliableTransport =
+    RPL::USBTransport<RPL::ReliableAckManager<SysTickProvider, 8>,
+                      bool (*)(const uint8_t *, size_t), USBAck,
+                      MotorSpeedCmd>;
+
+// 丢弃前 g_lost_frames 个请求帧，之后的帧立即回 Ack
+static ReliableTransport *g_reliable_tp = nullptr;
+static int g_lost_frames = 0;
+static bool drop_then_ack(const uint8_t *buf, size_t) {
+  if (g_lost_frames > 0) {
+    --g_lost_frames;
+    return true;
+  }
+  inject_ack(*g_reliable_tp, buf[5], 4);
+  return true;
+}
+
+void test_blocking_request_retransmits() {
+  std::cout << "Test 17: Blocking request retransmits on a lossy link..."
+            << std::endl;
+
+  SysTickProvider::reset();
+  ReliableTransport transport{drop_then_ack};
+  g_reliable_tp = &transport;
+  auto &mgr = transport.ack_manager();
+  mgr.set_rto(20, 2, 200);
+
+  // 前两次发送丢失，等待期间按 RTO 重传，第三次送达
+  g_lost_frames = 2;
+  MotorSpeedCmd cmd{0, 1, 100};
+  auto result = transport.request(cmd, 1000);
+  assert(result.has_value() && *result == 4);
+  assert(g_lost_frames == 0);
+  assert(mgr.retransmissions() == 2);
+  assert(mgr.pending_count() == 0);
+
+  g_reliable_tp = nullptr;
+  std::cout << "  PASS" << std::endl;
+}
+
+// 用户自己的 PacketHook：统计经过的数据包
+static size_t g_user_hook_calls = 0;
+static void count_user_packet(void *, uint16_t, std::span<const uint8_t>,
+                              std::span<const uint8_t>) {
+  ++g_user_hook_calls;
+}
+
+void test_user_packet_hook_keeps_acks() {
+  std::cout << "Test 18: User PacketHook does not disable Ack handling..."
+            << std::endl;
+
+  using Mgr = RPL::AckManager<ManualTick, 16>;
+  using Transport = RPL::USBTransport<Mgr, decltype(&capture_send), USBAck,
+                                      SensorData, MotorSpeedCmd>;
+  ManualTick::now_ = 0;
+  g_req_count = 0;
+  g_user_hook_calls = 0;
+  Transport transport{capture_send};
+  transport.parser().set_packet_hook({nullptr, &count_user_packet});
+
+  MotorSpeedCmd cmd{0, 1, 100};
+  auto future = transport.request_async(cmd, 100);
+  assert(future.has_value());
+  inject_ack(transport, g_req_ids[0], 7);
+
+  // Ack 经独立的 AckHook 交给 AckMgr，用户回调同样收到该帧
+  assert(future->ready());
+  const auto status = future->get();
+  assert(status && *status == 7);
+  assert(g_user_hook_calls == 1);
+
+  std::cout << "  PASS" << std::endl;
+}
+
 int main() {
   std::cout << "=== RPL USB Transport Tests ===" << std::endl;
 
@@ -234,6 +952,18 @@ int main() {
     test_ack_timeout();
     test_raw_parser_usb_frame();
     test_no_crc_on_wire();
+    test_priority_tx_queue();
+    test_tx_coalescer();
+    test_request_async();
+    test_ack_window();
+    test_reliable_delivery();
+    test_fragmented_ack();
+    test_lending_sink();
+    test_status_code_send();
+    test_request_through_busy_queue();
+    test_check_timeouts_by_age();
+    test_blocking_request_retransmits();
+    test_user_packet_hook_keeps_acks();
 
     std::cout << "\nAll USB transport tests passed!" << std::endl;
     return 0;
@@ -0,0 +1,78 @@
+#include <zephyr/device.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <RPL/Deserializer.hpp>
+#include <RPL/Packets/Sample/SampleA.hpp>
+#include <RPL/Parser.hpp>
+#include <RPL/Serializer.hpp>
+#include <RPL/USBTransport.hpp>
+#include <RPL/Zephyr/UartAsync.hpp>
+
+using Ring = RPL::Containers::DmaRingBuffer<CONFIG_RPL_ZEPHYR_UART_RX_BUF_SIZE>;
+using ParserType = RPL::Parser<Ring, SampleA>;
+using Uart = RPL::Zephyr::UartAsync<ParserType>;
+
+static_assert(RPL::LendingSinkConcept<Uart::Sink>);
+
+static const struct device *const uart_dev = DEVICE_DT_GET(DT_NODELABEL(euart0));
+static RPL::Deserializer<SampleA> deserializer;
+static ParserType parser{deserializer};
+static Uart uart{uart_dev, parser};
+static RPL::Serializer<SampleA> serializer;
+
+// 等待解析线程处理到指定的包
+static bool wait_for(uint8_t a) {
+    for (int i = 0; i < 100; ++i) {
+        if (deserializer.get<SampleA>().a == a)
+            return true;
+        k_msleep(1);
+    }
+    return false;
+}
+
+static void *suite_setup(void) {
+    zassert_true(device_is_ready(uart_dev));
+    zassert_ok(uart.start());
+    return nullptr;
+}
+
+// 回环：帧直接序列化到 TX 缓冲区发出，在 RX 环形缓冲区上原地解析，
+// 多次跨越环形缓冲区末尾
+ZTEST(rpl_uart_async, test_loopback_roundtrip) {
+    for (uint8_t n = 1; n <= 40; ++n) {
+        SampleA packet{n, static_cast<int16_t>(n * 10), n * 0.5f, n * 0.25};
+        zassert_true(uart.send(serializer, packet).has_value());
+        zassert_true(wait_for(n), "packet %u not received", n);
+        zassert_equal(deserializer.get<SampleA>().b, n * 10);
+    }
+    zassert_equal(uart.tx_errors(), 0);
+}
+
+// 通过 Sink（LendingSinkConcept）发送多个帧，接收端逐段到达
+ZTEST(rpl_uart_async, test_sink_and_fragmented_rx) {
+    constexpr size_t frame_size = RPL::Serializer<SampleA>::frame_size<SampleA>();
+    uint8_t frame[frame_size];
+    SampleA packet{200, -5, 1.0f, 2.0};
+    zassert_true(serializer.serialize(frame, sizeof(frame), packet).has_value());
+
+    auto sink = uart.sink();
+    auto lent = sink.acquire_tx(frame_size);
+    zassert_equal(lent.size(), frame_size);
+    memcpy(lent.data(), frame, frame_size);
+    sink.commit_tx(frame_size);
+    zassert_true(wait_for(200));
+
+    // 仿真 UART 的接收端直接注入半帧，再注入剩余部分
+    packet.a = 201;
+    zassert_true(serializer.serialize(frame, sizeof(frame), packet).has_value());
+    uart_emul_put_rx_data(uart_dev, frame, frame_size / 2);
+    k_msleep(2);
+    zassert_not_equal(deserializer.get<SampleA>().a, 201);
+    uart_emul_put_rx_data(uart_dev, frame + frame_size / 2,
+                          frame_size - frame_size / 2);
+    zassert_true(wait_for(201));
+}
+
+ZTEST_SUITE(rpl_uart_async, NULL, suite_setup, NULL, NULL, NULL);